@@ -0,0 +1,135 @@
+#include "BenchmarkRunner.h"
+#include "core/Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace civ::bench {
+
+BenchmarkRunner::BenchmarkRunner(BenchmarkConfig config)
+    : m_config(std::move(config))
+{
+}
+
+bool BenchmarkRunner::isSelected(const std::string& name) const {
+    return m_config.filter.empty() || name.find(m_config.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::run(const std::string& name, size_t opsPerSample, const OpFn& op) {
+    run(name, opsPerSample, [] {}, op);
+}
+
+void BenchmarkRunner::run(const std::string& name, size_t opsPerSample,
+                          const SetupFn& setup, const OpFn& op) {
+    if (!isSelected(name) || opsPerSample == 0) return;
+
+    Utils::seedRandom(m_config.seed);
+
+    for (int i = 0; i < m_config.warmupSamples; ++i) {
+        setup();
+        for (size_t j = 0; j < opsPerSample; ++j) op();
+    }
+
+    std::vector<double> perOp;
+    perOp.reserve(static_cast<size_t>(std::max(m_config.samples, 1)));
+    for (int i = 0; i < std::max(m_config.samples, 1); ++i) {
+        setup();
+        auto start = Clock::now();
+        for (size_t j = 0; j < opsPerSample; ++j) op();
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        perOp.push_back(elapsed / static_cast<double>(opsPerSample));
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.samples = perOp.size();
+    result.opsPerSample = opsPerSample;
+    result.meanNs = std::accumulate(perOp.begin(), perOp.end(), 0.0) / perOp.size();
+
+    double sq = 0.0;
+    for (double v : perOp) sq += (v - result.meanNs) * (v - result.meanNs);
+    result.stddevNs = (perOp.size() > 1) ? std::sqrt(sq / (perOp.size() - 1)) : 0.0;
+
+    std::sort(perOp.begin(), perOp.end());
+    result.minNs = perOp.front();
+    result.maxNs = perOp.back();
+    result.medianNs = perOp[perOp.size() / 2];
+
+    m_results.push_back(result);
+}
+
+void BenchmarkRunner::printTable(std::ostream& out) const {
+    out << std::left << std::setw(40) << "benchmark"
+        << std::right << std::setw(14) << "mean ns/op"
+        << std::setw(12) << "stddev"
+        << std::setw(12) << "cv %"
+        << std::setw(14) << "min"
+        << std::setw(14) << "median" << "\n";
+    out << std::string(106, '-') << "\n";
+    for (const auto& r : m_results) {
+        double cv = (r.meanNs > 0.0) ? r.stddevNs / r.meanNs * 100.0 : 0.0;
+        out << std::left << std::setw(40) << r.name << std::right << std::fixed
+            << std::setprecision(1)
+            << std::setw(14) << r.meanNs
+            << std::setw(12) << r.stddevNs
+            << std::setw(12) << cv
+            << std::setw(14) << r.minNs
+            << std::setw(14) << r.medianNs << "\n";
+    }
+}
+
+void BenchmarkRunner::writeJson(std::ostream& out) const {
+    out << "{\n  \"seed\": " << m_config.seed
+        << ",\n  \"samples\": " << m_config.samples
+        << ",\n  \"benchmarks\": [\n";
+    out << std::setprecision(3) << std::fixed;
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const auto& r = m_results[i];
+        out << "    {\"name\": \"" << r.name << "\""
+            << ", \"samples\": " << r.samples
+            << ", \"ops_per_sample\": " << r.opsPerSample
+            << ", \"mean_ns\": " << r.meanNs
+            << ", \"stddev_ns\": " << r.stddevNs
+            << ", \"min_ns\": " << r.minNs
+            << ", \"median_ns\": " << r.medianNs
+            << ", \"max_ns\": " << r.maxNs << "}"
+            << (i + 1 < m_results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+bool parseBenchmarkArgs(int argc, char** argv, BenchmarkConfig& config, std::string& jsonPath) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        try {
+            if (arg == "--seed" && hasValue) {
+                config.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (arg == "--samples" && hasValue) {
+                config.samples = std::stoi(argv[++i]);
+            } else if (arg == "--warmup" && hasValue) {
+                config.warmupSamples = std::stoi(argv[++i]);
+            } else if (arg == "--filter" && hasValue) {
+                config.filter = argv[++i];
+            } else if (arg == "--json" && hasValue) {
+                jsonPath = argv[++i];
+            } else if (arg == "--frame" && hasValue) {
+                config.framePath = argv[++i];
+            } else {
+                throw std::invalid_argument(arg);
+            }
+        }
+        catch (const std::exception&) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--seed N] [--samples N] [--warmup N] [--filter STR] [--json FILE] [--frame FILE.ppm]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace civ::bench
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace civ::bench {
+
+/**
+ * @brief Settings shared by every benchmark in a run.
+ */
+struct BenchmarkConfig {
+    uint32_t seed = 12345;       // Fed to Utils::seedRandom before each benchmark
+    int warmupSamples = 3;       // Samples executed and discarded
+    int samples = 30;            // Samples kept for statistics
+    std::string filter;          // Substring filter on benchmark names (empty = all)
+    std::string framePath;       // Where to write a rendered city map frame as PPM (empty = none)
+};
+
+/**
+ * @brief Per-operation timing statistics for one benchmark.
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t samples = 0;
+    size_t opsPerSample = 0;
+    double meanNs = 0.0;
+    double stddevNs = 0.0;
+    double minNs = 0.0;
+    double medianNs = 0.0;
+    double maxNs = 0.0;
+};
+
+/**
+ * @brief Prevents the optimizer from discarding a computed value.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Minimal microbenchmark harness: seeded, warmed-up, sampled runs
+ *        reporting nanoseconds per operation with variance.
+ */
+class BenchmarkRunner {
+public:
+    // setup() runs before every sample and is not timed; op() runs opsPerSample times per sample
+    using SetupFn = std::function<void()>;
+    using OpFn = std::function<void()>;
+
+    explicit BenchmarkRunner(BenchmarkConfig config);
+
+    void run(const std::string& name, size_t opsPerSample, const SetupFn& setup, const OpFn& op);
+    void run(const std::string& name, size_t opsPerSample, const OpFn& op);
+
+    [[nodiscard]] const std::vector<BenchmarkResult>& getResults() const { return m_results; }
+    [[nodiscard]] const BenchmarkConfig& getConfig() const { return m_config; }
+
+    void printTable(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    BenchmarkConfig m_config;
+    std::vector<BenchmarkResult> m_results;
+
+    [[nodiscard]] bool isSelected(const std::string& name) const;
+};
+
+/**
+ * @brief Parses the common command line flags:
+ *        --seed N, --samples N, --warmup N, --filter STR, --json FILE.
+ * @return false if the arguments are invalid (usage is printed).
+ */
+bool parseBenchmarkArgs(int argc, char** argv, BenchmarkConfig& config, std::string& jsonPath);
+
+} // namespace civ::bench
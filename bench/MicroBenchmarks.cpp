@@ -0,0 +1,568 @@
+#include "BenchmarkRunner.h"
+#include "Scenarios.h"
+#include "core/BatchRandom.h"
+#include "core/SpatialHashGrid.h"
+#include "core/Utils.h"
+#include "game/Civilization.h"
+#include "game/CityFlowFields.h"
+#include "game/CityModel.h"
+#include "game/CivilizationBatch.h"
+#include "game/EventCatalog.h"
+#include "game/EventSystem.h"
+#include "game/GameSnapshot.h"
+#include "game/GameViewModel.h"
+#include "game/ResourceManager.h"
+#include "game/SaveSystem.h"
+#include "game/SettlerSystem.h"
+#include "game/SimdKernels.h"
+#include "game/TechnologyTree.h"
+#include "ui/CityMapRenderer.h"
+#include "ui/HeadlessRenderer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Microbenchmarks for the simulation hot paths.
+ *
+ * Usage: IntSimulatorBench [--seed N] [--samples N] [--warmup N] [--filter STR] [--json FILE]
+ */
+
+namespace {
+
+using namespace civ;
+using namespace civ::bench;
+
+void benchResources(BenchmarkRunner& runner) {
+    ResourceManager resources;
+    runner.run("ResourceManager::processTurn", 10000,
+        [&] { resources = ResourceManager(); },
+        [&] {
+            resources.processTurn(50000, 30);
+            doNotOptimize(resources);
+        });
+}
+
+void benchEvents(BenchmarkRunner& runner) {
+    EventSystem events;
+    events.init(Difficulty::Normal);
+
+    const Era eras[] = { Era::StoneAge, Era::Medieval, Era::Industrial, Era::Space };
+    for (Era era : eras) {
+        runner.run("EventSystem::generateEvent/" + std::to_string(static_cast<int>(era)), 2000,
+            [&events, era] {
+                GameEvent event = events.generateEvent(era, 0);
+                doNotOptimize(event);
+            });
+    }
+}
+
+void benchTech(BenchmarkRunner& runner) {
+    TechnologyTree tech;
+    int branch = 0;
+    runner.run("TechnologyTree::investInBranch", 5000,
+        [&] { tech = TechnologyTree(); branch = 0; },
+        [&] {
+            tech.investInBranch(static_cast<TechBranch>(branch), 7.5);
+            branch = (branch + 1) % static_cast<int>(TechBranch::COUNT);
+            doNotOptimize(tech);
+        });
+
+    tech = TechnologyTree();
+    for (int b = 0; b < static_cast<int>(TechBranch::COUNT); ++b) {
+        tech.investInBranch(static_cast<TechBranch>(b), 2000.0);
+    }
+    size_t hovered = 0;
+    runner.run("TechnologyTree::getAvailableIds+getTechnology", 100000, [&] {
+        const auto& available = tech.getAvailableIds();
+        hovered = (hovered + 1) % available.size();
+        doNotOptimize(tech.getTechnology(available[hovered]).description.size());
+    });
+    runner.run("TechnologyTree::getAvailableTechs", 100000, [&] {
+        auto available = tech.getAvailableTechs();
+        hovered = (hovered + 1) % available.size();
+        doNotOptimize(available[hovered]->description.size());
+    });
+}
+
+// A mid-game civilization so serialization sees realistic field widths
+Civilization makeMidGameCiv() {
+    Civilization civ(u8"Рим");
+    for (int i = 0; i < static_cast<int>(TechBranch::COUNT); ++i) {
+        civ.getTech().investInBranch(static_cast<TechBranch>(i), 1500.0);
+    }
+    for (int turn = 0; turn < 40; ++turn) {
+        civ.processTurn();
+    }
+    return civ;
+}
+
+void benchCivilization(BenchmarkRunner& runner) {
+    Civilization civ = makeMidGameCiv();
+
+    runner.run("Civilization::serialize", 2000, [&] {
+        std::string data = civ.serialize();
+        doNotOptimize(data);
+    });
+
+    std::string data = civ.serialize();
+    Civilization target;
+    runner.run("Civilization::deserialize", 2000, [&] {
+        target.deserialize(data);
+        doNotOptimize(target);
+    });
+
+    Civilization turnCiv;
+    runner.run("Civilization::processTurn", 500,
+        [&] { turnCiv = Civilization(); },
+        [&] {
+            turnCiv.processTurn();
+            doNotOptimize(turnCiv);
+        });
+}
+
+// A turn reads the running totals, so its cost does not grow with the city
+void benchCity(BenchmarkRunner& runner) {
+    for (size_t buildings : { size_t(0), size_t(5000) }) {
+        Civilization civ;
+        buildCity(civ, buildings);
+        Civilization turnCiv;
+        runner.run("Civilization::processTurn/city-" + std::to_string(buildings), 500,
+            [&] { turnCiv = civ; },
+            [&] {
+                turnCiv.processTurn();
+                doNotOptimize(turnCiv);
+            });
+    }
+}
+
+void benchSpatialGrid(BenchmarkRunner& runner) {
+    Civilization civ;
+    buildCity(civ, 5000);
+    const CityModel& city = civ.getCity();
+    const float extent = CityModel::MIN_SPACING * 6.0f * (1.0f + 5000.0f / 32.0f);
+
+    // Query points precomputed so the loops time only the lookups
+    std::vector<std::pair<float, float>> queries(1024);
+    for (auto& q : queries) {
+        q = { static_cast<float>(Utils::randomDouble(-extent, extent)),
+              static_cast<float>(Utils::randomDouble(-extent, extent)) };
+    }
+
+    size_t next = 0;
+    runner.run("CityModel::isFree/5000", 10000, [&] {
+        const auto& q = queries[next++ & 1023];
+        doNotOptimize(city.isFree(q.first, q.second));
+    });
+    runner.run("CityModel::isFree/5000/linear", 1000, [&] {
+        // What the placement check cost before the grid
+        const auto& q = queries[next++ & 1023];
+        bool free = true;
+        for (const auto& b : city.getBuildings()) {
+            float dx = b.x - q.first;
+            float dy = b.y - q.second;
+            free = free && dx * dx + dy * dy >= CityModel::MIN_SPACING * CityModel::MIN_SPACING;
+        }
+        doNotOptimize(free);
+    });
+    runner.run("CityModel::pick/5000", 10000, [&] {
+        const auto& b = city.getBuildings()[next++ % 5000];
+        doNotOptimize(city.pick(b.x + 1.0f, b.y - 1.0f));
+    });
+
+    SpatialHashGrid grid(32.0f);
+    grid.reserve(100000);
+    for (uint32_t i = 0; i < 100000; ++i) {
+        grid.insert(i, static_cast<float>(Utils::randomDouble(0.0, 4000.0)),
+                    static_cast<float>(Utils::randomDouble(0.0, 4000.0)));
+    }
+    runner.run("SpatialHashGrid::forEachWithin/100k/r32", 10000, [&] {
+        const auto& q = queries[next++ & 1023];
+        size_t count = 0;
+        grid.forEachWithin(std::abs(q.first) * 0.5f, std::abs(q.second) * 0.5f, 32.0f,
+                           [&count](uint32_t, float, float) { ++count; });
+        doNotOptimize(count);
+    });
+}
+
+void benchSettlers(BenchmarkRunner& runner) {
+    constexpr size_t COUNT = SettlerSystem::MAX_SETTLERS;
+    const std::string suffix = "/" + std::to_string(COUNT / 1000) + "k";
+
+    // The array-of-structs loop with a rand() draw per settler that the map used
+    struct Settler {
+        float x, y;
+        float dx, dy;
+    };
+    std::vector<Settler> crowd(COUNT);
+    for (auto& e : crowd) {
+        e = { static_cast<float>(Utils::randomDouble(0.0, 1140.0)), static_cast<float>(Utils::randomDouble(0.0, 710.0)),
+              static_cast<float>(std::rand() % 20 - 10) / 20.0f, static_cast<float>(std::rand() % 20 - 10) / 20.0f };
+    }
+    runner.run("Settlers/aos-rand" + suffix, 1, [&] {
+        for (auto& e : crowd) {
+            e.x += e.dx;
+            e.y += e.dy;
+            if (e.x < 0 || e.x > 1140.0f) e.dx *= -1;
+            if (e.y < 0 || e.y > 710.0f) e.dy *= -1;
+            if (std::rand() % 100 == 0) {
+                e.dx = static_cast<float>(std::rand() % 20 - 10) / 20.0f;
+                e.dy = static_cast<float>(std::rand() % 20 - 10) / 20.0f;
+            }
+        }
+        doNotOptimize(crowd.front());
+    });
+
+    SettlerSystem settlers = makeSettlers(runner.getConfig().seed, COUNT);
+    for (int l = 0; l <= static_cast<int>(SimdKernels::detect()); ++l) {
+        auto level = static_cast<SimdLevel>(l);
+        SimdKernels::setLevel(level);
+        runner.run("SettlerSystem::step" + suffix + "/" + simdLevelToString(level), 1, [&] {
+            settlers.step();
+            doNotOptimize(settlers.getX()[0]);
+        });
+    }
+    SimdKernels::setLevel(SimdKernels::detect());
+}
+
+void benchFlowFields(BenchmarkRunner& runner) {
+    Civilization civ;
+    CityFlowFields fields;
+    buildMapCity(civ, fields, 400);
+    const CityModel& city = civ.getCity();
+
+    runner.run("CityFlowFields::rebuild/" + std::to_string(city.getBuildings().size()), 1, [&] {
+        fields.rebuild(city);
+        doNotOptimize(fields);
+    });
+
+    // A building going up: only its own field is relaxed
+    runner.run("CityFlowFields::addSource", 1,
+        [&] { fields.rebuild(city); },
+        [&] {
+            fields.addSource(1, 300.0f, 200.0f);
+            doNotOptimize(fields);
+        });
+
+    fields.rebuild(city);
+    SettlerSystem settlers = makeSettlers(runner.getConfig().seed, SettlerSystem::MAX_SETTLERS);
+    settlers.setBounds(1140.0f, 750.0f);
+    runner.run("SettlerSystem::step/100k/flow", 1, [&] {
+        settlers.step(&fields);
+        doNotOptimize(settlers.getX()[0]);
+    });
+}
+
+// The map of buildMapCity with a full crowd, as the Win32 front end draws it
+struct CityMapScene {
+    Civilization civ;
+    CityFlowFields fields;
+    SettlerSystem settlers;
+    CityMapRenderer renderer;
+
+    explicit CityMapScene(uint32_t seed, size_t settlerCount) : settlers(seed) {
+        Utils::seedRandom(seed);
+        buildMapCity(civ, fields, 400);
+        settlers = makeSettlers(seed, settlerCount);
+        settlers.setBounds(1140.0f, 750.0f);
+        renderer.resize(1140, 750);
+    }
+
+    void render() {
+        CityMapView view;
+        view.city = &civ.getCity();
+        view.settlers = &settlers;
+        view.era = Era::Industrial;
+        view.selectedBuilding = 1;
+        renderer.render(view);
+    }
+};
+
+bool writeCityFrame(const BenchmarkConfig& config) {
+    CityMapScene scene(config.seed, 20000);
+    for (int i = 0; i < 600; ++i) scene.settlers.step(&scene.fields);   // Ten seconds of commuting
+    scene.render();
+    if (!scene.renderer.frame().writePpm(config.framePath)) {
+        std::cerr << "Cannot write the city map frame to " << config.framePath << "\n";
+        return false;
+    }
+    std::cout << "City map frame written to " << config.framePath << "\n";
+    return true;
+}
+
+void benchCityMap(BenchmarkRunner& runner) {
+    for (size_t count : { size_t(0), SettlerSystem::MAX_SETTLERS }) {
+        CityMapScene scene(runner.getConfig().seed, count);
+        runner.run("CityMapRenderer::render/" + std::to_string(count / 1000) + "k", 1, [&] {
+            scene.render();
+            doNotOptimize(scene.renderer.frame().data()[0]);
+        });
+    }
+}
+
+void benchBatch(BenchmarkRunner& runner) {
+    constexpr size_t ROWS = 8192;
+    const std::string suffix = "/x" + std::to_string(ROWS);
+    const std::vector<Civilization> ensemble = makeEnsemble(ROWS, runner.getConfig().seed);
+
+    std::vector<Civilization> civs;
+    runner.run("Civilization::processTurn" + suffix, 10,
+        [&] { civs = ensemble; },
+        [&] {
+            for (auto& civ : civs) {
+                civ.processTurn();
+            }
+            doNotOptimize(civs.front());
+        });
+
+    EventSystem events;
+    events.init(Difficulty::Normal);
+    const EventCatalog catalog = events.buildCatalog();
+    const std::vector<int> eventIds = makeEventIds(catalog, ROWS);
+
+    runner.run("Civilization::applyEvent" + suffix, 10,
+        [&] { civs = ensemble; },
+        [&] {
+            for (size_t i = 0; i < ROWS; ++i) {
+                civs[i].applyEvent(catalog.getEvent(eventIds[i]));
+            }
+            doNotOptimize(civs.front());
+        });
+
+    std::vector<double> uniforms(2 * ROWS);
+    runner.run("Utils::randomDouble" + suffix + "x2", 10, [&] {
+        for (auto& value : uniforms) {
+            value = Utils::randomDouble(0.0, 1.0);
+        }
+        doNotOptimize(uniforms.front());
+    });
+
+    BatchRandom random(runner.getConfig().seed);
+    runner.run("BatchRandom::fillUniform" + suffix + "x2", 10, [&] {
+        random.fillUniform(uniforms.data(), uniforms.size());
+        doNotOptimize(uniforms.front());
+    });
+
+    std::vector<int> generatedIds(ROWS);
+    runner.run("EventSystem::generateEvent" + suffix, 1, [&] {
+        for (const auto& civ : ensemble) {
+            GameEvent event = events.generateEvent(civ);
+            doNotOptimize(event);
+        }
+    });
+
+    CivilizationBatch batch;
+    for (const auto& civ : ensemble) {
+        batch.add(civ);
+    }
+    runner.run("CivilizationBatch::generateEvents" + suffix, 10, [&] {
+        batch.generateEvents(catalog, random, generatedIds.data());
+        doNotOptimize(generatedIds.front());
+    });
+
+    runner.run("CivilizationBatch::applyEvents" + suffix, 10,
+        [&] {
+            batch.clear();
+            for (const auto& civ : ensemble) {
+                batch.add(civ);
+            }
+        },
+        [&] {
+            batch.applyEvents(catalog, eventIds.data());
+            doNotOptimize(batch.populationColumn().front());
+        });
+
+    for (int l = 0; l <= static_cast<int>(SimdKernels::detect()); ++l) {
+        auto level = static_cast<SimdLevel>(l);
+        runner.run("CivilizationBatch::processTurn" + suffix + "/" + simdLevelToString(level), 10,
+            [&] {
+                SimdKernels::setLevel(level);
+                batch.clear();
+                for (const auto& civ : ensemble) {
+                    batch.add(civ);
+                }
+            },
+            [&] {
+                batch.processTurn();
+                doNotOptimize(batch.populationColumn().front());
+            });
+    }
+    SimdKernels::setLevel(SimdKernels::detect());
+}
+
+// The same seeded games stepped turn by turn and through FastForward. Each game's
+// civilization and event system are set up before the sample, untimed, so only play counts.
+// At Normal difficulty under a third of the turns are quiet and most runs are a single
+// year, so the two take about as long.
+void benchFastForward(BenchmarkRunner& runner) {
+    constexpr uint32_t GAMES = 20;
+    const uint32_t seed = runner.getConfig().seed;
+    std::vector<Civilization> civs(GAMES);
+    std::vector<EventSystem> events(GAMES);
+    auto setup = [&] {
+        for (uint32_t g = 0; g < GAMES; ++g) newHeadlessGame(civs[g], events[g]);
+    };
+
+    for (bool fastForward : { false, true }) {
+        runner.run(std::string("HeadlessGame/x") + std::to_string(GAMES) + (fastForward ? "/fast-forward" : "/stepped"), 1,
+            setup,
+            [&] {
+                int turns = 0;
+                for (uint32_t g = 0; g < GAMES; ++g) {
+                    turns += playHeadless(seed + g, fastForward, civs[g], events[g]);
+                }
+                doNotOptimize(turns);
+            });
+    }
+}
+
+// Stepped headless games publishing a snapshot per turn while a renderer thread draws
+// the latest one at about 60 frames per second, against the same games without publication
+void benchSnapshots(BenchmarkRunner& runner) {
+    constexpr uint32_t GAMES = 20;
+    const uint32_t seed = runner.getConfig().seed;
+    Civilization civ;
+    EventSystem events;
+    SnapshotChannel channel;
+
+    std::atomic<bool> done{ false };
+    std::thread renderer([&] {
+        HeadlessRenderer view;
+        while (!done.load(std::memory_order_acquire)) {
+            if (channel.update()) view.render(channel.latest());
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        }
+    });
+
+    runner.run("HeadlessGame/x" + std::to_string(GAMES) + "/stepped+snapshots", 1, [&] {
+        int turns = 0;
+        for (uint32_t g = 0; g < GAMES; ++g) {
+            newHeadlessGame(civ, events);
+            turns += playHeadless(seed + g, false, civ, events, &channel);
+        }
+        doNotOptimize(turns);
+    });
+
+    done.store(true, std::memory_order_release);
+    renderer.join();
+
+    GameSnapshot snapshot;
+    runner.run("GameSnapshot::capture", 10000, [&] {
+        snapshot.capture(civ, events);
+        doNotOptimize(snapshot.turn);
+    });
+    HeadlessRenderer view;
+    runner.run("HeadlessRenderer::render", 10000, [&] {
+        doNotOptimize(view.render(snapshot));
+    });
+}
+
+void benchViewModel(BenchmarkRunner& runner) {
+    Civilization civ;
+    EventSystem events;
+    Utils::seedRandom(runner.getConfig().seed);
+    events.init(Difficulty::Normal);
+    for (int turn = 0; turn < 100; ++turn) {
+        GameEvent event = events.generateEvent(civ);
+        events.recordEvent(event);
+        civ.applyEvent(event);
+        civ.processTurn();
+    }
+
+    GameSnapshot snapshot;
+    snapshot.capture(civ, events);
+    GameViewModel view;
+    view.update(snapshot);
+    runner.run("GameViewModel::update/unchanged", 10000, [&] {
+        doNotOptimize(view.update(snapshot).bits);
+    });
+    runner.run("GameViewModel::update/capture+diff", 10000, [&] {
+        doNotOptimize(view.update(civ, events).bits);
+    });
+    runner.run("StatusPanel/format all sections", 1000, [&] {
+        std::string text = civ.getStatusString();
+        text += civ.getResources().getStatusString();
+        text += civ.getTech().getStatusString();
+        doNotOptimize(text.size());
+    });
+}
+
+void benchSaveSystem(BenchmarkRunner& runner) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "intsim_bench_save.dat").string();
+
+    Civilization civ = makeMidGameCiv();
+    EventSystem events;
+    events.init(Difficulty::Normal);
+    for (int i = 0; i < 100; ++i) {
+        events.recordEvent(events.generateEvent(civ.getCurrentEra(), i));
+    }
+
+    SaveSystem saveSystem;
+    if (!saveSystem.saveGame(civ, events, Difficulty::Normal, path)) {
+        std::cerr << "Cannot create benchmark save: " << saveSystem.getLastError() << "\n";
+        return;
+    }
+
+    Civilization loadedCiv;
+    EventSystem loadedEvents;
+    Difficulty difficulty = Difficulty::Normal;
+    runner.run("SaveSystem::loadGame", 200, [&] {
+        bool ok = saveSystem.loadGame(loadedCiv, loadedEvents, difficulty, path);
+        doNotOptimize(ok);
+    });
+
+    SaveSystem::deleteSave(path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkConfig config;
+    std::string jsonPath;
+    if (!parseBenchmarkArgs(argc, argv, config, jsonPath)) {
+        return 2;
+    }
+
+    if (!config.framePath.empty() && !writeCityFrame(config)) {
+        return 1;
+    }
+
+    BenchmarkRunner runner(config);
+    benchResources(runner);
+    benchEvents(runner);
+    benchTech(runner);
+    benchCivilization(runner);
+    benchCity(runner);
+    benchSpatialGrid(runner);
+    benchSettlers(runner);
+    benchFlowFields(runner);
+    benchCityMap(runner);
+    benchBatch(runner);
+    benchFastForward(runner);
+    benchSnapshots(runner);
+    benchViewModel(runner);
+    benchSaveSystem(runner);
+
+    runner.printTable(std::cout);
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath, std::ios::out | std::ios::trunc);
+        if (!json.is_open()) {
+            std::cerr << "Cannot write JSON results to " << jsonPath << "\n";
+            return 1;
+        }
+        runner.writeJson(json);
+    }
+    return 0;
+}
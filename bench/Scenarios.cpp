@@ -0,0 +1,132 @@
+#include "Scenarios.h"
+#include "core/Utils.h"
+#include "game/CityFlowFields.h"
+#include "game/CityModel.h"
+#include "game/EventCatalog.h"
+#include "game/EventSystem.h"
+#include "game/FastForward.h"
+#include "game/GameSnapshot.h"
+#include "game/ResourceManager.h"
+#include <cmath>
+#include <utility>
+
+namespace civ::bench {
+
+std::vector<Civilization> makeEnsemble(size_t count, uint32_t seed) {
+    Utils::seedRandom(seed);
+    EventSystem events;
+    events.init(Difficulty::Normal);
+
+    std::vector<Civilization> civs;
+    civs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Civilization civ;
+        for (int b = 0; b < static_cast<int>(TechBranch::COUNT); ++b) {
+            civ.getTech().investInBranch(static_cast<TechBranch>(b), Utils::randomDouble(0.0, 4000.0));
+        }
+        int turns = Utils::randomInt(0, 30);
+        for (int t = 0; t < turns; ++t) {
+            civ.applyEvent(events.generateEvent(civ));
+            civ.processTurn();
+        }
+        civs.push_back(std::move(civ));
+    }
+    return civs;
+}
+
+void buildCity(Civilization& civ, size_t buildings) {
+    CityModel& city = civ.getCity();
+    city.found(0.0f, 0.0f);
+    ResourceManager budget;
+    budget.addResource(ResourceType::Money, 1e12);
+    budget.addResource(ResourceType::Materials, 1e12);
+    const size_t kinds = CityModel::getBuildingDefs().size();
+    for (size_t i = 0; i < buildings; ++i) {
+        // Rings of 32, far enough apart that no two buildings overlap
+        float radius = CityModel::MIN_SPACING * 6.0f * static_cast<float>(1 + i / 32);
+        float angle = static_cast<float>(i % 32) * (6.2831853f / 32.0f);
+        city.place(i % kinds, radius * std::cos(angle), radius * std::sin(angle), Era::Space, budget);
+    }
+}
+
+SettlerSystem makeSettlers(uint32_t seed, size_t count) {
+    SettlerSystem settlers(seed);
+    settlers.setBounds(1140.0f, 710.0f);
+    settlers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Some start on or past an edge
+        settlers.spawn(static_cast<float>(Utils::randomDouble(-5.0, 1145.0)),
+                       static_cast<float>(Utils::randomDouble(-5.0, 715.0)));
+    }
+    return settlers;
+}
+
+void buildMapCity(Civilization& civ, CityFlowFields& fields, size_t attempts) {
+    CityModel& city = civ.getCity();
+    city.found(570.0f, 375.0f);
+    fields.resize(1140.0f, 750.0f);
+    fields.rebuild(city);
+    ResourceManager budget;
+    budget.addResource(ResourceType::Money, 1e12);
+    budget.addResource(ResourceType::Materials, 1e12);
+    const int kinds = static_cast<int>(CityModel::getBuildingDefs().size());
+    for (size_t i = 0; i < attempts; ++i) {
+        auto def = static_cast<size_t>(Utils::randomInt(0, kinds - 1));
+        auto x = static_cast<float>(Utils::randomDouble(0.0, 1140.0));
+        auto y = static_cast<float>(Utils::randomDouble(0.0, 750.0));
+        if (city.place(def, x, y, Era::Space, budget) == PlaceResult::Placed) {
+            fields.addSource(def, x, y);
+        }
+    }
+}
+
+std::vector<int> makeEventIds(const EventCatalog& catalog, size_t rows) {
+    std::vector<int> ids(rows);
+    for (auto& id : ids) {
+        id = Utils::randomInt(0, static_cast<int>(catalog.size()) - 1);
+    }
+    return ids;
+}
+
+void newHeadlessGame(Civilization& civ, EventSystem& events) {
+    civ = Civilization();
+    events.init(Difficulty::Normal);
+}
+
+int playHeadless(uint32_t seed, bool fastForward, Civilization& civ, EventSystem& events,
+                 SnapshotChannel* snapshots) {
+    constexpr int MAX_TURNS = 2000;
+    Utils::seedRandom(seed);
+
+    int turns = 0;
+    while (turns < MAX_TURNS) {
+        GameEvent event;
+        if (fastForward) {
+            FastForwardResult skipped = FastForward::skipQuietTurns(civ, events, MAX_TURNS - turns);
+            turns += skipped.quietTurns;
+            if (skipped.stop == FastForwardStop::GameOver || skipped.stop == FastForwardStop::TurnLimit) {
+                break;
+            }
+            if (skipped.stop == FastForwardStop::EraChange) {
+                continue;
+            }
+            event = (skipped.stop == FastForwardStop::Event) ? std::move(skipped.event)
+                                                             : events.generateEvent(civ);
+        } else {
+            event = events.generateEvent(civ);
+        }
+        events.recordEvent(event);
+        civ.applyEvent(event);
+        civ.processTurn();
+        ++turns;
+        if (snapshots) {
+            snapshots->publish(civ, events);
+        }
+        if (civ.checkGameResult() != GameResult::InProgress) {
+            break;
+        }
+    }
+    return turns;
+}
+
+} // namespace civ::bench
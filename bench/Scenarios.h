@@ -0,0 +1,49 @@
+#pragma once
+
+#include "game/Civilization.h"
+#include "game/SettlerSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+class CityFlowFields;
+class EventCatalog;
+class EventSystem;
+class SnapshotChannel;
+
+namespace bench {
+
+// Seeded game states shared by the benchmarks and the correctness tests, so
+// both measure and check the same workloads
+
+// Civilizations in varied states (random tech investment, a few turns of random
+// events), so batch and scalar paths are compared across every rule branch.
+std::vector<Civilization> makeEnsemble(size_t count, uint32_t seed);
+
+// Founds a city with `buildings` buildings of every kind on a ring around the town hall,
+// paid from a separate budget so the civilization's own resources are untouched
+void buildCity(Civilization& civ, size_t buildings);
+
+// A crowd spread over the 1140x710 map, some starting on or past an edge
+SettlerSystem makeSettlers(uint32_t seed, size_t count);
+
+// A random city on the 1140x750 map, with its flow fields grown one
+// addSource at a time as the buildings go up
+void buildMapCity(Civilization& civ, CityFlowFields& fields, size_t attempts);
+
+// Random catalog event per row, one column per turn
+std::vector<int> makeEventIds(const EventCatalog& catalog, size_t rows);
+
+// A new civilization and event system at Normal difficulty, the setup playHeadless expects
+void newHeadlessGame(Civilization& civ, EventSystem& events);
+
+// Headless game without player input from newHeadlessGame's setup, in GameEngine turn
+// order, either turn by turn or with FastForward over quiet years. With snapshots,
+// publishes the state after every stepped turn. Returns the number of turns played.
+int playHeadless(uint32_t seed, bool fastForward, Civilization& civ, EventSystem& events,
+                 SnapshotChannel* snapshots = nullptr);
+
+} // namespace bench
+} // namespace civ
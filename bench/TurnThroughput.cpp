@@ -0,0 +1,313 @@
+#include "core/Profiler.h"
+#include "core/Types.h"
+#include "core/Utils.h"
+#include "game/Civilization.h"
+#include "game/EventSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief End-to-end turn-throughput benchmark.
+ *
+ * Plays a fixed set of seeded games from the Stone Age to victory or defeat
+ * through the real EventSystem/Civilization turn path and compares the
+ * measured turns/second against a committed baseline.
+ *
+ * Usage: IntSimulatorTurnBench [--rounds N] [--baseline FILE] [--tolerance F] [--update-baseline]
+ *                              [--trace FILE]   (profiling builds: Chrome trace of the measured rounds)
+ *                              [--alloc-budget N]
+ * Exit code 1 means throughput dropped below baseline * (1 - tolerance), or that
+ * Civilization::applyEvent + processTurn allocated more than N times in some turn.
+ */
+
+namespace {
+
+using namespace civ;
+
+// ============================================================
+// Game set
+// ============================================================
+
+struct GameSpec {
+    uint32_t seed;
+    Difficulty difficulty;
+};
+
+const GameSpec GAME_SET[] = {
+    { 1, Difficulty::Easy },   { 2, Difficulty::Easy },   { 3, Difficulty::Easy },
+    { 4, Difficulty::Normal }, { 5, Difficulty::Normal }, { 6, Difficulty::Normal },
+    { 7, Difficulty::Hard },   { 8, Difficulty::Hard },
+    { 9, Difficulty::Nightmare },
+};
+
+constexpr int MAX_TURNS_PER_GAME = 5000;
+
+// Deterministic stand-in for the player: invests 30% of the treasury into the
+// weakest branch and researches the cheapest technology it can comfortably afford.
+void playerPolicy(Civilization& civ) {
+    double money = civ.getResources().getResource(ResourceType::Money);
+    if (money <= 0) return;
+
+    int weakest = 0;
+    for (int b = 1; b < static_cast<int>(TechBranch::COUNT); ++b) {
+        if (civ.getTech().getBranchLevel(static_cast<TechBranch>(b)) <
+            civ.getTech().getBranchLevel(static_cast<TechBranch>(weakest))) {
+            weakest = b;
+        }
+    }
+    double investment = money * 0.3;
+    civ.getResources().removeResource(ResourceType::Money, investment);
+    civ.getTech().investInBranch(static_cast<TechBranch>(weakest), investment);
+
+    const Technology* cheapest = civ.getTech().getCheapestAvailable();
+    money = civ.getResources().getResource(ResourceType::Money);
+    if (cheapest && money >= cheapest->cost * 2.0) {
+        civ.getResources().removeResource(ResourceType::Money, cheapest->cost);
+        civ.getTech().researchTech(cheapest->name);
+    }
+}
+
+// Same turn order as GameEngine::processTurn. If maxStepAllocs is given, it receives
+// the largest number of heap allocations made by applyEvent + processTurn in one turn.
+int playGame(const GameSpec& spec, uint64_t* maxStepAllocs = nullptr) {
+    Utils::seedRandom(spec.seed);
+    Civilization civ;
+    EventSystem events;
+    events.init(spec.difficulty);
+
+    int turns = 0;
+    GameResult result = GameResult::InProgress;
+    while (result == GameResult::InProgress && turns < MAX_TURNS_PER_GAME) {
+        {
+            CIV_TRACE_TURN(civ.getTurn() + 1);
+            CIV_PROFILE_SCOPE(Turn);
+            GameEvent event;
+            {
+                CIV_PROFILE_SCOPE(GenerateEvent);
+                event = events.generateEvent(civ);
+            }
+            events.recordEvent(event);
+
+            uint64_t allocsBefore = maxStepAllocs ? AllocationTracker::total().allocations : 0;
+            civ.applyEvent(event);
+            civ.processTurn();
+            if (maxStepAllocs) {
+                uint64_t stepAllocs = AllocationTracker::total().allocations - allocsBefore;
+                *maxStepAllocs = std::max(*maxStepAllocs, stepAllocs);
+            }
+        }
+        playerPolicy(civ);
+        result = civ.checkGameResult();
+        ++turns;
+    }
+    return turns;
+}
+
+// ============================================================
+// Measurement helpers
+// ============================================================
+
+double peakRssMiB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<double>(pmc.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0); // bytes
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;            // KiB
+#endif
+#endif
+}
+
+struct Baseline {
+    double turnsPerSecond = 0.0;
+    long long turnsPerRound = 0;
+    bool loaded = false;
+};
+
+Baseline readBaseline(const std::string& path) {
+    Baseline baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::string key;
+        if (!std::getline(iss, key, '=')) continue;
+        if (key == "turns_per_second") {
+            iss >> baseline.turnsPerSecond;
+            baseline.loaded = baseline.turnsPerSecond > 0.0;
+        } else if (key == "turns_per_round") {
+            iss >> baseline.turnsPerRound;
+        }
+    }
+    return baseline;
+}
+
+bool writeBaseline(const std::string& path, double turnsPerSecond, long long turnsPerRound) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << "# IntSimulatorTurnBench baseline (Release build).\n"
+         << "# Regenerate with: IntSimulatorTurnBench --update-baseline\n"
+         << "turns_per_second=" << std::fixed << std::setprecision(0) << turnsPerSecond << "\n"
+         << "turns_per_round=" << turnsPerRound << "\n";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = 200;
+    double tolerance = 0.10;
+    bool updateBaseline = false;
+    std::string baselinePath = INTSIM_TURN_BASELINE;
+    std::string tracePath;
+    long long allocBudget = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--rounds" && hasValue) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--tolerance" && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else if (arg == "--trace" && hasValue) {
+            tracePath = argv[++i];
+        } else if (arg == "--alloc-budget" && hasValue) {
+            allocBudget = std::atoll(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--rounds N] [--baseline FILE] [--tolerance F] [--update-baseline]"
+                      << " [--trace FILE] [--alloc-budget N]\n";
+            return 2;
+        }
+    }
+
+    // Warm-up round (not measured)
+    long long turnsPerRound = 0;
+    for (const auto& spec : GAME_SET) {
+        turnsPerRound += playGame(spec);
+    }
+
+    AllocationTracker::reset();
+    std::vector<double> roundRates;
+    roundRates.reserve(static_cast<size_t>(rounds));
+    if (!tracePath.empty()) {
+        Tracer::instance().start();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        auto roundStart = std::chrono::steady_clock::now();
+        for (const auto& spec : GAME_SET) {
+            playGame(spec);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - roundStart).count();
+        roundRates.push_back(static_cast<double>(turnsPerRound) / seconds);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!tracePath.empty()) {
+        Tracer::instance().stop();
+#ifdef INTSIM_PROFILING
+        Tracer::instance().writeJson(tracePath);
+#else
+        std::cerr << "--trace needs a build with -DINTSIM_ENABLE_PROFILING=ON\n";
+#endif
+    }
+
+    double totalTurns = static_cast<double>(turnsPerRound) * rounds;
+    double turnsPerSecond = totalTurns / elapsed;
+    AllocationTracker::Counters allocs = AllocationTracker::total();
+    double allocsPerTurn = static_cast<double>(allocs.allocations) / totalTurns;
+    double bytesPerTurn = static_cast<double>(allocs.bytes) / totalTurns;
+    double minRate = *std::min_element(roundRates.begin(), roundRates.end());
+    double maxRate = *std::max_element(roundRates.begin(), roundRates.end());
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "games per round:   " << std::size(GAME_SET) << "\n"
+              << "turns per round:   " << turnsPerRound << "\n"
+              << "rounds:            " << rounds << "\n"
+              << "turns/second:      " << turnsPerSecond
+              << " (min " << minRate << ", max " << maxRate << ")\n"
+              << "allocations/turn:  " << allocsPerTurn << "\n"
+              << "bytes/turn:        " << bytesPerTurn << "\n"
+              << "peak RSS:          " << peakRssMiB() << " MiB\n\n";
+    AllocationTracker::dump(std::cout, static_cast<uint64_t>(totalTurns));
+
+    // Allocation budget for the simulation step itself (one unmeasured round)
+    uint64_t maxStepAllocs = 0;
+    for (const auto& spec : GAME_SET) {
+        playGame(spec, &maxStepAllocs);
+    }
+    std::cout << "\nmax allocations in applyEvent + processTurn per turn: " << maxStepAllocs;
+    if (allocBudget >= 0) {
+        std::cout << " (budget " << allocBudget << ")\n";
+        if (maxStepAllocs > static_cast<uint64_t>(allocBudget)) {
+            std::cout << "FAIL: allocation budget exceeded\n";
+            return 1;
+        }
+    } else {
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+
+#ifdef INTSIM_PROFILING
+    Profiler::instance().dump(std::cout);
+    std::cout << "(profiling build: throughput includes timer overhead)\n\n";
+#endif
+
+    if (updateBaseline) {
+        if (!writeBaseline(baselinePath, turnsPerSecond, turnsPerRound)) {
+            std::cerr << "Cannot write baseline: " << baselinePath << "\n";
+            return 1;
+        }
+        std::cout << "baseline updated:  " << baselinePath << "\n";
+        return 0;
+    }
+
+    Baseline baseline = readBaseline(baselinePath);
+    if (!baseline.loaded) {
+        std::cout << "no baseline at " << baselinePath << ", skipping regression check\n";
+        return 0;
+    }
+    if (baseline.turnsPerRound != 0 && baseline.turnsPerRound != turnsPerRound) {
+        std::cout << "note: turns per round changed (" << baseline.turnsPerRound << " -> "
+                  << turnsPerRound << "), game rules differ from the baseline run\n";
+    }
+
+    double floor = baseline.turnsPerSecond * (1.0 - tolerance);
+    std::cout << "baseline:          " << baseline.turnsPerSecond
+              << " turns/second (floor " << floor << " at " << tolerance * 100.0 << "% tolerance)\n";
+    if (turnsPerSecond < floor) {
+        std::cout << "FAIL: throughput regression\n";
+        return 1;
+    }
+    std::cout << "OK\n";
+    return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief Walker/Vose alias table: samples an index from a fixed discrete
+ *        distribution in O(1) with a single uniform number. Built once in
+ *        O(n) from non-negative weights; sampling never allocates.
+ */
+class AliasTable {
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<double>& weights) { build(weights); }
+
+    // Weights need not be normalized; all-zero or empty weights give an empty table
+    void build(const std::vector<double>& weights);
+
+    [[nodiscard]] size_t size() const { return m_probability.size(); }
+    [[nodiscard]] bool empty() const { return m_probability.empty(); }
+
+    // uniform in [0, 1): the integer part of uniform * size() picks a column,
+    // the fractional part decides between the column and its alias
+    [[nodiscard]] size_t sample(double uniform) const {
+        double scaled = uniform * static_cast<double>(m_probability.size());
+        auto column = static_cast<size_t>(scaled);
+        if (column >= m_probability.size()) column = m_probability.size() - 1;
+        double coin = scaled - static_cast<double>(column);
+        return coin < m_probability[column] ? column : m_alias[column];
+    }
+
+    // Probability of index i under the table (for inspection and checks)
+    [[nodiscard]] double probabilityOf(size_t index) const;
+
+private:
+    std::vector<double> m_probability;
+    std::vector<uint32_t> m_alias;
+};
+
+} // namespace civ
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace civ {
+
+enum class ProfilePhase : uint8_t; // core/Profiler.h
+
+/**
+ * @brief Opt-in heap allocation accounting.
+ *
+ * When built with -DINTSIM_TRACK_ALLOCATIONS=ON the global operator new/delete
+ * are replaced and every allocation is attributed to the innermost
+ * CIV_PROFILE_SCOPE phase active on the calling thread (or "Untagged").
+ * Without the option the counters stay at zero and the scopes compile out.
+ */
+class AllocationTracker {
+public:
+    struct Counters {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    // True if the operator new hooks are compiled into this binary
+    [[nodiscard]] static bool isActive();
+
+    // Called from the operator new replacement
+    static void onAllocate(size_t bytes);
+
+    [[nodiscard]] static Counters total();
+    [[nodiscard]] static Counters forPhase(ProfilePhase phase);
+    [[nodiscard]] static Counters untagged();
+    static void reset();
+
+    // Per-thread current tag; AllocationScope saves and restores it
+    [[nodiscard]] static int currentTag();
+    static void setCurrentTag(int tag);
+
+    // Table of allocations and bytes per phase; divides by `turns` if non-zero
+    static void dump(std::ostream& out, uint64_t turns = 0);
+
+    static constexpr int UNTAGGED = -1;
+};
+
+/**
+ * @brief RAII tag: allocations inside the scope are charged to `phase`.
+ */
+class AllocationScope {
+public:
+    explicit AllocationScope(ProfilePhase phase)
+        : m_previous(AllocationTracker::currentTag()) {
+        AllocationTracker::setCurrentTag(static_cast<int>(phase));
+    }
+    ~AllocationScope() { AllocationTracker::setCurrentTag(m_previous); }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    int m_previous;
+};
+
+} // namespace civ
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace civ {
+
+/**
+ * @brief xoshiro256** generator with LANES independent streams stepped in lock
+ *        step. The state is stored lane-major (one array per state word), so the
+ *        per-lane update is a straight loop the compiler turns into SIMD; the
+ *        multiplications by 5 and 9 are shifts and adds and the double conversion
+ *        uses the exponent trick, so no 64-bit multiply or int-to-double
+ *        instruction is needed. Meant for filling a buffer of uniforms for a
+ *        whole CivilizationBatch at once; the game itself keeps Utils::random*.
+ */
+class BatchRandom {
+public:
+    static constexpr size_t LANES = 8;
+
+    explicit BatchRandom(uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+    void seed(uint64_t seed);
+
+    // Uniform doubles in [0, 1) with 52 random bits; out[i] comes from lane i % LANES
+    void fillUniform(double* out, size_t count);
+
+    // Next raw 64-bit value of every lane
+    void next(std::array<uint64_t, LANES>& out);
+
+private:
+    struct State {
+        std::array<uint64_t, LANES> s0;
+        std::array<uint64_t, LANES> s1;
+        std::array<uint64_t, LANES> s2;
+        std::array<uint64_t, LANES> s3;
+    };
+
+    [[nodiscard]] State load() const;
+    void store(const State& state);
+    static void step(State& state, uint64_t* out);
+    static void jump(uint64_t* s);   // Advances one lane state by 2^128 steps
+    static void toUniform(const uint64_t* bits, double* out, size_t count);
+
+    std::array<uint64_t, LANES> m_s0{};
+    std::array<uint64_t, LANES> m_s1{};
+    std::array<uint64_t, LANES> m_s2{};
+    std::array<uint64_t, LANES> m_s3{};
+};
+
+} // namespace civ
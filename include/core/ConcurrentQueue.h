@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace civ {
+
+/**
+ * @brief Unbounded multi-producer, multi-consumer FIFO guarded by one mutex.
+ *        Carries commands and results between the input, game and simulation
+ *        threads. close() wakes every waiter; pops still drain what was queued
+ *        before it.
+ */
+template <typename T>
+class ConcurrentQueue {
+public:
+    // False if the queue is closed and the value was dropped
+    bool push(T value) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed) return false;
+            m_items.push_back(std::move(value));
+        }
+        m_ready.notify_one();
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return popLocked(out);
+    }
+
+    // Waits until a value arrives or the queue is closed and empty
+    bool waitPop(T& out) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait(lock, [this] { return !m_items.empty() || m_closed; });
+        return popLocked(out);
+    }
+
+    // As waitPop, giving up after timeout
+    template <typename Rep, typename Period>
+    bool waitPop(T& out, std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait_for(lock, timeout, [this] { return !m_items.empty() || m_closed; });
+        return popLocked(out);
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_ready.notify_all();
+    }
+
+    [[nodiscard]] bool closed() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_closed;
+    }
+
+    [[nodiscard]] bool empty() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.empty();
+    }
+
+private:
+    bool popLocked(T& out) {
+        if (m_items.empty()) return false;
+        out = std::move(m_items.front());
+        m_items.pop_front();
+        return true;
+    }
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<T> m_items;
+    bool m_closed = false;
+};
+
+} // namespace civ
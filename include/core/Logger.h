@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <vector>
@@ -18,6 +19,10 @@ enum class LogLevel : uint8_t {
 
 /**
  * @brief Thread-safe singleton logger with file and in-memory log support.
+ *
+ * Logging is active only between init() and shutdown(). Messages outside that
+ * window are dropped, including from the recent-log list, so headless runs
+ * (benchmarks, batch simulation) never format or store a line.
  */
 class Logger {
 public:
@@ -32,6 +37,16 @@ public:
     void init(const std::string& filename, LogLevel minLevel = LogLevel::Info);
     void shutdown();
 
+    // False when nothing would be written: lets callers skip building the message.
+    // Before init(), after shutdown() and on muted threads logging is disabled.
+    [[nodiscard]] bool isEnabled(LogLevel level) const {
+        return m_initialized.load(std::memory_order_acquire) &&
+               level >= m_minLevel.load(std::memory_order_relaxed) && !s_threadMuted;
+    }
+
+    // Silences the calling thread, e.g. speculative work that may be thrown away
+    static void setThreadMuted(bool muted) { s_threadMuted = muted; }
+
     void log(LogLevel level, const std::string& message);
     void debug(const std::string& message);
     void info(const std::string& message);
@@ -50,9 +65,10 @@ private:
 
     std::ofstream m_file;
     std::vector<std::string> m_recentLogs;
-    LogLevel m_minLevel = LogLevel::Info;
+    std::atomic<LogLevel> m_minLevel{LogLevel::Info};
     mutable std::mutex m_mutex;
-    bool m_initialized = false;
+    std::atomic<bool> m_initialized{false};
+    static thread_local bool s_threadMuted;
 
     static constexpr size_t MAX_RECENT_LOGS = 50;
 };
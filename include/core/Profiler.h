@@ -0,0 +1,154 @@
+#pragma once
+
+#include "core/AllocationTracker.h"
+#include "core/Tracer.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace civ {
+
+/**
+ * @brief Phases of a turn (and the UI around it) that can be timed.
+ */
+enum class ProfilePhase : uint8_t {
+    Turn = 0,          // Whole turn: event + simulation step
+    GenerateEvent,
+    ApplyEvent,
+    EventEffects,      // Ticks of multi-turn events
+    ResourceTurn,
+    GrowPopulation,
+    UpdateEcology,
+    UpdateHappiness,
+    Logging,
+    Rendering,
+    SaveGame,
+    LoadGame,
+    COUNT
+};
+
+const char* profilePhaseToString(ProfilePhase phase);
+const char* profilePhaseCategory(ProfilePhase phase); // Trace category: sim, log, ui, io
+
+/**
+ * @brief Log-linear latency histogram in the spirit of HdrHistogram.
+ *        Values (nanoseconds) are bucketed with 16 sub-buckets per power of two,
+ *        giving at most 1/16 relative error with a fixed, allocation-free footprint.
+ *        Recording is a single relaxed atomic increment.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKETS * (64 - SUB_BUCKET_BITS + 1);
+
+    void record(uint64_t valueNs);
+    void reset();
+
+    [[nodiscard]] uint64_t count() const;
+    [[nodiscard]] uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    [[nodiscard]] double mean() const;
+    // Lower bound of the bucket holding the given percentile (0-100)
+    [[nodiscard]] uint64_t percentile(double pct) const;
+
+    [[nodiscard]] static size_t bucketIndex(uint64_t value);
+    [[nodiscard]] static uint64_t bucketLowerBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * @brief Process-wide collection of per-phase latency histograms.
+ */
+class Profiler {
+public:
+    static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void record(ProfilePhase phase, uint64_t durationNs) {
+        m_histograms[static_cast<size_t>(phase)].record(durationNs);
+    }
+
+    [[nodiscard]] const LatencyHistogram& getHistogram(ProfilePhase phase) const {
+        return m_histograms[static_cast<size_t>(phase)];
+    }
+
+    void reset();
+
+    // Human-readable table: count, mean, p50/p90/p99/p99.9, max per phase
+    void dump(std::ostream& out) const;
+    bool dumpToFile(const std::string& filename) const;
+
+private:
+    Profiler() = default;
+
+    std::array<LatencyHistogram, static_cast<size_t>(ProfilePhase::COUNT)> m_histograms;
+};
+
+/**
+ * @brief RAII scope that records its lifetime into the phase histogram and,
+ *        while the Tracer is running, into the trace timeline.
+ *        Use through CIV_PROFILE_SCOPE so uninstrumented builds compile it out.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase)
+        : m_phase(phase), m_start(Profiler::nowNs()) {}
+    ~ProfileScope() {
+        uint64_t end = Profiler::nowNs();
+        Profiler::instance().record(m_phase, end - m_start);
+        if (Tracer::isEnabled()) {
+            Tracer::instance().record(profilePhaseToString(m_phase),
+                                      profilePhaseCategory(m_phase), m_start, end);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfilePhase m_phase;
+    uint64_t m_start;
+};
+
+} // namespace civ
+
+// Instrumentation macros. CIV_PROFILE_SCOPE(phase) times the scope when built with
+// -DINTSIM_ENABLE_PROFILING=ON and tags its heap allocations when built with
+// -DINTSIM_TRACK_ALLOCATIONS=ON; with neither option it compiles to nothing.
+#define CIV_PROFILE_CONCAT_INNER(a, b) a##b
+#define CIV_PROFILE_CONCAT(a, b) CIV_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef INTSIM_PROFILING
+#define CIV_PROFILE_TIMER_(phase) \
+    ::civ::ProfileScope CIV_PROFILE_CONCAT(civProfileScope_, __LINE__)(::civ::ProfilePhase::phase);
+#define CIV_PROFILE_DUMP(filename) ::civ::Profiler::instance().dumpToFile(filename)
+#define CIV_TRACE_TURN(turn) ::civ::Tracer::setCurrentTurn(turn)
+#else
+#define CIV_PROFILE_TIMER_(phase)
+#define CIV_PROFILE_DUMP(filename) ((void)0)
+#define CIV_TRACE_TURN(turn) ((void)0)
+#endif
+
+#ifdef INTSIM_TRACK_ALLOCATIONS
+#define CIV_PROFILE_ALLOC_(phase) \
+    ::civ::AllocationScope CIV_PROFILE_CONCAT(civAllocScope_, __LINE__)(::civ::ProfilePhase::phase);
+#else
+#define CIV_PROFILE_ALLOC_(phase)
+#endif
+
+#define CIV_PROFILE_SCOPE(phase) CIV_PROFILE_ALLOC_(phase) CIV_PROFILE_TIMER_(phase) ((void)0)
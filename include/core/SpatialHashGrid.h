@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief Uniform grid of points with ids: overlap checks, point picking and
+ *        radius queries visit only the cells the query circle touches, so for
+ *        evenly spread points they cost O(1) however many points there are.
+ *        Cells are hashed into a power-of-two bucket table, so the plane is
+ *        unbounded and empty cells cost nothing. Entries live in a node pool
+ *        with a free list and the table doubles once it holds more points
+ *        than buckets, so after growing to the peak point count nothing
+ *        allocates. A cell size close to the usual query radius works best.
+ */
+class SpatialHashGrid {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit SpatialHashGrid(float cellSize = 32.0f);
+
+    void insert(uint32_t id, float x, float y);
+    bool remove(uint32_t id, float x, float y);   // x, y as last inserted or moved to
+    void move(uint32_t id, float fromX, float fromY, float toX, float toY);
+    void clear();
+    void reserve(size_t points);
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] float getCellSize() const { return m_cellSize; }
+
+    // Any point strictly closer than distance
+    [[nodiscard]] bool anyCloserThan(float x, float y, float distance) const;
+    // Nearest point no farther than radius, or NONE; the lowest id wins a tie
+    [[nodiscard]] uint32_t nearest(float x, float y, float radius) const;
+
+    // fn(id, x, y) for every point no farther than radius, in no fixed order
+    template <typename Fn>
+    void forEachWithin(float x, float y, float radius, Fn&& fn) const {
+        const float radiusSq = radius * radius;
+        forEachCandidate(x, y, radius, [&](const Node& node) {
+            float dx = node.x - x;
+            float dy = node.y - y;
+            if (dx * dx + dy * dy <= radiusSq) fn(node.id, node.x, node.y);
+            return true;
+        });
+    }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        float x = 0.0f;
+        float y = 0.0f;
+        int32_t cellX = 0;
+        int32_t cellY = 0;
+        uint32_t id = NONE;   // NONE while on the free list
+        uint32_t next = NIL;
+    };
+
+    float m_cellSize;
+    float m_inverseCell;
+    std::vector<uint32_t> m_buckets;   // First node of each bucket's list
+    std::vector<Node> m_nodes;
+    uint32_t m_free = NIL;
+    size_t m_size = 0;
+
+    [[nodiscard]] int32_t cellOf(float coordinate) const;
+    [[nodiscard]] size_t bucketOf(int32_t cellX, int32_t cellY) const;
+    void link(uint32_t node);
+    void rehash(size_t buckets);
+
+    // visit(node) for every point in the cells overlapping the query square;
+    // stops early when visit returns false
+    template <typename Visit>
+    void forEachCandidate(float x, float y, float radius, Visit&& visit) const {
+        const int32_t x0 = cellOf(x - radius);
+        const int32_t x1 = cellOf(x + radius);
+        const int32_t y0 = cellOf(y - radius);
+        const int32_t y1 = cellOf(y + radius);
+        const auto cells = (static_cast<uint64_t>(x1) - static_cast<uint64_t>(x0) + 1) *
+                           (static_cast<uint64_t>(y1) - static_cast<uint64_t>(y0) + 1);
+        if (cells > m_size) {
+            // A query larger than the population: scanning the pool is cheaper
+            for (const Node& node : m_nodes) {
+                if (node.id != NONE && !visit(node)) return;
+            }
+            return;
+        }
+        for (int32_t cy = y0; cy <= y1; ++cy) {
+            for (int32_t cx = x0; cx <= x1; ++cx) {
+                // Cells sharing the bucket are skipped by their coordinates
+                for (uint32_t n = m_buckets[bucketOf(cx, cy)]; n != NIL; n = m_nodes[n].next) {
+                    const Node& node = m_nodes[n];
+                    if (node.cellX == cx && node.cellY == cy && !visit(node)) return;
+                }
+            }
+        }
+    }
+};
+
+} // namespace civ
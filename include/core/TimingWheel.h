@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief Hierarchical timing wheel: values scheduled a number of ticks ahead
+ *        and handed back by advance() on the tick they expire.
+ *        LEVELS wheels of SLOTS slots each; level L covers SLOTS^(L+1) ticks.
+ *        An entry sits on the lowest level whose range still contains its
+ *        expiry and moves one level down each time that level wraps, so
+ *        schedule and advance are O(1) amortized however many entries are
+ *        pending. Delays beyond the top level's range stay on the top level
+ *        until they come into range. Slots are FIFO lists, so entries expiring
+ *        on the same tick come back in the order they were scheduled, whatever
+ *        cascades happened in between. Entries live in a node pool with a free
+ *        list: once the pool has grown to the peak number of pending entries,
+ *        nothing allocates.
+ */
+template <typename T>
+class TimingWheel {
+public:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+
+    // Fires delay ticks from now (delay 0 is treated as 1)
+    void schedule(const T& value, uint64_t delay) {
+        uint32_t node = allocate();
+        m_nodes[node].value = value;
+        m_nodes[node].expiry = m_now + (delay == 0 ? 1 : delay);
+        insert(node);
+        ++m_size;
+    }
+
+    // Moves time one tick forward and calls fn(value) for every entry expiring on it
+    template <typename Fn>
+    void advance(Fn&& fn) {
+        ++m_now;
+        // Higher levels first, so an entry cascading from level 2 lands in the
+        // level 1 slot that is cascaded right after it
+        for (int level = LEVELS - 1; level > 0; --level) {
+            uint64_t lowBits = m_now & ((uint64_t(1) << (SLOT_BITS * level)) - 1);
+            if (lowBits == 0) {
+                cascade(level);
+            }
+        }
+
+        uint32_t node = take(m_slots[0][m_now & (SLOTS - 1)]);
+        while (node != NIL) {
+            uint32_t next = m_nodes[node].next;
+            fn(m_nodes[node].value);
+            release(node);
+            --m_size;
+            node = next;
+        }
+    }
+
+    // Calls fn(value, ticksLeft) for every pending entry
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& level : m_slots) {
+            for (const Slot& slot : level) {
+                for (uint32_t node = slot.head; node != NIL; node = m_nodes[node].next) {
+                    fn(m_nodes[node].value, m_nodes[node].expiry - m_now);
+                }
+            }
+        }
+    }
+
+    void clear() {
+        for (auto& level : m_slots) level.fill(Slot{});
+        m_nodes.clear();
+        m_free = NIL;
+        m_size = 0;
+    }
+
+    void reserve(size_t capacity) { m_nodes.reserve(capacity); }
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+    [[nodiscard]] uint64_t now() const { return m_now; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        T value;
+        uint64_t expiry = 0;
+        uint32_t next = NIL;
+    };
+
+    struct Slot {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+    };
+
+    std::vector<Node> m_nodes;
+    uint32_t m_free = NIL;
+    std::array<std::array<Slot, SLOTS>, LEVELS> m_slots{};
+    uint64_t m_now = 0;
+    size_t m_size = 0;
+
+    // Detaches the slot's list and returns its first node
+    static uint32_t take(Slot& slot) {
+        uint32_t head = slot.head;
+        slot = Slot{};
+        return head;
+    }
+
+    uint32_t allocate() {
+        if (m_free != NIL) {
+            uint32_t node = m_free;
+            m_free = m_nodes[node].next;
+            return node;
+        }
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    void release(uint32_t node) {
+        m_nodes[node].next = m_free;
+        m_free = node;
+    }
+
+    void insert(uint32_t node) {
+        uint64_t expiry = m_nodes[node].expiry;
+        // Lowest level on which expiry and now share the same block
+        int level = 0;
+        while (level < LEVELS - 1 && ((expiry ^ m_now) >> (SLOT_BITS * (level + 1))) != 0) {
+            ++level;
+        }
+        Slot& slot = m_slots[static_cast<size_t>(level)][(expiry >> (SLOT_BITS * level)) & (SLOTS - 1)];
+        m_nodes[node].next = NIL;
+        if (slot.tail == NIL) {
+            slot.head = node;
+        } else {
+            m_nodes[slot.tail].next = node;
+        }
+        slot.tail = node;
+    }
+
+    void cascade(int level) {
+        uint32_t node = take(m_slots[static_cast<size_t>(level)][(m_now >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+        while (node != NIL) {
+            uint32_t next = m_nodes[node].next;
+            insert(node);
+            node = next;
+        }
+    }
+};
+
+} // namespace civ
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief One completed span ("ph":"X" in the Chrome Trace Event format).
+ */
+struct TraceEvent {
+    const char* name = nullptr;      // Must point to static storage
+    const char* category = nullptr;  // Must point to static storage
+    uint64_t startNs = 0;
+    uint64_t durationNs = 0;
+    int turn = -1;                   // Game turn the span belongs to (-1 = none)
+};
+
+/**
+ * @brief Fixed-capacity per-thread ring buffer; the oldest spans are overwritten.
+ */
+class TraceBuffer {
+public:
+    TraceBuffer(size_t capacity, uint32_t threadId);
+
+    void push(const TraceEvent& event) {
+        m_events[m_written % m_events.size()] = event;
+        ++m_written;
+    }
+
+    // Set by the owning thread around each push so stop() can wait it out
+    std::atomic<bool> recording{false};
+
+    [[nodiscard]] uint32_t getThreadId() const { return m_threadId; }
+    [[nodiscard]] size_t size() const;
+    // Events in chronological order of completion (oldest first)
+    [[nodiscard]] const TraceEvent& at(size_t index) const;
+
+private:
+    std::vector<TraceEvent> m_events;
+    uint64_t m_written = 0;
+    uint32_t m_threadId;
+};
+
+/**
+ * @brief Optional timeline recorder that exports Chrome Trace Event JSON,
+ *        viewable in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * Spans come from CIV_PROFILE_SCOPE, so tracing is available in builds
+ * configured with -DINTSIM_ENABLE_PROFILING=ON. Recording is off until start().
+ *
+ * Each thread writes only its own buffer. stop() waits until no thread is
+ * inside a push, so the buffers are stable for writeJson() afterwards.
+ * start() retires the previous buffers instead of freeing them: a thread that
+ * read the old generation may still push into one, and that span is simply
+ * dropped. Retired buffers live until exit (one set per start()).
+ */
+class Tracer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16; // Spans per thread
+
+    static Tracer& instance();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void start(size_t capacityPerThread = DEFAULT_CAPACITY);
+    void stop();
+    [[nodiscard]] static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    void record(const char* name, const char* category, uint64_t startNs, uint64_t endNs);
+
+    // Turn number stamped onto the calling thread's subsequent spans
+    static void setCurrentTurn(int turn);
+
+    // Call after stop(); writes every thread's buffer (fails while recording)
+    bool writeJson(const std::string& filename) const;
+
+    // Starts tracing if the INTSIM_TRACE environment variable names an output file.
+    // Returns that path (empty if tracing stays off).
+    std::string startFromEnvironment();
+
+private:
+    Tracer() = default;
+
+    TraceBuffer* threadBuffer();
+
+    static std::atomic<bool> s_enabled;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> m_buffers;
+    std::vector<std::unique_ptr<TraceBuffer>> m_retired;   // Still reachable from stale thread state
+    size_t m_capacity = DEFAULT_CAPACITY;
+    std::atomic<uint32_t> m_generation{0};
+};
+
+} // namespace civ
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace civ {
+
+/**
+ * @brief Wait-free single-writer, single-reader triple buffer.
+ *        The writer fills back() and publish()es it; the reader calls update()
+ *        and reads front(). Publishing swaps the back buffer with the shared
+ *        middle one in a single atomic exchange, and the reader takes the
+ *        middle buffer the same way, so each side always owns a buffer the
+ *        other never touches: the reader sees only complete values, the
+ *        writer never waits for a slow reader, and the reader skips straight
+ *        to the latest value when several were published in between.
+ *        back() is the buffer published two rounds ago, not the last one:
+ *        the writer has to fill every field it publishes.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side
+    [[nodiscard]] T& back() { return m_buffers[m_back]; }
+
+    void publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | FRESH), std::memory_order_acq_rel);
+        m_back = static_cast<uint8_t>(previous & INDEX_MASK);
+    }
+
+    // Reader side: takes the latest published value, false if nothing newer was published
+    bool update() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = static_cast<uint8_t>(previous & INDEX_MASK);
+        return true;
+    }
+
+    [[nodiscard]] const T& front() const { return m_buffers[m_front]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;   // Middle holds a value the reader has not taken
+
+    std::array<T, 3> m_buffers{};
+    alignas(64) std::atomic<uint8_t> m_middle{ 1 };
+    alignas(64) uint8_t m_back = 0;         // Writer only
+    alignas(64) uint8_t m_front = 2;        // Reader only
+};
+
+} // namespace civ
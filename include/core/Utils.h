@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
 #include <string>
+#include <string_view>
 
 namespace civ {
 
@@ -14,6 +17,13 @@ public:
     static int randomInt(int min, int max);
     static double randomDouble(double min, double max);
     static bool randomChance(double probability); // probability in [0.0, 1.0]
+    static void seedRandom(uint32_t seed);         // Deterministic runs (benchmarks, replays)
+
+    // State of the calling thread's generator, to continue the same stream elsewhere
+    static std::mt19937 getRandomState();
+    static void setRandomState(const std::mt19937& state);
+    // Routes the calling thread's draws to generator; nullptr goes back to the shared one
+    static void setThreadGenerator(std::mt19937* generator);
 
     // String helpers
     static std::string padRight(const std::string& str, size_t width, char fill = ' ');
@@ -24,6 +34,21 @@ public:
     // Progress bar
     static std::string progressBar(double value, double maxValue, int width = 20);
 
+    // Buffer-based formatting (no heap allocations).
+    // Each writes into [buf, buf + size) and returns the number of bytes written,
+    // or 0 if the result does not fit. Output is not null-terminated.
+    static constexpr size_t NUMBER_BUFFER_SIZE = 32; // Fits any int64_t with separators
+    static constexpr size_t DOUBLE_BUFFER_SIZE = 64; // Fits typical game values
+
+    static size_t formatNumberTo(char* buf, size_t size, int64_t number);
+    static size_t formatDoubleTo(char* buf, size_t size, double value, int precision = 1);
+    static size_t progressBarTo(char* buf, size_t size, double value, double maxValue, int width = 20);
+    static size_t padRightTo(char* buf, size_t size, std::string_view str, size_t width, char fill = ' ');
+    static size_t padLeftTo(char* buf, size_t size, std::string_view str, size_t width, char fill = ' ');
+
+    // Number of terminal columns a UTF-8 string occupies (one per code point)
+    static size_t displayWidth(std::string_view str);
+
     // Clamp
     static double clamp(double value, double min, double max);
 
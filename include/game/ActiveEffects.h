@@ -0,0 +1,109 @@
+#pragma once
+
+#include "core/TimingWheel.h"
+#include "core/Types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+struct GameEvent;
+
+/**
+ * @brief Effects an event applies in one turn. An event lasting N turns is
+ *        split into N equal shares: additive effects are divided by N, the
+ *        population multiplier becomes its N-th root and the absolute
+ *        population change is divided with the remainder going to the first
+ *        turn. A one-turn event is a single share equal to the event itself.
+ */
+struct EffectShare {
+    double populationMultiplier = 1.0;
+    int population = 0;
+    double happiness = 0.0;
+    double ecology = 0.0;
+    double military = 0.0;
+    std::array<double, static_cast<size_t>(ResourceType::COUNT)> resources{};
+    double techInvestment = 0.0;   // Progress added to every branch
+
+    [[nodiscard]] static EffectShare initial(const GameEvent& event);   // Turn the event happens
+    [[nodiscard]] static EffectShare perTurn(const GameEvent& event);   // Each of the following turns
+
+    void add(const EffectShare& other);
+    void remove(const EffectShare& other);
+};
+
+/**
+ * @brief Lingering event effects of one or more rows (a Civilization has one
+ *        row, a CivilizationBatch one per civilization). Each row keeps the sum
+ *        of its active shares, updated when an effect starts or expires, so a
+ *        turn applies one aggregate per row no matter how many effects overlap.
+ *        Expiries are kept in a single TimingWheel shared by all rows.
+ *
+ *        A turn applies total() and then calls advance(). An event applied
+ *        earlier in the same turn has already taken its first share, so
+ *        activate() holds the rest back until that advance(): the lingering
+ *        shares land on the following turns, never on the event's own.
+ */
+class ActiveEffects {
+public:
+    explicit ActiveEffects(size_t rows = 0);
+
+    void resize(size_t rows);
+    void reserve(size_t rows);
+    void reserveEffects(size_t count);   // Pending effects that fit without allocating
+    void clear();
+    [[nodiscard]] size_t rows() const { return m_counts.size(); }
+
+    // Adds share to the row's total from the next advance() on, for `turns` turns
+    void activate(size_t row, const EffectShare& share, int turns);
+    // Adds share to the row's total right away, for the next `turns` calls to
+    // advance(): restores an effect that had already started (saved games)
+    void resume(size_t row, const EffectShare& share, int turns);
+
+    // Ends one turn: effects that have ticked their last share leave their row's
+    // total, and effects activated during the turn join it
+    void advance();
+
+    // Appends a row with the active effects of `row` in other
+    size_t appendRow(const ActiveEffects& other, size_t row);
+
+    // Effects in the row's total, i.e. ticking on the next turn
+    [[nodiscard]] bool hasActive(size_t row) const { return m_counts[row] > 0; }
+    [[nodiscard]] int activeCount(size_t row) const { return m_counts[row]; }
+    [[nodiscard]] const EffectShare& total(size_t row) const { return m_totals[row]; }
+    // All effects with shares left, including those activated since the last advance()
+    [[nodiscard]] size_t size() const { return m_wheel.size() + m_starting.size(); }
+    [[nodiscard]] bool empty() const { return m_wheel.empty() && m_starting.empty(); }
+
+    // Calls fn(row, share, turnsLeft) for every effect with shares left. Between
+    // turns (after advance()) every effect has started, so resume() restores them.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        m_wheel.forEach([&fn](const Entry& entry, uint64_t turnsLeft) {
+            fn(static_cast<size_t>(entry.row), entry.share, static_cast<int>(turnsLeft));
+        });
+        for (const Starting& starting : m_starting) {
+            fn(static_cast<size_t>(starting.entry.row), starting.entry.share, starting.turns);
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t row = 0;
+        EffectShare share;
+    };
+
+    struct Starting {
+        Entry entry;
+        int turns = 0;
+    };
+
+    TimingWheel<Entry> m_wheel;
+    std::vector<Starting> m_starting;   // Activated during the current turn
+    std::vector<EffectShare> m_totals;
+    std::vector<int> m_counts;
+};
+
+} // namespace civ
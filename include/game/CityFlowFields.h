@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+class CityModel;
+
+/**
+ * @brief Flow fields over the city map, one per destination: each building
+ *        kind and the town hall. A field holds, for every CELL_SIZE cell, the
+ *        step toward the nearest building of its kind, so a settler finds its
+ *        way with one table lookup per step however many settlers there are.
+ *        Fields are built by a multi-source Dijkstra over the 8-connected grid
+ *        (5 per straight step, 7 per diagonal) with a bucket queue: the costs
+ *        are small integers, so eight circular buckets replace a heap. Placing a building relaxes its
+ *        own field from the new source only, touching just the cells that got
+ *        closer; after a removal the owner calls rebuild(). Buildings do not
+ *        block the way, so placing one never changes another kind's field.
+ */
+class CityFlowFields {
+public:
+    static constexpr float CELL_SIZE = 8.0f;
+    static constexpr uint16_t UNREACHED = UINT16_MAX;
+    static constexpr uint8_t NO_TARGET = UINT8_MAX;
+
+    // Clears every field; the grid covers [0, width) x [0, height)
+    void resize(float width, float height);
+    void rebuild(const CityModel& city);
+    void addSource(size_t target, float x, float y);   // Incremental
+
+    // Targets are building kinds in CityModel::getBuildingDefs() order, then the town hall
+    [[nodiscard]] static size_t townHallTarget();
+    [[nodiscard]] size_t getTargetCount() const { return m_fields.size(); }
+    [[nodiscard]] bool hasSources(size_t target) const;
+    [[nodiscard]] bool empty() const { return m_columns == 0 || !hasSources(townHallTarget()); }
+
+    // Unit step toward the nearest source of target; false once the cell is a
+    // source (arrived) or no source is reachable
+    bool direction(size_t target, float x, float y, float& dx, float& dy) const {
+        uint8_t step = NONE;
+        if (target < m_fields.size() && m_columns > 0) {
+            step = m_fields[target].step[cellOf(x, y)];
+        }
+        dx = UNIT_X[step];
+        dy = UNIT_Y[step];
+        return step != NONE;
+    }
+    [[nodiscard]] uint16_t distance(size_t target, float x, float y) const;
+
+    // Where a settler goes after reaching current (NO_TARGET: not started):
+    // from a home or the town hall to a random workplace, from work back to
+    // a random home, else to the town hall. bits picks among the candidates.
+    [[nodiscard]] uint8_t nextTarget(uint8_t current, uint32_t bits) const;
+
+private:
+    static constexpr uint8_t NONE = 8;   // No step: a source, or unreachable
+    static constexpr float DIAGONAL = 0.70710678f;
+    // Unit vector of each neighbour step, NONE last
+    static constexpr float UNIT_X[9] = { 1.0f, -1.0f, 0.0f,  0.0f, DIAGONAL, -DIAGONAL,  DIAGONAL, -DIAGONAL, 0.0f };
+    static constexpr float UNIT_Y[9] = { 0.0f,  0.0f, 1.0f, -1.0f, DIAGONAL, -DIAGONAL, -DIAGONAL,  DIAGONAL, 0.0f };
+    static constexpr size_t BUCKETS = 8;   // Above the largest step cost
+
+    struct Field {
+        std::vector<uint16_t> distance;
+        std::vector<uint8_t> step;   // Neighbour index toward the source; NONE at sources
+        size_t sources = 0;
+    };
+
+    size_t m_columns = 0;
+    size_t m_rows = 0;
+    std::vector<Field> m_fields;
+    std::vector<uint8_t> m_homes;     // Targets with housing and at least one source
+    std::vector<uint8_t> m_work;      // Targets without housing and at least one source
+    std::array<std::vector<uint32_t>, BUCKETS> m_buckets;   // Frontier cells by distance % BUCKETS, reused
+
+    // Points off the map belong to the nearest edge cell
+    [[nodiscard]] size_t cellOf(float x, float y) const {
+        return clampIndex(y, m_rows) * m_columns + clampIndex(x, m_columns);
+    }
+    [[nodiscard]] static size_t clampIndex(float coordinate, size_t count) {
+        float cell = coordinate * (1.0f / CELL_SIZE);
+        if (!(cell >= 1.0f)) return 0;   // Also NaN
+        auto index = static_cast<size_t>(cell);   // Truncation is floor here
+        return index < count ? index : count - 1;
+    }
+    void clearField(Field& field);
+    void seed(Field& field, size_t cell);
+    void relax(Field& field);
+    void refreshTargets();
+};
+
+} // namespace civ
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/SpatialHashGrid.h"
+#include "core/Types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace civ {
+
+class ResourceManager;
+
+/**
+ * @brief A kind of building the city can place.
+ */
+struct BuildingDef {
+    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
+
+    std::string name;
+    double costMoney;
+    double costMaterials;
+    int housing;                                  // Population cap added
+    std::array<double, NUM_RESOURCES> yield;      // Per turn, in ResourceType order
+    std::array<double, NUM_RESOURCES> productionBonus;   // Additive production modifier, +0.10 is +10%
+    double military;                              // Per turn
+    Era minEra;
+    uint32_t color;                               // 0xRRGGBB, for front ends
+};
+
+/**
+ * @brief One placed building, in city map coordinates.
+ */
+struct Building {
+    uint16_t def = 0;   // Index in CityModel::getBuildingDefs()
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+/**
+ * @brief What all buildings of a city give each turn.
+ */
+struct CityYield {
+    int housing = 0;
+    std::array<double, BuildingDef::NUM_RESOURCES> resources{};
+    std::array<double, BuildingDef::NUM_RESOURCES> productionBonus{};   // Sum of the buildings' bonuses
+    double military = 0.0;
+};
+
+enum class PlaceResult : uint8_t {
+    Placed = 0,
+    NoCity,            // The city has not been founded
+    UnknownBuilding,
+    TooEarly,          // The era does not allow the building yet
+    NotAffordable,
+    Overlapping,       // Too close to the town hall or another building
+};
+
+/**
+ * @brief The player's city: a town hall and the buildings placed around it.
+ *        The housing and yield totals are kept up to date as buildings are
+ *        placed and removed, so a turn reads them in O(1) however large the
+ *        city grows. Building positions are indexed in a SpatialHashGrid with
+ *        cells of MIN_SPACING, so the overlap check of a placement and picking
+ *        a building under a point look at a few neighbouring cells instead of
+ *        every building. A civilization without a founded city has no housing
+ *        cap and no yields.
+ */
+class CityModel {
+public:
+    static constexpr int TOWN_HALL_HOUSING = 50;
+    static constexpr float BUILDING_RADIUS = 10.0f;
+    static constexpr float MIN_SPACING = BUILDING_RADIUS + 12.0f;   // Between building centres
+    static constexpr size_t NO_BUILDING = SIZE_MAX;
+
+    [[nodiscard]] static const std::vector<BuildingDef>& getBuildingDefs();
+
+    void found(float x, float y);   // Places the town hall; clears any previous city
+    void reset();                   // No city
+    [[nodiscard]] bool isFounded() const { return m_founded; }
+    [[nodiscard]] float getCenterX() const { return m_centerX; }
+    [[nodiscard]] float getCenterY() const { return m_centerY; }
+
+    // Pays the cost from resources and places the building if the era, the
+    // resources and the spot allow it
+    PlaceResult place(size_t defIndex, float x, float y, Era era, ResourceManager& resources);
+    // Index in getBuildings(); no refund. The last building takes the removed
+    // one's index (buildings never overlap, so draw order does not matter)
+    bool remove(size_t index);
+    [[nodiscard]] bool isFree(float x, float y) const;
+    // Index of the building nearest to x, y no farther than radius, or NO_BUILDING
+    [[nodiscard]] size_t pick(float x, float y, float radius = BUILDING_RADIUS) const;
+
+    [[nodiscard]] const std::vector<Building>& getBuildings() const { return m_buildings; }
+    [[nodiscard]] const CityYield& getTotals() const { return m_totals; }
+
+    // Serialization: "0" without a city, otherwise the town hall and every building
+    void serialize(std::ostream& out) const;
+    void deserialize(std::istream& in);
+
+private:
+    bool m_founded = false;
+    float m_centerX = 0.0f;
+    float m_centerY = 0.0f;
+    std::vector<Building> m_buildings;
+    SpatialHashGrid m_grid{ MIN_SPACING };   // Ids are indices in m_buildings
+    CityYield m_totals;
+
+    void add(const Building& building);
+    void clearTotals();
+};
+
+} // namespace civ
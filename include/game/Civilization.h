@@ -4,6 +4,9 @@
 #include "game/ResourceManager.h"
 #include "game/TechnologyTree.h"
 #include "game/EventSystem.h"
+#include "game/ActiveEffects.h"
+#include "game/CityModel.h"
+#include <array>
 #include <string>
 #include <memory>
 
@@ -33,10 +36,19 @@ public:
     [[nodiscard]] const ResourceManager& getResources() const { return m_resources; }
     [[nodiscard]] TechnologyTree& getTech() { return m_tech; }
     [[nodiscard]] const TechnologyTree& getTech() const { return m_tech; }
+    [[nodiscard]] const ActiveEffects& getActiveEffects() const { return m_effects; }
+    [[nodiscard]] CityModel& getCity() { return m_city; }
+    [[nodiscard]] const CityModel& getCity() const { return m_city; }
+
+    // --- City ---
+    PlaceResult placeBuilding(size_t defIndex, float x, float y);   // Pays from the treasury
 
     // --- Turn processing ---
     void processTurn();
-    void applyEvent(const GameEvent& event);
+    void applyEvent(const GameEvent& event);   // Events lasting several turns keep ticking in processTurn
+    // applyEvent and processTurn for a one-turn event whose share the caller built once
+    // (FastForward steps a run of quiet years with the same share)
+    void processQuietYear(const EffectShare& share, const std::string& eventName);
 
     // --- State queries ---
     [[nodiscard]] Era getCurrentEra() const;
@@ -68,10 +80,23 @@ private:
 
     ResourceManager m_resources;
     TechnologyTree m_tech;
+    ActiveEffects m_effects{ 1 };   // Lingering effects of multi-turn events (single row)
+    CityModel m_city;               // Unfounded unless a front end founds it
+
+    // Tech modifiers registered in m_resources, refreshed when the Industry level changes
+    int m_modifierIndustryLevel = -1;
+    std::array<ModifierId, TechnologyTree::INDUSTRY_BONUS_RESOURCES.size()> m_industryModifiers{};
+
+    // Building modifiers registered in m_resources, one per resource while the city's bonus is non-zero
+    std::array<double, BuildingDef::NUM_RESOURCES> m_modifierBuildingBonus{};
+    std::array<ModifierId, BuildingDef::NUM_RESOURCES> m_buildingModifiers{};
 
+    void applyShare(const EffectShare& share);
+    void applyCity();
+    void updateTechModifiers();
+    void updateBuildingModifiers();
     void updateEcology();
     void updateHappiness();
-    [[nodiscard]] double getGrowthRate() const;
 };
 
 } // namespace civ
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core/Types.h"
+#include "game/ActiveEffects.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace civ {
+
+class BatchRandom;
+class Civilization;
+class EventCatalog;
+
+/**
+ * @brief Struct-of-arrays store for many independent civilizations.
+ *        Every attribute is a contiguous column indexed by row; processTurn and
+ *        applyEvents apply the rules of Civilization::processTurn/applyEvent one
+ *        phase at a time over whole columns, so ensembles of thousands or
+ *        millions of games step without pointer chasing. Names and researched technologies are not
+ *        stored: they do not take part in turn processing. Production modifiers are one
+ *        multiplier per row and resource: the Industry tech bonus times one plus the city's
+ *        building bonus, as Civilization's ModifierStack combines them. Event modifiers are not
+ *        carried over, and the batch kernel applies no consumption multiplier, where
+ *        SimdKernels::updateResourceLanes applies a single civilization's (Civilization
+ *        registers none, so both stay equal). A row with a founded city keeps the city's housing,
+ *        yield and bonus totals as of add(); the batch does not place buildings.
+ */
+class CivilizationBatch {
+public:
+    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
+    static constexpr size_t NUM_BRANCHES = static_cast<size_t>(TechBranch::COUNT);
+
+    CivilizationBatch() = default;
+
+    // Rows
+    size_t add(const Civilization& civ);   // Copies the state of civ, returns its row
+    void reserve(size_t capacity);
+    void clear();
+    [[nodiscard]] size_t size() const { return m_population.size(); }
+    [[nodiscard]] bool empty() const { return m_population.empty(); }
+
+    // Turn processing for every row (same rules and order as Civilization::processTurn)
+    void processTurn();
+
+    // Applies catalog event eventIds[row] to every row (same effects as Civilization::applyEvent,
+    // without logging; multi-turn events keep ticking in processTurn). eventIds must hold size() ids.
+    void applyEvents(const EventCatalog& catalog, const int* eventIds);
+
+    // Picks an event for every row like EventSystem::generateEvent (quiet year with the
+    // catalog's chance, otherwise weighted by the row's era and condition bucket), drawing all random numbers
+    // for the batch in one BatchRandom::fillUniform call. eventIds must hold size() ids.
+    void generateEvents(const EventCatalog& catalog, BatchRandom& random, int* eventIds);
+
+    // Per-row state queries
+    [[nodiscard]] int getPopulation(size_t row) const { return m_population[row]; }
+    [[nodiscard]] double getHappiness(size_t row) const { return m_happiness[row]; }
+    [[nodiscard]] double getEcology(size_t row) const { return m_ecology[row]; }
+    [[nodiscard]] double getMilitary(size_t row) const { return m_military[row]; }
+    [[nodiscard]] int getTurn(size_t row) const { return m_turn[row]; }
+    [[nodiscard]] int getStableEconomyTurns(size_t row) const { return m_stableEconomyTurns[row]; }
+    [[nodiscard]] double getResource(size_t row, ResourceType type) const;
+    [[nodiscard]] double getProduction(size_t row, ResourceType type) const;
+    [[nodiscard]] double getConsumption(size_t row, ResourceType type) const;
+    [[nodiscard]] int getBranchLevel(size_t row, TechBranch branch) const;
+    [[nodiscard]] double getBranchProgress(size_t row, TechBranch branch) const;
+    [[nodiscard]] int getOverallTechLevel(size_t row) const { return m_techLevel[row]; }
+    [[nodiscard]] Era getCurrentEra(size_t row) const;
+    [[nodiscard]] GameResult checkGameResult(size_t row) const;
+    [[nodiscard]] int getActiveEffectCount(size_t row) const { return m_effects.activeCount(row); }
+    [[nodiscard]] bool hasCity(size_t row) const { return m_housing[row] != NO_CITY; }
+
+    // Whole columns
+    [[nodiscard]] const std::vector<int>& populationColumn() const { return m_population; }
+    [[nodiscard]] const std::vector<double>& happinessColumn() const { return m_happiness; }
+    [[nodiscard]] const std::vector<double>& ecologyColumn() const { return m_ecology; }
+    [[nodiscard]] const std::vector<double>& resourceColumn(ResourceType type) const {
+        return m_resources[static_cast<size_t>(type)];
+    }
+
+private:
+    using IntColumn = std::vector<int>;
+    using DoubleColumn = std::vector<double>;
+
+    static constexpr int NO_CITY = -1;
+
+    IntColumn m_population;
+    DoubleColumn m_happiness;
+    DoubleColumn m_ecology;
+    DoubleColumn m_military;
+    IntColumn m_turn;
+    IntColumn m_stableEconomyTurns;
+
+    std::array<DoubleColumn, NUM_RESOURCES> m_resources;
+    std::array<DoubleColumn, NUM_RESOURCES> m_production;
+    std::array<DoubleColumn, NUM_RESOURCES> m_consumption;
+    std::array<DoubleColumn, NUM_RESOURCES> m_productionMultiplier;   // Tech and building modifiers, 1.0 for unaffected resources
+
+    std::array<IntColumn, NUM_BRANCHES> m_branchLevels;
+    std::array<DoubleColumn, NUM_BRANCHES> m_branchProgress;
+    IntColumn m_techLevel;   // Sum of branch levels, updated when an event levels a branch up
+
+    ActiveEffects m_effects; // Lingering effects of multi-turn events, one row per civilization
+
+    // City totals (CityModel::getTotals), NO_CITY housing for rows without a city
+    IntColumn m_housing;
+    std::array<DoubleColumn, NUM_RESOURCES> m_cityYield;
+    std::array<DoubleColumn, NUM_RESOURCES> m_cityBonus;   // Additive production bonus of the buildings
+    DoubleColumn m_cityMilitary;
+    size_t m_cityRows = 0;
+
+    DoubleColumn m_uniforms; // Scratch for generateEvents, two per row
+
+    void investInBranch(size_t row, size_t branch, double amount);
+    void updateProductionMultipliers(size_t row);
+    void applyShare(size_t row, const EffectShare& share);
+
+    // Phases of processTurn, each a pass over all rows
+    void tickEffects();
+    void updateResources();
+    void growPopulation();
+    void updateEcology();
+    void updateHappiness();
+    void updateStability();
+    void applyCities();
+};
+
+} // namespace civ
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/AliasTable.h"
+#include "core/Types.h"
+#include "game/ActiveEffects.h"
+#include "game/EventSystem.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief Numeric effects of an event, one dense column each in EventCatalog.
+ */
+enum class EventEffect : uint8_t {
+    PopulationMultiplier = 0,
+    Happiness,
+    Ecology,
+    Military,
+    Food,
+    Money,
+    Energy,
+    Materials,
+    TechInvestment,    // Progress added to every branch (techBoost spread as in Civilization::applyEvent)
+    COUNT
+};
+
+/**
+ * @brief Fixed set of events addressed by integer id, with their effects stored
+ *        as dense columns so a batch of civilizations can gather effect rows by
+ *        event id instead of copying GameEvent objects. The columns hold the share
+ *        applied on the turn of the event (EffectShare::initial); events lasting
+ *        several turns also keep their per-turn share. Built by
+ *        EventSystem::buildCatalog for one difficulty, with one entry per
+ *        (era, pool slot), so an event seen in several eras has one id each.
+ */
+class EventCatalog {
+public:
+    static constexpr size_t EFFECT_COUNT = static_cast<size_t>(EventEffect::COUNT);
+    static constexpr size_t ERA_COUNT = static_cast<size_t>(Era::COUNT);
+
+    int add(const GameEvent& event);                 // Returns the new id
+    void addToEra(Era era, int id);                  // Marks an event as possible in an era
+    void setQuietYear(int id, double chance);
+    // Weighted sampler over getEraEvents(era) for a condition bucket (EventSystem::conditionBucket)
+    void setEraTable(Era era, int bucket, const AliasTable& table);
+
+    [[nodiscard]] size_t size() const { return m_events.size(); }
+    [[nodiscard]] const GameEvent& getEvent(int id) const { return m_events[static_cast<size_t>(id)]; }
+    [[nodiscard]] int findByName(std::string_view name) const;   // -1 if absent
+
+    // Selection data mirroring EventSystem::generateEvent
+    [[nodiscard]] const std::vector<int>& getEraEvents(Era era) const {
+        return m_eraEvents[static_cast<size_t>(era)];
+    }
+    [[nodiscard]] const AliasTable& getEraTable(Era era, int bucket) const {
+        return m_eraTables[static_cast<size_t>(era)][static_cast<size_t>(bucket)];
+    }
+    [[nodiscard]] int getQuietYearId() const { return m_quietYearId; }
+    [[nodiscard]] double getQuietYearChance() const { return m_quietYearChance; }
+
+    // Effect columns indexed by event id
+    [[nodiscard]] const double* effectColumn(EventEffect effect) const {
+        return m_effects[static_cast<size_t>(effect)].data();
+    }
+    [[nodiscard]] const int* populationEffectColumn() const { return m_populationEffect.data(); }
+    [[nodiscard]] const int* durationColumn() const { return m_duration.data(); }
+    [[nodiscard]] const EffectShare& getLingeringShare(int id) const {
+        return m_lingeringShares[static_cast<size_t>(id)];
+    }
+    [[nodiscard]] bool hasTechInvestment(int id) const {
+        return m_effects[static_cast<size_t>(EventEffect::TechInvestment)][static_cast<size_t>(id)] > 0.0;
+    }
+
+private:
+    std::vector<GameEvent> m_events;
+    std::array<std::vector<double>, EFFECT_COUNT> m_effects;
+    std::vector<int> m_populationEffect;
+    std::vector<int> m_duration;
+    std::vector<EffectShare> m_lingeringShares;
+    std::array<std::vector<int>, ERA_COUNT> m_eraEvents;
+    std::array<std::array<AliasTable, EventSystem::CONDITION_BUCKETS>, ERA_COUNT> m_eraTables;
+    int m_quietYearId = -1;
+    double m_quietYearChance = 0.0;
+};
+
+} // namespace civ
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "core/AliasTable.h"
 #include "core/Types.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <functional>
@@ -8,8 +10,9 @@
 
 namespace civ {
 
-// Forward declaration
+// Forward declarations
 class Civilization;
+class EventCatalog;
 
 /**
  * @brief Represents a single game event with effects on civilization.
@@ -37,35 +40,77 @@ struct GameEvent {
 /**
  * @brief Manages random events that affect the civilization.
  *        Events are weighted by era, difficulty, and current state.
+ *
+ *        State enters through a condition bucket: medicine level, military and
+ *        happiness are each banded into low/normal/high, and every (era, bucket)
+ *        pair has a precomputed alias table, so a weighted draw costs O(1).
  */
 class EventSystem {
 public:
+    static constexpr int CONDITION_BANDS = 3;                 // low, normal, high
+    static constexpr int CONDITION_BUCKETS = CONDITION_BANDS * CONDITION_BANDS * CONDITION_BANDS;
+    static constexpr int NEUTRAL_BUCKET = (1 * CONDITION_BANDS + 1) * CONDITION_BANDS + 1;
+
     EventSystem();
 
     // Initialize event pool
     void init(Difficulty difficulty);
 
     // Generate a random event based on current state
+    [[nodiscard]] GameEvent generateEvent(const Civilization& civ) const;
+    // Same with neutral weights (every event of the era equally likely)
     [[nodiscard]] GameEvent generateEvent(Era currentEra, int turn) const;
 
+    // generateEvent(civ) split into its two random draws, for callers that walk the random
+    // stream turn by turn (FastForward): rollQuietYear is the first draw and decides a quiet
+    // year; after a failed roll pickEvent makes the second. generateEvent draws nothing when
+    // the era has no events, so callers check hasEvents first.
+    [[nodiscard]] bool hasEvents(Era era) const;
+    [[nodiscard]] bool rollQuietYear() const;
+    [[nodiscard]] GameEvent pickEvent(const Civilization& civ) const;
+    [[nodiscard]] const GameEvent& getQuietYear() const { return m_quietYear; }
+
+    // Bucket of the state bands; weak medicine favours epidemics, a small army wars,
+    // and unhappiness revolutions
+    [[nodiscard]] static int conditionBucket(int medicineLevel, double military, double happiness);
+    [[nodiscard]] static double eventWeight(const GameEvent& event, int bucket);
+
+    // Every event generateEvent can produce at the current difficulty, as dense effect rows
+    [[nodiscard]] EventCatalog buildCatalog() const;
+
     // Get event history
     [[nodiscard]] const std::vector<GameEvent>& getEventHistory() const;
     void recordEvent(const GameEvent& event);
+    void recordEvent(const GameEvent& event, size_t count);   // count times in a row
 
     // Difficulty modifier
     void setDifficulty(Difficulty difficulty);
 
+    // Replaces an era's events (scaled for the difficulty) until the next init or
+    // setDifficulty; an empty list leaves the era without events
+    void setEraEvents(Era era, const std::vector<GameEvent>& events);
+
     // Serialization
     [[nodiscard]] std::string serialize() const;
     void deserialize(const std::string& data);
 
 private:
     Difficulty m_difficulty = Difficulty::Normal;
-    std::vector<GameEvent> m_eventPool;
     std::vector<GameEvent> m_eventHistory;
+    GameEvent m_quietYear = makeQuietYear();
+
+    // Difficulty-scaled events of each era and their weighted samplers per condition bucket
+    std::array<std::vector<GameEvent>, static_cast<size_t>(Era::COUNT)> m_eraPools;
+    std::array<std::array<AliasTable, CONDITION_BUCKETS>, static_cast<size_t>(Era::COUNT)> m_eraTables;
 
     void buildEventPool();
+    void buildEraTables(size_t era);
+    [[nodiscard]] GameEvent sampleEvent(Era era, int bucket) const;
+    [[nodiscard]] GameEvent pickFromTable(Era era, int bucket) const;
     [[nodiscard]] double getDifficultyMultiplier() const;
+    [[nodiscard]] double getQuietYearChance() const;
+    [[nodiscard]] GameEvent scaleForDifficulty(GameEvent event) const;
+    [[nodiscard]] static GameEvent makeQuietYear();
     [[nodiscard]] std::vector<GameEvent> getEventsForEra(Era era) const;
 };
 
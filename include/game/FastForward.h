@@ -0,0 +1,145 @@
+#pragma once
+
+#include "core/Profiler.h"
+#include "core/Types.h"
+#include "core/Utils.h"
+#include "game/Civilization.h"
+#include "game/EventSystem.h"
+#include <cstdint>
+#include <random>
+
+namespace civ {
+
+enum class FastForwardStop : uint8_t {
+    TurnLimit = 0,   // maxTurns quiet years stepped
+    Event,           // The next turn has a real event (FastForwardResult::event)
+    EraChange,       // A quiet year moved the civilization into a new era
+    GameOver,        // A quiet year ended the game
+    NoEvents,        // The era has no events; generateEvent must take this turn
+};
+
+struct FastForwardResult {
+    int quietTurns = 0;
+    FastForwardStop stop = FastForwardStop::TurnLimit;
+    GameEvent event;   // stop == Event: drawn for the next turn, not yet recorded or applied
+};
+
+/**
+ * @brief Steps runs of quiet years in bulk, exactly as turn-by-turn play.
+ *        The quiet-year roll is the first random draw of every turn and does not
+ *        depend on the civilization, so the roll stream alone says how long the
+ *        run of quiet years is. skipQuietTurns steps a run's first quiet year as soon
+ *        as it is rolled; if the next roll is quiet too, it saves the generator state
+ *        and draws the rest of the run up front. Every quiet year is stepped with
+ *        processQuietYear: the quiet year's share is built once per run, not once
+ *        per turn, and the history takes the whole run in one insert. On the failed
+ *        roll that ends the run it draws the real event exactly as generateEvent
+ *        would, from the state reached, and hands it back so the caller can act
+ *        before it is applied.
+ *        A run that stops early (game over, an era change) has drawn rolls that
+ *        turn-by-turn play would draw later, so the saved state is restored and
+ *        only the rolls of the turns played are drawn again. The civilization, the
+ *        event history and the random stream end up exactly as after the same turns
+ *        of generateEvent / recordEvent / applyEvent / processTurn.
+ *        Each quiet year still runs the turn rules, so integer population growth and
+ *        the clamps on growth and the bounded values stay exact wherever they bite
+ *        and need no stop of their own.
+ *        afterTurn(civ) runs after each quiet year is processed and before it is
+ *        checked, where a player acts in turn-by-turn play. It draws no random
+ *        numbers, so the run stays exact whatever it changes.
+ *        The quiet year lasts one turn: nothing of it lingers past its own turn.
+ */
+class FastForward {
+public:
+    // Steps at most maxTurns quiet years. recordHistory mirrors EventSystem::recordEvent
+    // for each of them.
+    static FastForwardResult skipQuietTurns(Civilization& civ, EventSystem& events,
+                                            int maxTurns, bool recordHistory = true);
+
+    template <typename AfterTurn>
+    static FastForwardResult skipQuietTurns(Civilization& civ, EventSystem& events,
+                                            int maxTurns, bool recordHistory,
+                                            AfterTurn&& afterTurn);
+};
+
+template <typename AfterTurn>
+FastForwardResult FastForward::skipQuietTurns(Civilization& civ, EventSystem& events,
+                                              int maxTurns, bool recordHistory,
+                                              AfterTurn&& afterTurn) {
+    FastForwardResult result;
+    if (maxTurns <= 0) {
+        return result;
+    }
+    // The run stops on an era change, so one era holds for all of it
+    const Era startEra = civ.getCurrentEra();
+    if (!events.hasEvents(startEra)) {
+        result.stop = FastForwardStop::NoEvents;
+        return result;
+    }
+    if (!events.rollQuietYear()) {
+        // Most runs are empty: the second draw of generateEvent, nothing to step
+        result.event = events.pickEvent(civ);
+        result.stop = FastForwardStop::Event;
+        return result;
+    }
+
+    const GameEvent& quietYear = events.getQuietYear();
+    const EffectShare share = EffectShare::initial(quietYear);
+    // Steps one quiet year; true when the run must stop after it
+    auto stepStops = [&] {
+        {
+            CIV_PROFILE_SCOPE(Turn);
+            civ.processQuietYear(share, quietYear.name);
+        }
+        afterTurn(civ);
+        result.quietTurns++;
+        if (civ.checkGameResult() != GameResult::InProgress) {
+            result.stop = FastForwardStop::GameOver;
+            return true;
+        }
+        if (civ.getCurrentEra() != startEra) {
+            result.stop = FastForwardStop::EraChange;
+            return true;
+        }
+        return false;
+    };
+
+    // A run of one year is stepped as drawn, with nothing to save; a longer one draws the
+    // rest of its rolls up front, from the state after its second
+    bool drawEvent = false;
+    if (!stepStops() && result.quietTurns < maxTurns) {
+        if (!events.rollQuietYear()) {
+            drawEvent = true;
+        } else {
+            const std::mt19937 afterSecondRoll = Utils::getRandomState();
+            int run = 2;
+            while (run < maxTurns && events.rollQuietYear()) {
+                ++run;
+            }
+            drawEvent = run < maxTurns;
+            while (result.quietTurns < run) {
+                if (stepStops()) {
+                    // Turn-by-turn play has drawn one roll per turn played and none past the stop
+                    Utils::setRandomState(afterSecondRoll);
+                    for (int turn = 2; turn < result.quietTurns; ++turn) {
+                        (void)events.rollQuietYear();
+                    }
+                    drawEvent = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (recordHistory) {
+        events.recordEvent(quietYear, static_cast<size_t>(result.quietTurns));
+    }
+    if (drawEvent) {
+        // The failed roll is drawn; the second draw of generateEvent, from the state reached
+        result.event = events.pickEvent(civ);
+        result.stop = FastForwardStop::Event;
+    }
+    return result;
+}
+
+} // namespace civ
@@ -3,10 +3,15 @@
 #include "game/Civilization.h"
 #include "game/EventSystem.h"
 #include "game/SaveSystem.h"
+#include "game/SimulationThread.h"
+#include "game/TurnAdvance.h"
+#include "game/StandingOrders.h"
 #include "ui/Display.h"
 #include "ui/InputHandler.h"
 #include "core/Types.h"
+#include <iosfwd>
 #include <memory>
+#include <string>
 
 namespace civ {
 
@@ -26,12 +31,41 @@ public:
     // Main entry point
     void run();
 
+    // Plays a command script without screens or key waits (see ScriptRunner);
+    // returns the process exit code
+    int runScript(std::istream& script, std::ostream& report);
+
+    // Game actions without screen output, shared by the menus and scripted input
+    void newGame(Difficulty difficulty, const std::string& name);
+    bool loadSavedGame(const std::string& filename = "savegame.dat");
+    bool saveCurrentGame(const std::string& filename = "savegame.dat");
+    GameEvent playTurn();
+    bool invest(TechBranch branch, double amount);       // false if amount is not available
+    bool research(const std::string& techName);          // false if unavailable or unaffordable
+    TurnSummary advanceTurns(int turns);
+
+    [[nodiscard]] const Civilization& getCivilization() const { return *m_civ; }
+    [[nodiscard]] StandingOrders& getOrders() { return m_orders; }
+    [[nodiscard]] GameResult getResult() const { return m_result; }
+    [[nodiscard]] const std::string& getLastSaveError() const;
+
 private:
+    static constexpr int MAX_ADVANCE_TURNS = 1000;   // Per "advance N turns" command
+
     // Game state
     std::unique_ptr<Civilization> m_civ;
     std::unique_ptr<EventSystem> m_events;
     std::unique_ptr<SaveSystem> m_saveSystem;
     std::unique_ptr<Display> m_display;
+    std::unique_ptr<SimulationThread> m_simulation;
+    StandingOrders m_orders;
+
+    // Bumped by every action that may change the game state; predictions
+    // played from an older version are stale
+    uint64_t m_stateVersion = 0;
+    uint64_t m_speculatedVersion = UINT64_MAX;
+    TurnPrediction m_prediction;
+    bool m_hasPrediction = false;
 
     Difficulty m_difficulty = Difficulty::Normal;
     bool m_running = false;
@@ -43,7 +77,11 @@ private:
     void loadGame();
     void gameLoop();
     void processTurn();
+    void speculateNextTurn();
+    void collectPredictions();
     void handlePlayerAction();
+    void handleAdvanceTurns();
+    void handleStandingOrders();
     void handleInvestment();
     void handleTechResearch();
     void handleSaveGame();
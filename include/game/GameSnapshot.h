@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/TripleBuffer.h"
+#include "core/Types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace civ {
+
+class Civilization;
+class EventSystem;
+
+/**
+ * @brief Immutable view of the game that renderers draw from: the figures of
+ *        the status panels and the latest events, copied out of the live
+ *        Civilization and EventSystem. capture() overwrites every field in
+ *        place and reuses the event name strings, so once their capacity has
+ *        grown a capture does not allocate.
+ */
+struct GameSnapshot {
+    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
+    static constexpr size_t NUM_BRANCHES = static_cast<size_t>(TechBranch::COUNT);
+    static constexpr size_t RECENT_EVENTS = 10;
+
+    struct EventLine {
+        EventType type = EventType::GoldenAge;
+        std::string name;
+    };
+
+    uint64_t sequence = 0;   // Publication number; 0 until the first publish
+    bool hasGame = false;
+
+    std::string name;
+    int turn = 0;
+    Era era = Era::StoneAge;
+    int population = 0;
+    double happiness = 0.0;
+    double ecology = 0.0;
+    double military = 0.0;
+    size_t activeEffects = 0;
+    int stableEconomyTurns = 0;
+    int techLevel = 0;
+    size_t researchedCount = 0;
+    GameResult result = GameResult::InProgress;
+
+    std::array<double, NUM_RESOURCES> resources{};
+    std::array<double, NUM_RESOURCES> netIncome{};
+    std::array<int, NUM_BRANCHES> branchLevels{};
+    std::array<double, NUM_BRANCHES> branchProgress{};
+    std::array<double, NUM_BRANCHES> branchThreshold{};
+
+    size_t totalEvents = 0;
+    size_t recentCount = 0;                           // Oldest first
+    std::array<EventLine, RECENT_EVENTS> recentEvents{};
+
+    void capture(const Civilization& civ, const EventSystem& events);
+    void clear();   // No game running
+};
+
+/**
+ * @brief Hands snapshots from the simulation thread to one renderer thread
+ *        through a TripleBuffer: the simulation publishes after every change
+ *        without waiting for the renderer, and the renderer always draws the
+ *        latest complete snapshot, at its own frame rate.
+ */
+class SnapshotChannel {
+public:
+    // Simulation side
+    void publish(const Civilization& civ, const EventSystem& events);
+    void publishEmpty();
+    [[nodiscard]] uint64_t published() const { return m_published; }
+
+    // Renderer side: moves to the latest snapshot, false if nothing new was published
+    bool update() { return m_buffer.update(); }
+    [[nodiscard]] const GameSnapshot& latest() const { return m_buffer.front(); }
+
+private:
+    TripleBuffer<GameSnapshot> m_buffer;
+    uint64_t m_published = 0;   // Simulation side only
+};
+
+} // namespace civ
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "game/GameSnapshot.h"
+#include <cstdint>
+
+namespace civ {
+
+class Civilization;
+class EventSystem;
+
+/**
+ * @brief Parts of the game view, one bit each. A widget redraws when any of
+ *        the parts it shows changed.
+ */
+enum class ViewChange : uint32_t {
+    None           = 0,
+    Game           = 1u << 0,    // Game started, ended or replaced; name, result
+    Turn           = 1u << 1,
+    Era            = 1u << 2,
+    Population     = 1u << 3,
+    Happiness      = 1u << 4,
+    Ecology        = 1u << 5,
+    Military       = 1u << 6,
+    Effects        = 1u << 7,    // Lingering events, stable economy streak
+    Resources      = 1u << 8,    // Stockpiles
+    Income         = 1u << 9,    // Net income per turn
+    TechLevel      = 1u << 10,
+    BranchLevels   = 1u << 11,
+    BranchProgress = 1u << 12,
+    Research       = 1u << 13,   // Researched technologies
+    Events         = 1u << 14,   // Event log
+
+    Civ  = Population | Happiness | Ecology | Military | Effects,
+    Tech = TechLevel | BranchLevels | BranchProgress | Research,
+    All  = (1u << 15) - 1
+};
+
+constexpr ViewChange operator|(ViewChange a, ViewChange b) {
+    return static_cast<ViewChange>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+/**
+ * @brief Set of ViewChange bits reported by one GameViewModel::update.
+ */
+struct ViewChanges {
+    uint32_t bits = 0;
+
+    void add(ViewChange change) { bits |= static_cast<uint32_t>(change); }
+    [[nodiscard]] bool any() const { return bits != 0; }
+    [[nodiscard]] bool any(ViewChange mask) const { return (bits & static_cast<uint32_t>(mask)) != 0; }
+};
+
+/**
+ * @brief Platform-independent state of a game view. Each update diffs the new
+ *        snapshot against the one the view last drew and reports which parts
+ *        changed, so a front end redraws only the widgets showing them.
+ *        Comparisons are exact: the snapshots hold the values the widgets
+ *        format, so an unchanged value always formats the same way.
+ *        After invalidate() the next update reports everything changed, as it
+ *        does the first time.
+ */
+class GameViewModel {
+public:
+    ViewChanges update(const GameSnapshot& next);
+    ViewChanges update(const Civilization& civ, const EventSystem& events);
+    ViewChanges clear();   // No game running
+
+    void invalidate() { m_valid = false; }
+
+    [[nodiscard]] const GameSnapshot& current() const { return m_current; }
+
+    [[nodiscard]] static ViewChanges diff(const GameSnapshot& before, const GameSnapshot& after);
+
+private:
+    GameSnapshot m_current;
+    GameSnapshot m_scratch;   // Capture target of the Civilization overload, reused
+    bool m_valid = false;
+
+    [[nodiscard]] ViewChanges changesTo(const GameSnapshot& next) const;
+};
+
+} // namespace civ
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/TimingWheel.h"
+#include "core/Types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+enum class ModifierSource : uint8_t {
+    Tech = 0,
+    Event,
+    Building,
+    COUNT
+};
+
+enum class ModifierTarget : uint8_t {
+    Production = 0,
+    Consumption,
+    COUNT
+};
+
+/**
+ * @brief One production or consumption modifier of a resource.
+ *        The effective multiplier of a (target, resource) pair is
+ *        (1 + sum of additive) * product of multiplier.
+ */
+struct Modifier {
+    static constexpr int PERMANENT = -1;
+
+    ModifierSource source = ModifierSource::Event;
+    ModifierTarget target = ModifierTarget::Production;
+    ResourceType resource = ResourceType::Food;
+    double additive = 0.0;     // +0.10 is +10%
+    double multiplier = 1.0;   // Non-zero: removal divides it back out
+    int turns = PERMANENT;     // Turns until it expires, or PERMANENT until removed
+};
+
+/**
+ * @brief Handle of a modifier in a ModifierStack. Handles of removed or
+ *        expired modifiers stay invalid even after their slot is reused.
+ */
+struct ModifierId {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool isSet() const { return index != UINT32_MAX; }
+};
+
+/**
+ * @brief Production and consumption modifiers of one ResourceManager.
+ *        Each (target, resource) pair keeps the running sum of its additive
+ *        terms and the running product of its multipliers, updated when a
+ *        modifier is added, changed or removed, so the effective multipliers
+ *        are always current and a turn never rebuilds them. Timed modifiers
+ *        expire through a TimingWheel.
+ */
+class ModifierStack {
+public:
+    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
+    static constexpr size_t NUM_TARGETS = static_cast<size_t>(ModifierTarget::COUNT);
+
+    ModifierStack();
+
+    // A zero multiplier could never be divided back out: add returns an unset id
+    // and update returns false, leaving the stack unchanged
+    ModifierId add(const Modifier& modifier);
+    bool remove(ModifierId id);                                   // false if already gone
+    bool update(ModifierId id, double additive, double multiplier);   // false if gone
+    void removeSource(ModifierSource source);
+    void clear();
+
+    // One turn passes: timed modifiers count down and expire
+    void advanceTurn();
+
+    [[nodiscard]] const Modifier* get(ModifierId id) const;       // nullptr if gone
+    [[nodiscard]] size_t size() const { return m_size; }
+
+    // Effective multipliers, one per resource in ResourceType order
+    [[nodiscard]] const double* multipliers(ModifierTarget target) const {
+        return m_effective[static_cast<size_t>(target)].data();
+    }
+    [[nodiscard]] double getMultiplier(ModifierTarget target, ResourceType resource) const {
+        return m_effective[static_cast<size_t>(target)][static_cast<size_t>(resource)];
+    }
+
+private:
+    struct Entry {
+        Modifier modifier;
+        uint32_t generation = 0;
+        bool active = false;
+        uint32_t nextFree = UINT32_MAX;
+    };
+
+    struct Aggregate {
+        double additive = 0.0;
+        double product = 1.0;
+        int count = 0;
+    };
+
+    std::vector<Entry> m_entries;
+    uint32_t m_free = UINT32_MAX;
+    size_t m_size = 0;
+    std::array<std::array<Aggregate, NUM_RESOURCES>, NUM_TARGETS> m_aggregates{};
+    std::array<std::array<double, NUM_RESOURCES>, NUM_TARGETS> m_effective{};
+    TimingWheel<ModifierId> m_expiry;
+
+    [[nodiscard]] Entry* find(ModifierId id);
+    void include(const Modifier& modifier);
+    void exclude(const Modifier& modifier);
+    void refresh(const Modifier& modifier);
+};
+
+} // namespace civ
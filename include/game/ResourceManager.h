@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Types.h"
+#include "game/ModifierStack.h"
 #include <array>
 #include <string>
 #include <map>
@@ -13,11 +14,20 @@ namespace civ {
  */
 class ResourceManager {
 public:
+    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
+
+    // Production/consumption per 100 people (Food, Money, Energy, Materials), before
+    // tech and multipliers. Линейная зависимость от населения, чтобы экономика не рушилась
+    // при его росте; производство каждого ресурса выше потребления.
+    static constexpr std::array<double, NUM_RESOURCES> PRODUCTION_RATE  = { 1.5, 1.1, 0.8, 0.6 };
+    static constexpr std::array<double, NUM_RESOURCES> CONSUMPTION_RATE = { 1.2, 0.8, 0.5, 0.3 };
+
     ResourceManager();
 
     // Getters
     [[nodiscard]] double getResource(ResourceType type) const;
     [[nodiscard]] double getProduction(ResourceType type) const;
+    [[nodiscard]] double getBaseProduction(ResourceType type) const;   // Before modifiers
     [[nodiscard]] double getConsumption(ResourceType type) const;
     [[nodiscard]] double getNetIncome(ResourceType type) const;
 
@@ -27,9 +37,10 @@ public:
     void setProduction(ResourceType type, double amount);
     void setConsumption(ResourceType type, double amount);
 
-    // Multipliers (from tech, events, etc.)
-    void applyProductionMultiplier(ResourceType type, double multiplier);
-    void applyConsumptionMultiplier(ResourceType type, double multiplier);
+    // Production/consumption modifiers (from tech, events, buildings); getProduction and
+    // getConsumption include them. Only modifiers with turns left count down in processTurn.
+    [[nodiscard]] ModifierStack& getModifiers() { return m_modifiers; }
+    [[nodiscard]] const ModifierStack& getModifiers() const { return m_modifiers; }
 
     // Turn processing
     void processTurn(int population, int techLevel);
@@ -44,20 +55,11 @@ public:
     // Display
     [[nodiscard]] std::string getStatusString() const;
 
-    // Reset multipliers (called each turn before events)
-    void resetMultipliers();
-
 private:
-    static constexpr size_t NUM_RESOURCES = static_cast<size_t>(ResourceType::COUNT);
-
     std::array<double, NUM_RESOURCES> m_resources{};
     std::array<double, NUM_RESOURCES> m_production{};
     std::array<double, NUM_RESOURCES> m_consumption{};
-    std::array<double, NUM_RESOURCES> m_prodMultiplier{};
-    std::array<double, NUM_RESOURCES> m_consMultiplier{};
-
-    void updateProduction(int population, int techLevel);
-    void updateConsumption(int population);
+    ModifierStack m_modifiers;
 };
 
 } // namespace civ
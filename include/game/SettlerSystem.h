@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/BatchRandom.h"
+#include "game/CityFlowFields.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief Settlers walking around the city map. Positions and velocities are
+ *        kept as separate float columns and moved by SimdKernels::moveSettlers,
+ *        8 or 16 settlers per instruction. advance() steps the simulation at a
+ *        fixed STEP_SECONDS whatever rate it is called at, so the animation
+ *        speed does not depend on the front end's timer; after a stall it runs
+ *        at most MAX_CATCH_UP_STEPS steps and drops the rest of the backlog.
+ *        Given the city's flow fields, every settler commutes: each step it
+ *        reads the heading toward its current destination from the field
+ *        under it (O(1) per settler) and picks the next destination on
+ *        arrival. Without fields, or before the city is founded, each step
+ *        about WANDER_PER_SECOND * STEP_SECONDS of the settlers pick a new
+ *        random heading instead. Random numbers come from the system's own
+ *        BatchRandom: two systems on different threads share no generator,
+ *        and a system seeded the same way always moves the same way.
+ */
+class SettlerSystem {
+public:
+    static constexpr double STEP_SECONDS = 1.0 / 60.0;
+    static constexpr int MAX_CATCH_UP_STEPS = 8;
+    static constexpr float MAX_SPEED = 10.0f;            // Pixels per second on each axis
+    static constexpr float COMMUTE_SPEED = 20.0f;        // Pixels per second along a flow field
+    static constexpr double WANDER_PER_SECOND = 0.2;     // Share of settlers turning per second
+    static constexpr size_t MAX_SETTLERS = 100000;
+    static constexpr int PEOPLE_PER_SETTLER = 10;
+
+    explicit SettlerSystem(uint64_t seed = 0x5E771E5ull);
+
+    // Settlers shown for a population, capped at MAX_SETTLERS
+    [[nodiscard]] static size_t targetCount(int population);
+
+    void setBounds(float width, float height);
+    void reserve(size_t count);
+    void spawn(float x, float y);      // With a random heading
+    void truncate(size_t count);       // Keeps the first count settlers
+    void clear();
+
+    // Runs the whole steps that fit in the elapsed time plus the carried
+    // remainder; returns how many ran. fields may be null (random walk).
+    int advance(double seconds, const CityFlowFields* fields = nullptr);
+    void step(const CityFlowFields* fields = nullptr);
+
+    [[nodiscard]] size_t size() const { return m_x.size(); }
+    [[nodiscard]] const float* getX() const { return m_x.data(); }
+    [[nodiscard]] const float* getY() const { return m_y.data(); }
+    [[nodiscard]] const float* getVX() const { return m_vx.data(); }
+    [[nodiscard]] const float* getVY() const { return m_vy.data(); }
+    [[nodiscard]] const uint8_t* getTargets() const { return m_target.data(); }
+    [[nodiscard]] float getWidth() const { return m_width; }
+    [[nodiscard]] float getHeight() const { return m_height; }
+
+private:
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_vx;
+    std::vector<float> m_vy;
+    std::vector<uint8_t> m_target;   // CityFlowFields target, NO_TARGET until the first steer
+    float m_width = 0.0f;
+    float m_height = 0.0f;
+    double m_pending = 0.0;       // Elapsed seconds not yet stepped
+    double m_wanderDebt = 0.0;    // Fraction of a settler owed a new heading
+
+    BatchRandom m_random;
+    std::array<uint64_t, BatchRandom::LANES> m_bits{};
+    size_t m_bitsLeft = 0;
+
+    uint64_t nextBits();
+    [[nodiscard]] static float speedFromBits(uint32_t bits);   // Low 16 bits
+    void wander();
+    void steer(const CityFlowFields& fields);
+};
+
+} // namespace civ
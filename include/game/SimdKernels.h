@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace civ {
+
+/**
+ * @brief Instruction sets the turn kernels are built for, in increasing width.
+ */
+enum class SimdLevel : uint8_t {
+    Scalar = 0,   // Portable fallback
+    AVX2,         // 4 doubles per instruction
+    AVX512,       // 8 doubles per instruction
+};
+
+const char* simdLevelToString(SimdLevel level);
+
+/**
+ * @brief Columns read and written by the resource kernel for one resource type.
+ */
+struct ResourceColumns {
+    const int* population;
+    const int* techLevel;        // Overall tech level per row
+    double* amount;
+    double* production;          // Out: base production this turn
+    double* consumption;         // Out: base consumption this turn
+    const double* productionMultiplier;   // Effective production modifier per row
+    double productionRate;       // Per-capita rate of this resource
+    double consumptionRate;
+};
+
+/**
+ * @brief Columns read and written by the population growth kernel.
+ */
+struct GrowthColumns {
+    int* population;
+    const double* food;
+    const double* happiness;
+    const double* ecology;
+    const int* medicineLevel;
+};
+
+/**
+ * @brief Columns of the settler kernel: positions and velocities (pixels per
+ *        second) of n settlers on a width x height map.
+ */
+struct SettlerColumns {
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    float width;
+    float height;
+    float dt;   // Seconds per step
+};
+
+/**
+ * @brief Vectorized arithmetic of the turn step: resource production/consumption
+ *        and population growth, plus the settler animation of the city map.
+ *        Every kernel evaluates exactly the expressions of
+ *        ResourceManager::processTurn, Civilization::growPopulation and the
+ *        scalar settler step in the same order (no FMA contraction), so all
+ *        levels give bit-identical results.
+ *        The widest level supported by both the build and the CPU is chosen at
+ *        first use; the INTSIM_SIMD environment variable (scalar, avx2, avx512)
+ *        can lower it.
+ */
+class SimdKernels {
+public:
+    static constexpr size_t RESOURCE_LANES = 4;
+
+    [[nodiscard]] static SimdLevel detect();   // Widest level available here
+    [[nodiscard]] static SimdLevel getLevel();
+    static void setLevel(SimdLevel level);      // Clamped to detect()
+
+    // Batched columns: n rows of one resource / of population growth
+    static void updateResources(const ResourceColumns& columns, size_t n);
+    static void growPopulation(const GrowthColumns& columns, size_t n);
+
+    // Moves n settlers one step and reflects them off the map edges
+    static void moveSettlers(const SettlerColumns& columns, size_t n);
+
+    // One civilization: all RESOURCE_LANES resources at once, multipliers applied to the net income
+    static void updateResourceLanes(double popFactor, double techFactor,
+                                    const double* productionRate, const double* consumptionRate,
+                                    const double* productionMultiplier, const double* consumptionMultiplier,
+                                    double* production, double* consumption, double* amount);
+};
+
+} // namespace civ
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "core/ConcurrentQueue.h"
+#include "game/Civilization.h"
+#include "game/EventSystem.h"
+#include "game/TurnAdvance.h"
+#include <cstdint>
+#include <random>
+#include <thread>
+
+namespace civ {
+
+/**
+ * @brief The next turn, played ahead on the simulation thread.
+ */
+struct TurnPrediction {
+    uint64_t version = 0;      // Game state version it was played from
+    Civilization civ;          // State after the turn
+    GameEvent event;           // Event of the turn, not yet recorded
+    std::mt19937 random;       // Generator state after the turn's draws
+    CivSnapshot forecast;      // State after the turn had it been event-free
+};
+
+/**
+ * @brief Worker thread that plays the next turn while the player decides.
+ *        speculate() hands it copies of the civilization, the event system
+ *        and the random generator; it plays the turn exactly as the game
+ *        thread would, on its own generator and with logging muted, and
+ *        posts a TurnPrediction. The game adopts a prediction only if the
+ *        state it was played from is still current, so the outcome never
+ *        differs from playing the turn on the game thread; stale predictions
+ *        are dropped. The worker also plays an event-free turn for the forecast.
+ */
+class SimulationThread {
+public:
+    SimulationThread();
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Queues the next turn from this state; the generator state is taken from the calling thread
+    void speculate(uint64_t version, const Civilization& civ, const EventSystem& events);
+
+    // A finished prediction, if any; older ones may still arrive and must be checked by version
+    bool poll(TurnPrediction& out) { return m_results.tryPop(out); }
+
+private:
+    struct Job {
+        uint64_t version = 0;
+        Civilization civ;
+        EventSystem events;
+        std::mt19937 random;
+    };
+
+    ConcurrentQueue<Job> m_jobs;
+    ConcurrentQueue<TurnPrediction> m_results;
+    std::thread m_worker;
+
+    void run();
+    static TurnPrediction play(Job& job);
+};
+
+} // namespace civ
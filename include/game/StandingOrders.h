@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/Types.h"
+#include <string>
+#include <vector>
+
+namespace civ {
+
+class Civilization;
+
+/**
+ * @brief What standing orders spent over one or more turns.
+ */
+struct OrdersReport {
+    double invested = 0.0;                  // Money put into the investment branch
+    double researchSpent = 0.0;             // Money paid for researched technologies
+    std::vector<std::string> researched;    // Technologies in the order they were researched
+};
+
+/**
+ * @brief Orders the player leaves in force from turn to turn: invest a share
+ *        of the treasury into one branch and research the cheapest available
+ *        technology once it is affordable. They follow the same rules as the
+ *        manual investment and research actions and draw no random numbers.
+ */
+class StandingOrders {
+public:
+    void setInvestment(TechBranch branch, double share);   // share of money, 0..1; 0 cancels
+    void clearInvestment() { m_investShare = 0.0; }
+    void setAutoResearch(bool enabled) { m_autoResearch = enabled; }
+
+    [[nodiscard]] bool hasInvestment() const { return m_investShare > 0.0; }
+    [[nodiscard]] TechBranch getInvestBranch() const { return m_investBranch; }
+    [[nodiscard]] double getInvestShare() const { return m_investShare; }
+    [[nodiscard]] bool isAutoResearch() const { return m_autoResearch; }
+    [[nodiscard]] bool empty() const { return !hasInvestment() && !m_autoResearch; }
+
+    // Carries out the orders for one turn and adds what they spent to report
+    void execute(Civilization& civ, OrdersReport& report) const;
+
+private:
+    TechBranch m_investBranch = TechBranch::Science;
+    double m_investShare = 0.0;
+    bool m_autoResearch = false;
+};
+
+} // namespace civ
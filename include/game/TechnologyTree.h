@@ -2,6 +2,8 @@
 
 #include "core/Types.h"
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,12 +26,24 @@ struct Technology {
           researched(false), description(std::move(desc)) {}
 };
 
+// Index of a technology in its TechnologyTree; the same technology keeps the
+// same id for the lifetime of the tree and in every copy of it
+using TechId = uint16_t;
+
 /**
  * @brief Manages the technology tree with 5 branches.
  *        Each branch has levels that unlock new capabilities.
+ *        The available and researched lists are cached as TechIds and rebuilt
+ *        only when a branch levels up, a technology is researched or a save is
+ *        loaded; getListVersion() changes whenever they are. Reading them never
+ *        scans the tree or allocates.
  */
 class TechnologyTree {
 public:
+    static constexpr int MAX_BRANCH_LEVEL = 20;
+    // Resources whose production the Industry branch boosts (getProductionBonus)
+    static constexpr std::array<ResourceType, 2> INDUSTRY_BONUS_RESOURCES = { ResourceType::Energy, ResourceType::Materials };
+
     TechnologyTree();
 
     // Investment
@@ -41,14 +55,26 @@ public:
     [[nodiscard]] double getBranchProgress(TechBranch branch) const;
     [[nodiscard]] double getBranchThreshold(TechBranch branch) const;
     [[nodiscard]] Era getCurrentEra() const;
+    [[nodiscard]] static Era eraForTechLevel(int overallLevel);
+    [[nodiscard]] static double levelUpThreshold(int currentLevel);   // Progress needed to leave currentLevel
 
     // Available technologies
+    [[nodiscard]] const Technology& getTechnology(TechId id) const { return m_technologies[id]; }
+    [[nodiscard]] size_t getTechnologyCount() const { return m_technologies.size(); }
+    [[nodiscard]] const std::vector<TechId>& getAvailableIds() const { return m_availableIds; }
+    [[nodiscard]] const std::vector<TechId>& getResearchedIds() const { return m_researchedIds; }
+    [[nodiscard]] uint64_t getListVersion() const { return m_listVersion; }
+    [[nodiscard]] bool isAvailable(TechId id) const;
+    [[nodiscard]] const Technology* getCheapestAvailable() const;   // nullptr if none
     [[nodiscard]] std::vector<const Technology*> getAvailableTechs() const;
     [[nodiscard]] std::vector<const Technology*> getResearchedTechs() const;
+    [[nodiscard]] size_t getResearchedCount() const { return m_researchedIds.size(); }
+    bool researchTech(TechId id);
     bool researchTech(const std::string& techName);
 
     // Bonuses from tech
-    [[nodiscard]] double getProductionBonus() const;
+    [[nodiscard]] double getProductionBonus() const;   // Industry: Energy and Materials production
+    [[nodiscard]] static double productionBonusForLevel(int industryLevel);
     [[nodiscard]] double getMilitaryBonus() const;
     [[nodiscard]] double getMedicineBonus() const;
     [[nodiscard]] double getSpaceProgress() const;
@@ -62,15 +88,17 @@ public:
 
 private:
     static constexpr size_t NUM_BRANCHES = static_cast<size_t>(TechBranch::COUNT);
-    static constexpr int MAX_BRANCH_LEVEL = 20;
 
     std::array<int, NUM_BRANCHES> m_branchLevels{};
     std::array<double, NUM_BRANCHES> m_branchProgress{};
     std::vector<Technology> m_technologies;
+    std::vector<TechId> m_availableIds;    // Tree order
+    std::vector<TechId> m_researchedIds;   // Tree order
+    uint64_t m_listVersion = 0;
 
     void initTechnologies();
-    [[nodiscard]] double levelUpThreshold(int currentLevel) const;
     void checkLevelUp(TechBranch branch);
+    void rebuildLists();
 };
 
 } // namespace civ
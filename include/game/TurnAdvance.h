@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/Types.h"
+#include "game/EventSystem.h"
+#include "game/StandingOrders.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace civ {
+
+class Civilization;
+
+/**
+ * @brief The figures of a civilization a turn summary compares.
+ */
+struct CivSnapshot {
+    int turn = 0;
+    Era era = Era::StoneAge;
+    int population = 0;
+    double happiness = 0.0;
+    double ecology = 0.0;
+    double military = 0.0;
+    int techLevel = 0;
+    std::array<double, static_cast<size_t>(ResourceType::COUNT)> resources{};
+
+    [[nodiscard]] static CivSnapshot capture(const Civilization& civ);
+};
+
+/**
+ * @brief What happened over a run of advanced turns.
+ */
+struct TurnSummary {
+    CivSnapshot before;
+    CivSnapshot after;
+    int turnsPlayed = 0;
+    int quietYears = 0;
+    std::vector<GameEvent> events;   // Events other than quiet years, in order
+    OrdersReport orders;
+    GameResult result = GameResult::InProgress;
+};
+
+/**
+ * @brief Plays several turns in a row without player input, carrying out the
+ *        standing orders after each turn is processed, where the player acts
+ *        in turn-by-turn play. Runs of quiet years go through FastForward, so
+ *        the outcome is exactly that of the same turns played one at a time.
+ *        Stops early when the game ends.
+ */
+class TurnAdvance {
+public:
+    static TurnSummary run(Civilization& civ, EventSystem& events,
+                           const StandingOrders& orders, int turns);
+};
+
+} // namespace civ
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/Types.h"
+#include "ui/DrawList.h"
+#include "ui/Framebuffer.h"
+
+namespace civ {
+
+class CityModel;
+class SettlerSystem;
+
+/**
+ * @brief What one frame of the city map shows.
+ */
+struct CityMapView {
+    const CityModel* city = nullptr;            // Null or unfounded: no buildings
+    const SettlerSystem* settlers = nullptr;
+    Era era = Era::StoneAge;
+    int selectedBuilding = -1;                  // HUD item highlighted, or -1
+};
+
+/**
+ * @brief Draws the city map (ground, settlers, buildings and the building
+ *        HUD) through a DrawList into a Framebuffer, with no platform calls.
+ *        The Win32 front end blits the frame and writes the HUD labels on top;
+ *        the benches render it headless and can dump it as PPM. The HUD layout
+ *        lives here so drawing and hit-testing agree.
+ */
+class CityMapRenderer {
+public:
+    static constexpr int HUD_HEIGHT = 40;
+    static constexpr int HUD_ITEM_LEFT = 10;
+    static constexpr int HUD_ITEM_WIDTH = 80;
+    static constexpr int HUD_ITEM_STEP = 90;
+    static constexpr int HUD_ITEM_HEIGHT = 30;
+
+    void resize(int width, int height);
+    void render(const CityMapView& view);
+
+    [[nodiscard]] const Framebuffer& frame() const { return m_frame; }
+    [[nodiscard]] const DrawList& drawList() const { return m_drawList; }
+
+    // Building kind of the HUD item under x (the HUD shows only the kinds the
+    // era allows), or -1
+    [[nodiscard]] static int hudItemAt(int x, Era era);
+    // Left edge of the HUD item of a building kind, or -1 when the era hides it
+    [[nodiscard]] static int hudItemLeft(int defIndex, Era era);
+
+private:
+    DrawList m_drawList;
+    Framebuffer m_frame;
+
+    void recordBuilding(float x, float y, int size, uint32_t rgb);
+};
+
+} // namespace civ
@@ -2,6 +2,9 @@
 
 #include "game/Civilization.h"
 #include "game/EventSystem.h"
+#include "game/GameViewModel.h"
+#include "game/StandingOrders.h"
+#include "game/TurnAdvance.h"
 #include "core/Types.h"
 #include <string>
 #include <vector>
@@ -19,19 +22,23 @@ public:
     void showTitle() const;
     void showMainMenu() const;
     void showDifficultyMenu() const;
-    void showGameStatus(const Civilization& civ) const;
+    void showGameStatus(const Civilization& civ, const EventSystem& events);
     void showResourcePanel(const Civilization& civ) const;
     void showTechTree(const Civilization& civ) const;
     void showEvent(const GameEvent& event) const;
     void showTurnMenu(const Civilization& civ) const;
     void showInvestmentMenu(const Civilization& civ) const;
     void showEventLog(const EventSystem& events) const;
+    void showStandingOrders(const StandingOrders& orders) const;
+    void showTurnSummary(const TurnSummary& summary) const;
+    void showForecast(const Civilization& civ, const CivSnapshot& forecast) const;
     void showVictory(GameResult result) const;
     void showDefeat(GameResult result) const;
     void showHelp() const;
 
     // Utility
     void clearScreen() const;
+    void resetView();   // A new or loaded game: the next status panel formats everything
     void waitForInput() const;
     void showSeparator(int width = 60) const;
     void showDoubleSeparator(int width = 60) const;
@@ -40,8 +47,17 @@ public:
     void showEraArt(Era era) const;
 
 private:
+    // The status panel keeps each section's text and formats again only the
+    // sections whose data changed since it was last shown
+    GameViewModel m_view;
+    std::string m_headerText;
+    std::string m_civText;
+    std::string m_resourceText;
+    std::string m_techText;
+
     void showBar(const std::string& label, double value, double maxVal,
                  int width = 30, const std::string& color = "") const;
+    void showDelta(const std::string& label, double before, double after, int precision = 1) const;
 };
 
 } // namespace civ
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace civ {
+
+class Framebuffer;
+
+enum class DrawKind : uint8_t {
+    FillRect = 0,
+    FrameRect,
+    FillTriangle,
+    Dots,        // size x size squares centred on points from external columns
+};
+
+struct DrawCommand {
+    uint64_t key = 0;   // Layer, kind, colour, then recording order
+    DrawKind kind = DrawKind::FillRect;
+    uint32_t color = 0;   // 0xRRGGBB
+    int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    const float* xs = nullptr;   // Dots
+    const float* ys = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * @brief Platform-independent list of 2D primitives for one frame. Front ends
+ *        record commands into layers, sort() orders them by layer and within a
+ *        layer by style (kind and colour), and rasterize() draws them into a
+ *        Framebuffer one style batch at a time. Lower layers draw first; within
+ *        a layer the order between styles is not kept, so commands that
+ *        overlap must go to different layers. A whole crowd of points is one
+ *        Dots command reading the caller's coordinate columns, which must stay
+ *        valid until rasterize(). The command vector is reused across frames,
+ *        so recording allocates only while it grows.
+ */
+class DrawList {
+public:
+    static constexpr size_t MAX_COMMANDS = size_t(1) << 24;   // Recording order fits the key
+
+    void clear() { m_commands.clear(); }
+    void reserve(size_t commands) { m_commands.reserve(commands); }
+
+    void fillRect(uint8_t layer, int x0, int y0, int x1, int y1, uint32_t rgb);
+    void frameRect(uint8_t layer, int x0, int y0, int x1, int y1, uint32_t rgb);
+    void fillTriangle(uint8_t layer, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t rgb);
+    void dots(uint8_t layer, const float* xs, const float* ys, size_t count, int size, uint32_t rgb);
+
+    void sort();
+    void rasterize(Framebuffer& target) const;
+
+    [[nodiscard]] size_t size() const { return m_commands.size(); }
+    [[nodiscard]] const std::vector<DrawCommand>& getCommands() const { return m_commands; }
+    // Runs of consecutive commands with the same layer and style
+    [[nodiscard]] size_t countBatches() const;
+
+private:
+    std::vector<DrawCommand> m_commands;
+
+    DrawCommand& record(uint8_t layer, DrawKind kind, uint32_t rgb);
+    static uint64_t styleOf(const DrawCommand& command) { return command.key >> 24; }
+};
+
+} // namespace civ
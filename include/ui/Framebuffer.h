@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace civ {
+
+/**
+ * @brief 32-bit pixel buffer for the software rasterizer. Pixels are
+ *        0xAARRGGBB words, rows top to bottom with no padding, which is the
+ *        memory layout of a top-down 32 bpp Windows DIB, so a front end can
+ *        blit it as is. Every fill is clipped to the buffer and costs as much
+ *        as the pixels it covers.
+ */
+class Framebuffer {
+public:
+    void resize(int width, int height);   // Contents undefined until drawn
+
+    [[nodiscard]] int getWidth() const { return m_width; }
+    [[nodiscard]] int getHeight() const { return m_height; }
+    [[nodiscard]] const uint32_t* data() const { return m_pixels.data(); }
+    [[nodiscard]] uint32_t pixel(int x, int y) const { return m_pixels[static_cast<size_t>(y) * m_width + x]; }
+
+    // Colours are 0xRRGGBB; the alpha byte is set opaque
+    void clear(uint32_t rgb);
+    void fillRect(int x0, int y0, int x1, int y1, uint32_t rgb);    // [x0, x1) x [y0, y1)
+    void frameRect(int x0, int y0, int x1, int y1, uint32_t rgb);   // One pixel border inside the rect
+    // Pixels whose centres lie inside or on the triangle
+    void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint32_t rgb);
+
+    // Binary PPM (P6) of the RGB channels, for headless checks and snapshots
+    void writePpm(std::ostream& out) const;
+    bool writePpm(const std::string& path) const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<uint32_t> m_pixels;
+};
+
+} // namespace civ
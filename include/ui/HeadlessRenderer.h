@@ -0,0 +1,41 @@
+#pragma once
+
+#include "game/GameSnapshot.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace civ {
+
+/**
+ * @brief Renders a GameSnapshot into an in-memory text frame: the status,
+ *        resource and technology panels and the latest events, as the console
+ *        shows them, without any terminal or window. Frames are built in one
+ *        fixed buffer with the Utils::*To formatters instead of streams, so a
+ *        renderer thread can draw at a high frame rate next to the simulation.
+ *        Text that does not fit the frame is dropped.
+ */
+class HeadlessRenderer {
+public:
+    static constexpr size_t FRAME_CAPACITY = 4096;
+
+    // Renders snapshot as the current frame; returns its length in bytes
+    size_t render(const GameSnapshot& snapshot);
+
+    [[nodiscard]] std::string_view frame() const { return std::string_view(m_frame.data(), m_length); }
+    [[nodiscard]] uint64_t framesRendered() const { return m_frames; }
+
+private:
+    std::array<char, FRAME_CAPACITY> m_frame{};
+    size_t m_length = 0;
+    uint64_t m_frames = 0;
+
+    void append(std::string_view text);
+    void appendNumber(int64_t value);
+    void appendDouble(double value, int precision);
+    void appendPadded(std::string_view text, size_t width);
+    void appendBar(double value, double maxValue, int width);
+};
+
+} // namespace civ
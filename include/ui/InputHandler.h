@@ -1,15 +1,30 @@
 #pragma once
 
-#include <string>
+#include <functional>
 #include <optional>
+#include <stdexcept>
+#include <string>
 
 namespace civ {
 
+/**
+ * @brief Thrown when standard input ends while the game waits for the player.
+ */
+class InputClosedError : public std::runtime_error {
+public:
+    InputClosedError() : std::runtime_error("standard input closed") {}
+};
+
 /**
  * @brief Handles user input with validation.
+ *        Input is read through LineInput without blocking: while the player
+ *        has not finished a line, the idle handler runs every IDLE_TICK_MS,
+ *        so the game can take in background work between keystrokes.
  */
 class InputHandler {
 public:
+    static constexpr int IDLE_TICK_MS = 50;
+
     InputHandler() = default;
 
     // Get validated integer input
@@ -29,6 +44,13 @@ public:
 
     // Wait for any key
     static void waitForKey();
+
+    // Called on the game thread while waiting for input; empty to disable
+    static void setIdleHandler(std::function<void()> handler);
+
+private:
+    // Next line of input; throws InputClosedError at the end of input
+    static std::string readLine();
 };
 
 } // namespace civ
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+#include "core/ConcurrentQueue.h"
+#include <thread>
+#endif
+
+namespace civ {
+
+enum class LineStatus {
+    Line,      // A full line was read
+    Timeout,   // Nothing complete arrived in time
+    Closed     // Standard input ended
+};
+
+/**
+ * @brief Non-blocking line reader for standard input.
+ *        The terminal stays in line mode, so echo and editing (including
+ *        Cyrillic names) keep working, and a line becomes readable once the
+ *        player presses Enter. On POSIX the reader polls the descriptor and
+ *        buffers partial input itself; on Windows, where console handles
+ *        cannot be polled for whole lines, a reader thread feeds a queue.
+ *        All reads of standard input must go through this class.
+ */
+class LineInput {
+public:
+    static LineInput& instance();
+
+    LineInput(const LineInput&) = delete;
+    LineInput& operator=(const LineInput&) = delete;
+
+    // Waits at most timeoutMs for the next line (without the line break)
+    LineStatus readLine(std::string& line, int timeoutMs);
+
+private:
+    LineInput() = default;
+    ~LineInput();
+
+#ifdef _WIN32
+    ConcurrentQueue<std::string> m_lines;
+    std::thread m_reader;
+#else
+    std::string m_buffer;
+    bool m_closed = false;
+
+    bool takeLine(std::string& line);
+#endif
+};
+
+} // namespace civ
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace civ {
+
+class GameEngine;
+
+/**
+ * @brief Drives a GameEngine from a command script instead of the keyboard,
+ *        through the same actions the menus use but without screens or key
+ *        waits. One command per line, '#' starts a comment, arguments with
+ *        spaces go in double quotes:
+ *          new <easy|normal|hard|nightmare> ["name"]
+ *          load ["file"]            save ["file"]
+ *          invest <branch> <amount>
+ *          research <"name"|cheapest>
+ *          turn [N]                 N turns one by one, as the "next turn" action
+ *          advance <N>              N turns with standing orders, as "advance N turns"
+ *          orders invest <branch> <percent> | orders research <on|off> | orders clear
+ *          status
+ *        Branches and difficulties take English keywords or the names the game
+ *        shows. Every command is timed: the report lists each one with its
+ *        outcome and wall time, then totals per command. The first failing
+ *        command stops the script.
+ */
+class ScriptRunner {
+public:
+    explicit ScriptRunner(GameEngine& engine) : m_engine(engine) {}
+
+    // 0 if every command succeeded, 1 otherwise
+    int run(std::istream& script, std::ostream& report);
+
+    // Splits a line into words; double quotes group words, '#' outside quotes ends the line
+    [[nodiscard]] static std::vector<std::string> tokenize(const std::string& line);
+
+private:
+    struct CommandStats {
+        std::string name;
+        int count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    GameEngine& m_engine;
+    std::vector<CommandStats> m_stats;
+
+    // Runs one command; outcome describes the result, or the error when false is returned
+    bool execute(const std::vector<std::string>& args, std::string& outcome);
+    bool playTurns(int turns, std::string& outcome);
+    void record(const std::string& name, double ms);
+    void writeTotals(std::ostream& report) const;
+};
+
+} // namespace civ
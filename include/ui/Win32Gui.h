@@ -3,6 +3,8 @@
 #include <Windows.h>
 #include "game/Civilization.h"
 #include "game/EventSystem.h"
+#include "game/GameSnapshot.h"
+#include "game/GameViewModel.h"
 #include "game/SaveSystem.h"
 #include <string>
 #include <memory>
@@ -36,8 +38,9 @@ public:
 
 private:
     void createControls();
+    void publishSnapshot();
     void updateAllUI();
-    void updateStats();
+    void updateStats(ViewChanges changes);
     void updateResources();
     void updateTechTree();
     void updateEvents();
@@ -60,6 +63,7 @@ private:
     HINSTANCE m_hInstance;
     HWND m_mainWindow;
     bool m_running;
+    std::string m_tracePath; // INTSIM_TRACE output (profiling builds)
     
     // Brushes for background colors
     HBRUSH m_bgBrush = nullptr;
@@ -70,6 +74,11 @@ private:
     std::unique_ptr<EventSystem> m_events;
     std::unique_ptr<SaveSystem> m_saveSystem;
     Difficulty m_difficulty;
+
+    // Labels, bars and the event log draw from the latest published snapshot,
+    // never from the live game state; the tech list maps rows to live techs
+    SnapshotChannel m_snapshots;
+    GameViewModel m_view;   // Last drawn snapshot; updateAllUI redraws what changed
     
     // Controls
     HWND m_eraLabel;
@@ -0,0 +1,59 @@
+#include "core/AliasTable.h"
+#include <numeric>
+
+namespace civ {
+
+void AliasTable::build(const std::vector<double>& weights) {
+    m_probability.clear();
+    m_alias.clear();
+
+    double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    if (weights.empty() || total <= 0.0) return;
+
+    const size_t n = weights.size();
+    m_probability.resize(n);
+    m_alias.resize(n);
+
+    // Vose's method: scale to mean 1, then pair each under-full column with an over-full one
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * static_cast<double>(n) / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        small.pop_back();
+        uint32_t more = large.back();
+        large.pop_back();
+
+        m_probability[less] = scaled[less];
+        m_alias[less] = more;
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        (scaled[more] < 1.0 ? small : large).push_back(more);
+    }
+    // Leftovers are 1 up to rounding error
+    for (uint32_t i : large) {
+        m_probability[i] = 1.0;
+        m_alias[i] = i;
+    }
+    for (uint32_t i : small) {
+        m_probability[i] = 1.0;
+        m_alias[i] = i;
+    }
+}
+
+double AliasTable::probabilityOf(size_t index) const {
+    if (index >= m_probability.size()) return 0.0;
+    double mass = m_probability[index];
+    for (size_t column = 0; column < m_alias.size(); ++column) {
+        if (column != index && m_alias[column] == index) {
+            mass += 1.0 - m_probability[column];
+        }
+    }
+    return mass / static_cast<double>(m_probability.size());
+}
+
+} // namespace civ
@@ -0,0 +1,150 @@
+#include "core/AllocationTracker.h"
+#include "core/Profiler.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace civ {
+
+namespace {
+
+constexpr size_t NUM_PHASES = static_cast<size_t>(ProfilePhase::COUNT);
+
+struct AtomicCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+// Slot 0 is "Untagged", slot i + 1 is ProfilePhase i
+std::array<AtomicCounters, NUM_PHASES + 1> g_counters;
+
+thread_local int t_currentTag = AllocationTracker::UNTAGGED;
+
+AllocationTracker::Counters load(const AtomicCounters& c) {
+    return { c.allocations.load(std::memory_order_relaxed),
+             c.bytes.load(std::memory_order_relaxed) };
+}
+
+} // namespace
+
+bool AllocationTracker::isActive() {
+#ifdef INTSIM_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocationTracker::onAllocate(size_t bytes) {
+    auto& slot = g_counters[static_cast<size_t>(t_currentTag + 1)];
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+AllocationTracker::Counters AllocationTracker::total() {
+    Counters sum;
+    for (const auto& slot : g_counters) {
+        Counters c = load(slot);
+        sum.allocations += c.allocations;
+        sum.bytes += c.bytes;
+    }
+    return sum;
+}
+
+AllocationTracker::Counters AllocationTracker::forPhase(ProfilePhase phase) {
+    return load(g_counters[static_cast<size_t>(phase) + 1]);
+}
+
+AllocationTracker::Counters AllocationTracker::untagged() {
+    return load(g_counters[0]);
+}
+
+void AllocationTracker::reset() {
+    for (auto& slot : g_counters) {
+        slot.allocations.store(0, std::memory_order_relaxed);
+        slot.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+int AllocationTracker::currentTag() {
+    return t_currentTag;
+}
+
+void AllocationTracker::setCurrentTag(int tag) {
+    t_currentTag = tag;
+}
+
+void AllocationTracker::dump(std::ostream& out, uint64_t turns) {
+    double divisor = turns ? static_cast<double>(turns) : 1.0;
+    out << "=== Heap allocations" << (turns ? " per turn" : "") << " ===\n";
+    out << std::left << std::setw(18) << "phase" << std::right
+        << std::setw(14) << "allocations" << std::setw(14) << "bytes" << "\n";
+
+    auto row = [&](const char* name, Counters c) {
+        if (c.allocations == 0) return;
+        out << std::left << std::setw(18) << name << std::right << std::fixed
+            << std::setprecision(turns ? 2 : 0)
+            << std::setw(14) << static_cast<double>(c.allocations) / divisor
+            << std::setw(14) << static_cast<double>(c.bytes) / divisor << "\n";
+    };
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        auto phase = static_cast<ProfilePhase>(i);
+        row(profilePhaseToString(phase), forPhase(phase));
+    }
+    row("Untagged", untagged());
+}
+
+} // namespace civ
+
+// ============================================================
+// Global operator new/delete replacement
+// ============================================================
+
+#ifdef INTSIM_TRACK_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+    civ::AllocationTracker::onAllocate(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    civ::AllocationTracker::onAllocate(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+#endif // INTSIM_TRACK_ALLOCATIONS
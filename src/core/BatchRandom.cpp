@@ -0,0 +1,141 @@
+#include "core/BatchRandom.h"
+#include <cstring>
+
+namespace civ {
+
+namespace {
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+} // namespace
+
+BatchRandom::BatchRandom(uint64_t seed) {
+    this->seed(seed);
+}
+
+void BatchRandom::seed(uint64_t seed) {
+    // Lane 0 from SplitMix64 as recommended for xoshiro seeding; every further
+    // lane is the previous one jumped 2^128 steps ahead, so the streams cannot
+    // overlap within 2^128 draws per lane
+    uint64_t state = seed;
+    uint64_t s[4] = { splitMix64(state), splitMix64(state), splitMix64(state), splitMix64(state) };
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        if (lane > 0) jump(s);
+        m_s0[lane] = s[0];
+        m_s1[lane] = s[1];
+        m_s2[lane] = s[2];
+        m_s3[lane] = s[3];
+    }
+}
+
+void BatchRandom::jump(uint64_t* s) {
+    // Reference xoshiro256 jump polynomial: 2^128 calls to next()
+    static constexpr uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+    };
+    uint64_t j0 = 0, j1 = 0, j2 = 0, j3 = 0;
+    for (uint64_t word : JUMP) {
+        for (int b = 0; b < 64; ++b) {
+            if (word & (uint64_t(1) << b)) {
+                j0 ^= s[0];
+                j1 ^= s[1];
+                j2 ^= s[2];
+                j3 ^= s[3];
+            }
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+        }
+    }
+    s[0] = j0;
+    s[1] = j1;
+    s[2] = j2;
+    s[3] = j3;
+}
+
+void BatchRandom::next(std::array<uint64_t, LANES>& out) {
+    State state = load();
+    step(state, out.data());
+    store(state);
+}
+
+void BatchRandom::fillUniform(double* out, size_t count) {
+    // Work on a local copy of the state so the compiler knows out cannot alias it
+    State state = load();
+    uint64_t bits[LANES];
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        step(state, bits);
+        toUniform(bits, out + i, LANES);
+    }
+    if (i < count) {
+        step(state, bits);
+        toUniform(bits, out + i, count - i);
+    }
+    store(state);
+}
+
+BatchRandom::State BatchRandom::load() const {
+    return State{ m_s0, m_s1, m_s2, m_s3 };
+}
+
+void BatchRandom::store(const State& state) {
+    m_s0 = state.s0;
+    m_s1 = state.s1;
+    m_s2 = state.s2;
+    m_s3 = state.s3;
+}
+
+void BatchRandom::step(State& state, uint64_t* out) {
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        uint64_t s0 = state.s0[lane];
+        uint64_t s1 = state.s1[lane];
+        uint64_t s2 = state.s2[lane];
+        uint64_t s3 = state.s3[lane];
+
+        // rotl(s1 * 5, 7) * 9
+        uint64_t times5 = (s1 << 2) + s1;
+        uint64_t rotated = rotl(times5, 7);
+        out[lane] = (rotated << 3) + rotated;
+
+        uint64_t t = s1 << 17;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = rotl(s3, 45);
+
+        state.s0[lane] = s0;
+        state.s1[lane] = s1;
+        state.s2[lane] = s2;
+        state.s3[lane] = s3;
+    }
+}
+
+void BatchRandom::toUniform(const uint64_t* bits, double* out, size_t count) {
+    constexpr uint64_t ONE_BITS = 0x3FF0000000000000ull; // 1.0
+
+    // Top 52 bits as the mantissa of a double in [1, 2), minus one
+    for (size_t lane = 0; lane < count; ++lane) {
+        uint64_t mantissa = (bits[lane] >> 12) | ONE_BITS;
+        double value;
+        std::memcpy(&value, &mantissa, sizeof(value));
+        out[lane] = value - 1.0;
+    }
+}
+
+} // namespace civ
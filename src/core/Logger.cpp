@@ -1,11 +1,13 @@
 #include "core/Logger.h"
+#include "core/Profiler.h"
 #include <iostream>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
 
 namespace civ {
 
+thread_local bool Logger::s_threadMuted = false;
+
 Logger& Logger::instance() {
     static Logger inst;
     return inst;
@@ -25,8 +27,8 @@ void Logger::init(const std::string& filename, LogLevel minLevel) {
         std::cerr << "[Logger] Failed to open log file: " << filename << std::endl;
         return;
     }
-    m_minLevel = minLevel;
-    m_initialized = true;
+    m_minLevel.store(minLevel, std::memory_order_relaxed);
+    m_initialized.store(true, std::memory_order_release);
     m_file << "=== Civilization Simulator Log ===" << std::endl;
     m_file << "Session started" << std::endl;
     m_file << "=================================" << std::endl;
@@ -42,10 +44,11 @@ void Logger::shutdown() {
 }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    if (level < m_minLevel) {
+    if (!isEnabled(level)) {
         return;
     }
 
+    CIV_PROFILE_SCOPE(Logging);
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Build timestamp
@@ -58,11 +61,13 @@ void Logger::log(LogLevel level, const std::string& message) {
     localtime_r(&time, &tm_buf);
 #endif
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_buf, "%H:%M:%S");
-    std::string timestamp = oss.str();
+    char timestamp[16];
+    size_t timestampLen = std::strftime(timestamp, sizeof(timestamp), "%H:%M:%S", &tm_buf);
 
-    std::string logLine = "[" + timestamp + "] [" + levelToString(level) + "] " + message;
+    std::string logLine;
+    logLine.reserve(timestampLen + message.size() + 12);
+    logLine.append("[").append(timestamp, timestampLen).append("] [")
+           .append(levelToString(level)).append("] ").append(message);
 
     // Write to file
     if (m_file.is_open()) {
@@ -0,0 +1,160 @@
+#include "core/Profiler.h"
+#include <fstream>
+#include <iomanip>
+
+namespace civ {
+
+const char* profilePhaseToString(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Turn:            return "Turn";
+        case ProfilePhase::GenerateEvent:   return "GenerateEvent";
+        case ProfilePhase::ApplyEvent:      return "ApplyEvent";
+        case ProfilePhase::EventEffects:    return "EventEffects";
+        case ProfilePhase::ResourceTurn:    return "ResourceTurn";
+        case ProfilePhase::GrowPopulation:  return "GrowPopulation";
+        case ProfilePhase::UpdateEcology:   return "UpdateEcology";
+        case ProfilePhase::UpdateHappiness: return "UpdateHappiness";
+        case ProfilePhase::Logging:         return "Logging";
+        case ProfilePhase::Rendering:       return "Rendering";
+        case ProfilePhase::SaveGame:        return "SaveGame";
+        case ProfilePhase::LoadGame:        return "LoadGame";
+        default:                            return "Unknown";
+    }
+}
+
+const char* profilePhaseCategory(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Logging:   return "log";
+        case ProfilePhase::Rendering: return "ui";
+        case ProfilePhase::SaveGame:
+        case ProfilePhase::LoadGame:  return "io";
+        default:                      return "sim";
+    }
+}
+
+// ============================================================
+// LatencyHistogram
+// ============================================================
+
+namespace {
+
+int highestBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    // Top SUB_BUCKET_BITS + 1 bits select the bucket: the leading one picks the
+    // power of two, the following bits pick the linear sub-bucket inside it
+    int exponent = highestBit(value);
+    int shift = exponent - SUB_BUCKET_BITS;
+    uint64_t sub = (value >> shift) - SUB_BUCKETS;
+    return static_cast<size_t>(SUB_BUCKETS + static_cast<uint64_t>(shift) * SUB_BUCKETS + sub);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << shift;
+}
+
+void LatencyHistogram::record(uint64_t valueNs) {
+    m_buckets[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(valueNs, std::memory_order_relaxed);
+
+    uint64_t prevMax = m_max.load(std::memory_order_relaxed);
+    while (valueNs > prevMax &&
+           !m_max.compare_exchange_weak(prevMax, valueNs, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t n = count();
+    return n ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double pct) const {
+    uint64_t n = count();
+    if (n == 0) return 0;
+
+    auto target = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(n) + 0.5);
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return bucketLowerBound(i);
+        }
+    }
+    return max();
+}
+
+// ============================================================
+// Profiler
+// ============================================================
+
+Profiler& Profiler::instance() {
+    static Profiler inst;
+    return inst;
+}
+
+void Profiler::reset() {
+    for (auto& histogram : m_histograms) {
+        histogram.reset();
+    }
+}
+
+void Profiler::dump(std::ostream& out) const {
+    out << "=== Phase latency (ns) ===\n";
+    out << std::left << std::setw(18) << "phase" << std::right
+        << std::setw(10) << "count" << std::setw(12) << "mean"
+        << std::setw(10) << "p50" << std::setw(10) << "p90"
+        << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+        << std::setw(12) << "max" << "\n";
+
+    for (size_t i = 0; i < m_histograms.size(); ++i) {
+        const auto& h = m_histograms[i];
+        if (h.count() == 0) continue;
+        out << std::left << std::setw(18) << profilePhaseToString(static_cast<ProfilePhase>(i))
+            << std::right << std::setw(10) << h.count()
+            << std::setw(12) << std::fixed << std::setprecision(0) << h.mean()
+            << std::setw(10) << h.percentile(50.0)
+            << std::setw(10) << h.percentile(90.0)
+            << std::setw(10) << h.percentile(99.0)
+            << std::setw(10) << h.percentile(99.9)
+            << std::setw(12) << h.max() << "\n";
+    }
+}
+
+bool Profiler::dumpToFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) return false;
+    dump(file);
+    return true;
+}
+
+} // namespace civ
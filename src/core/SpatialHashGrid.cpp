@@ -0,0 +1,151 @@
+#include "core/SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace civ {
+
+namespace {
+
+constexpr size_t MIN_BUCKETS = 64;
+constexpr float CELL_LIMIT = 1073741824.0f;   // 2^30: far coordinates share the edge cells
+
+} // namespace
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 1.0f),
+      m_inverseCell(1.0f / m_cellSize),
+      m_buckets(MIN_BUCKETS, NIL) {}
+
+int32_t SpatialHashGrid::cellOf(float coordinate) const {
+    float cell = std::floor(coordinate * m_inverseCell);
+    if (!(cell > -CELL_LIMIT)) cell = -CELL_LIMIT;   // Also catches NaN
+    if (cell > CELL_LIMIT) cell = CELL_LIMIT;
+    return static_cast<int32_t>(cell);
+}
+
+size_t SpatialHashGrid::bucketOf(int32_t cellX, int32_t cellY) const {
+    uint32_t hash = static_cast<uint32_t>(cellX) * 0x9E3779B1u ^ static_cast<uint32_t>(cellY) * 0x85EBCA77u;
+    hash ^= hash >> 15;
+    return hash & (m_buckets.size() - 1);
+}
+
+void SpatialHashGrid::link(uint32_t node) {
+    uint32_t& head = m_buckets[bucketOf(m_nodes[node].cellX, m_nodes[node].cellY)];
+    m_nodes[node].next = head;
+    head = node;
+}
+
+void SpatialHashGrid::rehash(size_t buckets) {
+    m_buckets.assign(buckets, NIL);
+    for (uint32_t n = 0; n < m_nodes.size(); ++n) {
+        if (m_nodes[n].id != NONE) link(n);
+    }
+}
+
+void SpatialHashGrid::insert(uint32_t id, float x, float y) {
+    uint32_t node;
+    if (m_free != NIL) {
+        node = m_free;
+        m_free = m_nodes[node].next;
+    } else {
+        m_nodes.emplace_back();
+        node = static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+    Node& entry = m_nodes[node];
+    entry.x = x;
+    entry.y = y;
+    entry.cellX = cellOf(x);
+    entry.cellY = cellOf(y);
+    entry.id = id;
+    link(node);
+
+    if (++m_size > m_buckets.size()) {
+        rehash(m_buckets.size() * 2);
+    }
+}
+
+bool SpatialHashGrid::remove(uint32_t id, float x, float y) {
+    const int32_t cellX = cellOf(x);
+    const int32_t cellY = cellOf(y);
+    uint32_t* slot = &m_buckets[bucketOf(cellX, cellY)];
+    while (*slot != NIL) {
+        Node& node = m_nodes[*slot];
+        if (node.id == id && node.cellX == cellX && node.cellY == cellY) {
+            uint32_t freed = *slot;
+            *slot = node.next;
+            node.id = NONE;
+            node.next = m_free;
+            m_free = freed;
+            --m_size;
+            return true;
+        }
+        slot = &node.next;
+    }
+    return false;
+}
+
+void SpatialHashGrid::move(uint32_t id, float fromX, float fromY, float toX, float toY) {
+    const int32_t cellX = cellOf(fromX);
+    const int32_t cellY = cellOf(fromY);
+    if (cellX == cellOf(toX) && cellY == cellOf(toY)) {
+        // Same cell: update in place
+        for (uint32_t n = m_buckets[bucketOf(cellX, cellY)]; n != NIL; n = m_nodes[n].next) {
+            Node& node = m_nodes[n];
+            if (node.id == id && node.cellX == cellX && node.cellY == cellY) {
+                node.x = toX;
+                node.y = toY;
+                return;
+            }
+        }
+        return;
+    }
+    if (remove(id, fromX, fromY)) {
+        insert(id, toX, toY);
+    }
+}
+
+void SpatialHashGrid::clear() {
+    std::fill(m_buckets.begin(), m_buckets.end(), NIL);
+    m_nodes.clear();
+    m_free = NIL;
+    m_size = 0;
+}
+
+void SpatialHashGrid::reserve(size_t points) {
+    m_nodes.reserve(points);
+    size_t buckets = m_buckets.size();
+    while (buckets < points) buckets *= 2;
+    if (buckets != m_buckets.size()) {
+        rehash(buckets);
+    }
+}
+
+bool SpatialHashGrid::anyCloserThan(float x, float y, float distance) const {
+    const float distanceSq = distance * distance;
+    bool found = false;
+    forEachCandidate(x, y, distance, [&](const Node& node) {
+        float dx = node.x - x;
+        float dy = node.y - y;
+        found = dx * dx + dy * dy < distanceSq;
+        return !found;
+    });
+    return found;
+}
+
+uint32_t SpatialHashGrid::nearest(float x, float y, float radius) const {
+    uint32_t best = NONE;
+    float bestSq = radius * radius;
+    forEachCandidate(x, y, radius, [&](const Node& node) {
+        float dx = node.x - x;
+        float dy = node.y - y;
+        float distSq = dx * dx + dy * dy;
+        if (distSq < bestSq || (distSq == bestSq && node.id < best)) {
+            best = node.id;
+            bestSq = distSq;
+        }
+        return true;
+    });
+    return best;
+}
+
+} // namespace civ
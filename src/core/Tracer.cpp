@@ -0,0 +1,146 @@
+#include "core/Tracer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace civ {
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+namespace {
+
+struct ThreadTraceState {
+    TraceBuffer* buffer = nullptr;
+    uint32_t generation = 0;
+    int turn = -1;
+};
+
+thread_local ThreadTraceState t_traceState;
+
+} // namespace
+
+// ============================================================
+// TraceBuffer
+// ============================================================
+
+TraceBuffer::TraceBuffer(size_t capacity, uint32_t threadId)
+    : m_events(capacity > 0 ? capacity : 1)
+    , m_threadId(threadId)
+{
+}
+
+size_t TraceBuffer::size() const {
+    return static_cast<size_t>(std::min<uint64_t>(m_written, m_events.size()));
+}
+
+const TraceEvent& TraceBuffer::at(size_t index) const {
+    uint64_t first = (m_written > m_events.size()) ? m_written - m_events.size() : 0;
+    return m_events[(first + index) % m_events.size()];
+}
+
+// ============================================================
+// Tracer
+// ============================================================
+
+Tracer& Tracer::instance() {
+    static Tracer inst;
+    return inst;
+}
+
+void Tracer::start(size_t capacityPerThread) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) m_retired.push_back(std::move(buffer));
+    m_buffers.clear();
+    m_capacity = capacityPerThread;
+    // Bumping the generation makes every thread allocate a fresh buffer
+    m_generation.fetch_add(1, std::memory_order_release);
+    s_enabled.store(true, std::memory_order_seq_cst);
+}
+
+void Tracer::stop() {
+    // Pairs with record(): a push either sees the flag cleared and backs out,
+    // or set its buffer's recording flag first and is waited for here
+    s_enabled.store(false, std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& buffer : m_buffers) {
+        while (buffer->recording.load(std::memory_order_seq_cst)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Tracer::setCurrentTurn(int turn) {
+    t_traceState.turn = turn;
+}
+
+TraceBuffer* Tracer::threadBuffer() {
+    uint32_t generation = m_generation.load(std::memory_order_acquire);
+    if (t_traceState.buffer && t_traceState.generation == generation) {
+        return t_traceState.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto threadId = static_cast<uint32_t>(m_buffers.size() + 1);
+    m_buffers.push_back(std::make_unique<TraceBuffer>(m_capacity, threadId));
+    t_traceState.buffer = m_buffers.back().get();
+    t_traceState.generation = generation;
+    return t_traceState.buffer;
+}
+
+void Tracer::record(const char* name, const char* category, uint64_t startNs, uint64_t endNs) {
+    if (!isEnabled()) return;
+
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    event.turn = t_traceState.turn;
+
+    TraceBuffer* buffer = threadBuffer();
+    buffer->recording.store(true, std::memory_order_seq_cst);
+    if (s_enabled.load(std::memory_order_seq_cst)) {
+        buffer->push(event);
+    }
+    buffer->recording.store(false, std::memory_order_release);
+}
+
+bool Tracer::writeJson(const std::string& filename) const {
+    if (isEnabled()) return false;
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    file << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    for (const auto& buffer : m_buffers) {
+        for (size_t i = 0; i < buffer->size(); ++i) {
+            const TraceEvent& e = buffer->at(i);
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->getThreadId()
+                 << ",\"ts\":" << static_cast<double>(e.startNs) / 1000.0
+                 << ",\"dur\":" << static_cast<double>(e.durationNs) / 1000.0;
+            if (e.turn >= 0) {
+                file << ",\"args\":{\"turn\":" << e.turn << "}";
+            }
+            file << "}";
+            first = false;
+        }
+    }
+    file << "\n]}\n";
+    return true;
+}
+
+std::string Tracer::startFromEnvironment() {
+    const char* path = std::getenv("INTSIM_TRACE");
+    if (!path || !*path) return {};
+    start();
+    return path;
+}
+
+} // namespace civ
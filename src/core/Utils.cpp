@@ -3,11 +3,19 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace civ {
 
+namespace {
+thread_local std::mt19937* t_generator = nullptr;
+} // namespace
+
 std::mt19937& Utils::getGenerator() {
+    if (t_generator) return *t_generator;
     static std::mt19937 gen(
         static_cast<unsigned>(
             std::chrono::high_resolution_clock::now().time_since_epoch().count()
@@ -32,50 +40,151 @@ bool Utils::randomChance(double probability) {
     return randomDouble(0.0, 1.0) < probability;
 }
 
+void Utils::seedRandom(uint32_t seed) {
+    getGenerator().seed(seed);
+}
+
+std::mt19937 Utils::getRandomState() {
+    return getGenerator();
+}
+
+void Utils::setRandomState(const std::mt19937& state) {
+    getGenerator() = state;
+}
+
+void Utils::setThreadGenerator(std::mt19937* generator) {
+    t_generator = generator;
+}
+
 std::string Utils::padRight(const std::string& str, size_t width, char fill) {
-    if (str.size() >= width) return str;
-    return str + std::string(width - str.size(), fill);
+    size_t columns = displayWidth(str);
+    if (columns >= width) return str;
+    std::string result;
+    result.reserve(str.size() + (width - columns));
+    result.append(str);
+    result.append(width - columns, fill);
+    return result;
 }
 
 std::string Utils::padLeft(const std::string& str, size_t width, char fill) {
-    if (str.size() >= width) return str;
-    return std::string(width - str.size(), fill) + str;
+    size_t columns = displayWidth(str);
+    if (columns >= width) return str;
+    std::string result;
+    result.reserve(str.size() + (width - columns));
+    result.append(width - columns, fill);
+    result.append(str);
+    return result;
 }
 
 std::string Utils::formatNumber(int64_t number) {
-    std::string numStr = std::to_string(std::abs(number));
-    std::string result;
-    int count = 0;
-    for (auto it = numStr.rbegin(); it != numStr.rend(); ++it) {
+    char buf[NUMBER_BUFFER_SIZE];
+    size_t len = formatNumberTo(buf, sizeof(buf), number);
+    return std::string(buf, len);
+}
+
+std::string Utils::formatDouble(double value, int precision) {
+    char buf[DOUBLE_BUFFER_SIZE];
+    size_t len = formatDoubleTo(buf, sizeof(buf), value, precision);
+    if (len == 0) {
+        // Extremely large values or precisions: fall back to a heap buffer
+        std::string big(std::numeric_limits<double>::max_exponent10 + 4 +
+                        static_cast<size_t>(std::max(precision, 0)), '\0');
+        len = formatDoubleTo(&big[0], big.size(), value, precision);
+        big.resize(len);
+        return big;
+    }
+    return std::string(buf, len);
+}
+
+std::string Utils::progressBar(double value, double maxValue, int width) {
+    std::string bar(static_cast<size_t>(std::max(width, 0)) + 2, '\0');
+    size_t len = progressBarTo(&bar[0], bar.size(), value, maxValue, width);
+    bar.resize(len);
+    return bar;
+}
+
+size_t Utils::formatNumberTo(char* buf, size_t size, int64_t number) {
+    // Print the magnitude as unsigned so INT64_MIN does not overflow
+    uint64_t magnitude = (number < 0) ? 0 - static_cast<uint64_t>(number)
+                                      : static_cast<uint64_t>(number);
+    char digits[20];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), magnitude);
+    if (ec != std::errc()) return 0;
+
+    size_t numDigits = static_cast<size_t>(end - digits);
+    size_t separators = (numDigits - 1) / 3;
+    size_t total = numDigits + separators + (number < 0 ? 1 : 0);
+    if (total > size) return 0;
+
+    // Fill from the back so every byte is written exactly once
+    char* out = buf + total;
+    size_t count = 0;
+    for (size_t i = numDigits; i-- > 0;) {
         if (count > 0 && count % 3 == 0) {
-            result = ',' + result;
+            *--out = ',';
         }
-        result = *it + result;
+        *--out = digits[i];
         ++count;
     }
     if (number < 0) {
-        result = '-' + result;
+        *--out = '-';
     }
-    return result;
+    return total;
 }
 
-std::string Utils::formatDouble(double value, int precision) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(precision) << value;
-    return oss.str();
+size_t Utils::formatDoubleTo(char* buf, size_t size, double value, int precision) {
+    auto [end, ec] = std::to_chars(buf, buf + size, value, std::chars_format::fixed,
+                                   std::max(precision, 0));
+    if (ec != std::errc()) return 0;
+    return static_cast<size_t>(end - buf);
 }
 
-std::string Utils::progressBar(double value, double maxValue, int width) {
+size_t Utils::progressBarTo(char* buf, size_t size, double value, double maxValue, int width) {
+    if (width < 0) width = 0;
+    size_t total = static_cast<size_t>(width) + 2;
+    if (total > size) return 0;
+
     double ratio = (maxValue > 0.0) ? clamp(value / maxValue, 0.0, 1.0) : 0.0;
     int filled = static_cast<int>(std::round(ratio * width));
-    int empty = width - filled;
 
-    std::string bar = "[";
-    for (int i = 0; i < filled; ++i) bar += '#';
-    for (int i = 0; i < empty; ++i) bar += '-';
-    bar += "]";
+    buf[0] = '[';
+    std::memset(buf + 1, '#', static_cast<size_t>(filled));
+    std::memset(buf + 1 + filled, '-', static_cast<size_t>(width - filled));
+    buf[total - 1] = ']';
+    return total;
+}
 
-    return bar;
+size_t Utils::padRightTo(char* buf, size_t size, std::string_view str, size_t width, char fill) {
+    size_t columns = displayWidth(str);
+    size_t padding = (columns < width) ? width - columns : 0;
+    size_t total = str.size() + padding;
+    if (total > size) return 0;
+
+    std::memcpy(buf, str.data(), str.size());
+    std::memset(buf + str.size(), fill, padding);
+    return total;
+}
+
+size_t Utils::padLeftTo(char* buf, size_t size, std::string_view str, size_t width, char fill) {
+    size_t columns = displayWidth(str);
+    size_t padding = (columns < width) ? width - columns : 0;
+    size_t total = str.size() + padding;
+    if (total > size) return 0;
+
+    std::memset(buf, fill, padding);
+    std::memcpy(buf + padding, str.data(), str.size());
+    return total;
+}
+
+size_t Utils::displayWidth(std::string_view str) {
+    // Count every byte that is not a UTF-8 continuation byte (10xxxxxx)
+    size_t columns = 0;
+    for (char c : str) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+            ++columns;
+        }
+    }
+    return columns;
 }
 
 double Utils::clamp(double value, double min, double max) {
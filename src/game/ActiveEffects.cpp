@@ -0,0 +1,143 @@
+#include "game/ActiveEffects.h"
+#include "game/EventSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace civ {
+
+namespace {
+
+EffectShare divideEvent(const GameEvent& event, int turns) {
+    double divisor = static_cast<double>(turns);
+    EffectShare share;
+    share.populationMultiplier = (turns == 1) ? event.populationMultiplier
+                                              : std::pow(event.populationMultiplier, 1.0 / divisor);
+    share.population = event.populationEffect / turns;
+    share.happiness = event.happinessEffect / divisor;
+    share.ecology = event.ecologyEffect / divisor;
+    share.military = event.militaryEffect / divisor;
+    share.resources[static_cast<size_t>(ResourceType::Food)] = event.foodEffect / divisor;
+    share.resources[static_cast<size_t>(ResourceType::Money)] = event.economyEffect / divisor;
+    share.resources[static_cast<size_t>(ResourceType::Energy)] = event.energyEffect / divisor;
+    share.resources[static_cast<size_t>(ResourceType::Materials)] = event.materialsEffect / divisor;
+    if (event.techBoost > 0) {
+        share.techInvestment = static_cast<double>(event.techBoost) * 20.0 /
+                               static_cast<double>(TechBranch::COUNT) / divisor;
+    }
+    return share;
+}
+
+} // namespace
+
+EffectShare EffectShare::initial(const GameEvent& event) {
+    int turns = std::max(1, event.duration);
+    EffectShare share = divideEvent(event, turns);
+    share.population += event.populationEffect % turns;
+    return share;
+}
+
+EffectShare EffectShare::perTurn(const GameEvent& event) {
+    return divideEvent(event, std::max(1, event.duration));
+}
+
+void EffectShare::add(const EffectShare& other) {
+    populationMultiplier *= other.populationMultiplier;
+    population += other.population;
+    happiness += other.happiness;
+    ecology += other.ecology;
+    military += other.military;
+    for (size_t r = 0; r < resources.size(); ++r) {
+        resources[r] += other.resources[r];
+    }
+    techInvestment += other.techInvestment;
+}
+
+void EffectShare::remove(const EffectShare& other) {
+    populationMultiplier /= other.populationMultiplier;
+    population -= other.population;
+    happiness -= other.happiness;
+    ecology -= other.ecology;
+    military -= other.military;
+    for (size_t r = 0; r < resources.size(); ++r) {
+        resources[r] -= other.resources[r];
+    }
+    techInvestment -= other.techInvestment;
+}
+
+ActiveEffects::ActiveEffects(size_t rows)
+    : m_totals(rows)
+    , m_counts(rows, 0)
+{
+}
+
+void ActiveEffects::resize(size_t rows) {
+    m_totals.resize(rows);
+    m_counts.resize(rows, 0);
+}
+
+void ActiveEffects::reserve(size_t rows) {
+    m_totals.reserve(rows);
+    m_counts.reserve(rows);
+}
+
+void ActiveEffects::reserveEffects(size_t count) {
+    m_wheel.reserve(count);
+    m_starting.reserve(count);
+}
+
+void ActiveEffects::clear() {
+    m_wheel.clear();
+    m_starting.clear();
+    for (auto& total : m_totals) total = EffectShare{};
+    for (auto& count : m_counts) count = 0;
+}
+
+void ActiveEffects::activate(size_t row, const EffectShare& share, int turns) {
+    if (turns <= 0) return;
+    m_starting.push_back(Starting{ Entry{ static_cast<uint32_t>(row), share }, turns });
+}
+
+void ActiveEffects::resume(size_t row, const EffectShare& share, int turns) {
+    if (turns <= 0) return;
+    m_totals[row].add(share);
+    m_counts[row]++;
+    m_wheel.schedule(Entry{ static_cast<uint32_t>(row), share }, static_cast<uint64_t>(turns));
+}
+
+void ActiveEffects::advance() {
+    m_wheel.advance([this](const Entry& entry) {
+        EffectShare& total = m_totals[entry.row];
+        if (--m_counts[entry.row] == 0) {
+            // Subtracting shares back out of a running total leaves rounding residue,
+            // so a row's total is reset outright when its last effect ends
+            total = EffectShare{};
+        } else {
+            total.remove(entry.share);
+        }
+    });
+
+    // After the expiries, so a queued effect is added to a row's reset total, not before it
+    for (const Starting& starting : m_starting) {
+        resume(starting.entry.row, starting.entry.share, starting.turns);
+    }
+    m_starting.clear();
+}
+
+size_t ActiveEffects::appendRow(const ActiveEffects& other, size_t row) {
+    size_t newRow = rows();
+    m_totals.push_back(other.m_totals[row]);
+    m_counts.push_back(other.m_counts[row]);
+    other.m_wheel.forEach([&](const Entry& entry, uint64_t turnsLeft) {
+        if (entry.row == row) {
+            m_wheel.schedule(Entry{ static_cast<uint32_t>(newRow), entry.share }, turnsLeft);
+        }
+    });
+    for (const Starting& starting : other.m_starting) {
+        if (starting.entry.row == row) {
+            m_starting.push_back(Starting{ Entry{ static_cast<uint32_t>(newRow), starting.entry.share }, starting.turns });
+        }
+    }
+    return newRow;
+}
+
+} // namespace civ
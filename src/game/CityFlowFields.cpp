@@ -0,0 +1,141 @@
+#include "game/CityFlowFields.h"
+#include "game/CityModel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace civ {
+
+namespace {
+
+// Neighbour offsets in opposite pairs (k ^ 1 is the way back) and their
+// costs, in the order of CityFlowFields::UNIT_X / UNIT_Y
+constexpr int STEP_X[8] = { 1, -1, 0,  0, 1, -1,  1, -1 };
+constexpr int STEP_Y[8] = { 0,  0, 1, -1, 1, -1, -1,  1 };
+constexpr uint16_t STEP_COST[8] = { 5, 5, 5, 5, 7, 7, 7, 7 };
+
+} // namespace
+
+size_t CityFlowFields::townHallTarget() {
+    return CityModel::getBuildingDefs().size();
+}
+
+void CityFlowFields::resize(float width, float height) {
+    m_columns = static_cast<size_t>(std::max(1.0f, std::ceil(width / CELL_SIZE)));
+    m_rows = static_cast<size_t>(std::max(1.0f, std::ceil(height / CELL_SIZE)));
+    m_fields.resize(townHallTarget() + 1);
+    for (Field& field : m_fields) {
+        clearField(field);
+    }
+    refreshTargets();
+}
+
+void CityFlowFields::clearField(Field& field) {
+    field.distance.assign(m_columns * m_rows, UNREACHED);
+    field.step.assign(m_columns * m_rows, NONE);
+    field.sources = 0;
+}
+
+void CityFlowFields::rebuild(const CityModel& city) {
+    for (Field& field : m_fields) {
+        clearField(field);
+    }
+    if (m_columns > 0 && city.isFounded()) {
+        // One pass per field from all of its sources at once
+        for (size_t target = 0; target < m_fields.size(); ++target) {
+            Field& field = m_fields[target];
+            if (target == townHallTarget()) {
+                seed(field, cellOf(city.getCenterX(), city.getCenterY()));
+            }
+            for (const Building& building : city.getBuildings()) {
+                if (building.def == target) seed(field, cellOf(building.x, building.y));
+            }
+            relax(field);
+        }
+    }
+    refreshTargets();
+}
+
+void CityFlowFields::addSource(size_t target, float x, float y) {
+    if (target >= m_fields.size() || m_columns == 0) return;
+    Field& field = m_fields[target];
+    bool wasEmpty = field.sources == 0;
+    seed(field, cellOf(x, y));
+    relax(field);
+    if (wasEmpty) {
+        refreshTargets();
+    }
+}
+
+void CityFlowFields::seed(Field& field, size_t cell) {
+    ++field.sources;
+    if (field.distance[cell] == 0) return;
+    field.distance[cell] = 0;
+    field.step[cell] = NONE;
+    m_buckets[0].push_back(static_cast<uint32_t>(cell));
+}
+
+void CityFlowFields::relax(Field& field) {
+    // Dial's Dijkstra from the seeded cells at distance 0. Every step costs
+    // less than BUCKETS, so the bucket of distance d % BUCKETS holds only
+    // distance d while it is drained. A cell is queued again only when it got
+    // strictly closer, so an added source touches just the cells it now serves.
+    size_t pending = m_buckets[0].size();
+    for (uint32_t dist = 0; pending > 0; ++dist) {
+        std::vector<uint32_t>& bucket = m_buckets[dist % BUCKETS];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            const uint32_t cell = bucket[i];
+            if (field.distance[cell] != dist) continue;   // Superseded entry
+
+            const auto cx = static_cast<long>(cell % m_columns);
+            const auto cy = static_cast<long>(cell / m_columns);
+            for (uint8_t k = 0; k < 8; ++k) {
+                long nx = cx + STEP_X[k];
+                long ny = cy + STEP_Y[k];
+                if (nx < 0 || ny < 0 || nx >= static_cast<long>(m_columns) || ny >= static_cast<long>(m_rows)) continue;
+                uint32_t candidate = dist + STEP_COST[k];
+                if (candidate >= UNREACHED) continue;
+
+                auto neighbour = static_cast<uint32_t>(static_cast<size_t>(ny) * m_columns + static_cast<size_t>(nx));
+                if (candidate < field.distance[neighbour]) {
+                    field.distance[neighbour] = static_cast<uint16_t>(candidate);
+                    field.step[neighbour] = static_cast<uint8_t>(k ^ 1);   // Back toward cell
+                    m_buckets[candidate % BUCKETS].push_back(neighbour);
+                    ++pending;
+                }
+            }
+        }
+        pending -= bucket.size();
+        bucket.clear();
+    }
+}
+
+void CityFlowFields::refreshTargets() {
+    m_homes.clear();
+    m_work.clear();
+    const auto& defs = CityModel::getBuildingDefs();
+    for (size_t target = 0; target < defs.size() && target < m_fields.size(); ++target) {
+        if (m_fields[target].sources == 0) continue;
+        (defs[target].housing > 0 ? m_homes : m_work).push_back(static_cast<uint8_t>(target));
+    }
+}
+
+bool CityFlowFields::hasSources(size_t target) const {
+    return target < m_fields.size() && m_fields[target].sources > 0;
+}
+
+uint16_t CityFlowFields::distance(size_t target, float x, float y) const {
+    if (target >= m_fields.size() || m_columns == 0) return UNREACHED;
+    return m_fields[target].distance[cellOf(x, y)];
+}
+
+uint8_t CityFlowFields::nextTarget(uint8_t current, uint32_t bits) const {
+    const auto& defs = CityModel::getBuildingDefs();
+    const bool atHome = current == NO_TARGET || current >= defs.size() || defs[current].housing > 0;
+    const std::vector<uint8_t>& candidates = atHome ? m_work : m_homes;
+    if (candidates.empty()) {
+        return static_cast<uint8_t>(townHallTarget());
+    }
+    return candidates[(static_cast<uint64_t>(bits) * candidates.size()) >> 32];
+}
+
+} // namespace civ
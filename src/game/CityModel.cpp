@@ -0,0 +1,149 @@
+#include "game/CityModel.h"
+#include "game/ResourceManager.h"
+
+namespace civ {
+
+const std::vector<BuildingDef>& CityModel::getBuildingDefs() {
+    // Name, money cost, materials cost, housing, yield { food, money, energy, materials },
+    // production bonus { food, money, energy, materials }, military, first era, colour
+    static const std::vector<BuildingDef> defs = {
+        { u8"Дом",             0,   50,  50, {  0,  0,   0,   0 }, { 0, 0, 0,    0    }, 0, Era::StoneAge,   0xC89664 },
+        { u8"Ферма",           20,  20,  0,  { 15,  0,   0,   0 }, { 0, 0, 0,    0    }, 0, Era::StoneAge,   0x32C832 },
+        { u8"Рынок",           50,  50,  0,  {  0, 10,   0,   0 }, { 0, 0, 0,    0    }, 0, Era::BronzeAge,  0xC8C832 },
+        { u8"Шахта",           100, 0,   0,  {  0,  0,   0,  10 }, { 0, 0, 0,    0    }, 0, Era::BronzeAge,  0x646464 },
+        { u8"Казарма",         150, 100, 0,  {  0,  0,   0,   0 }, { 0, 0, 0,    0    }, 5, Era::IronAge,    0xC83232 },
+        { u8"Завод",           300, 200, 0,  {  0, 20, -10,  20 }, { 0, 0, 0,    0.10 }, 0, Era::Industrial, 0x787882 },
+        { u8"Эл.станция",      400, 300, 0,  {  0,  0,  30,   0 }, { 0, 0, 0.10, 0    }, 0, Era::Industrial, 0x64C8FF },
+    };
+    return defs;
+}
+
+void CityModel::found(float x, float y) {
+    m_founded = true;
+    m_centerX = x;
+    m_centerY = y;
+    m_buildings.clear();
+    m_grid.clear();
+    clearTotals();
+}
+
+void CityModel::reset() {
+    m_founded = false;
+    m_buildings.clear();
+    m_grid.clear();
+    clearTotals();
+}
+
+void CityModel::clearTotals() {
+    m_totals = CityYield{};
+    if (m_founded) {
+        m_totals.housing = TOWN_HALL_HOUSING;
+    }
+}
+
+bool CityModel::isFree(float x, float y) const {
+    float dx = m_centerX - x;
+    float dy = m_centerY - y;
+    if (dx * dx + dy * dy < MIN_SPACING * MIN_SPACING) return false;
+    return !m_grid.anyCloserThan(x, y, MIN_SPACING);
+}
+
+size_t CityModel::pick(float x, float y, float radius) const {
+    uint32_t id = m_grid.nearest(x, y, radius);
+    return id == SpatialHashGrid::NONE ? NO_BUILDING : id;
+}
+
+PlaceResult CityModel::place(size_t defIndex, float x, float y, Era era, ResourceManager& resources) {
+    if (!m_founded) return PlaceResult::NoCity;
+    const auto& defs = getBuildingDefs();
+    if (defIndex >= defs.size()) return PlaceResult::UnknownBuilding;
+
+    const BuildingDef& def = defs[defIndex];
+    if (era < def.minEra) return PlaceResult::TooEarly;
+    if (resources.getResource(ResourceType::Money) < def.costMoney ||
+        resources.getResource(ResourceType::Materials) < def.costMaterials) {
+        return PlaceResult::NotAffordable;
+    }
+    if (!isFree(x, y)) return PlaceResult::Overlapping;
+
+    resources.removeResource(ResourceType::Money, def.costMoney);
+    resources.removeResource(ResourceType::Materials, def.costMaterials);
+    add(Building{ static_cast<uint16_t>(defIndex), x, y });
+    return PlaceResult::Placed;
+}
+
+void CityModel::add(const Building& building) {
+    const BuildingDef& def = getBuildingDefs()[building.def];
+    m_grid.insert(static_cast<uint32_t>(m_buildings.size()), building.x, building.y);
+    m_buildings.push_back(building);
+    m_totals.housing += def.housing;
+    for (size_t r = 0; r < def.yield.size(); ++r) {
+        m_totals.resources[r] += def.yield[r];
+        m_totals.productionBonus[r] += def.productionBonus[r];
+    }
+    m_totals.military += def.military;
+}
+
+bool CityModel::remove(size_t index) {
+    if (index >= m_buildings.size()) return false;
+
+    const BuildingDef& def = getBuildingDefs()[m_buildings[index].def];
+    const Building& removed = m_buildings[index];
+    m_grid.remove(static_cast<uint32_t>(index), removed.x, removed.y);
+    const size_t last = m_buildings.size() - 1;
+    if (index != last) {
+        const Building& moved = m_buildings[last];
+        m_grid.remove(static_cast<uint32_t>(last), moved.x, moved.y);
+        m_grid.insert(static_cast<uint32_t>(index), moved.x, moved.y);
+        m_buildings[index] = moved;
+    }
+    m_buildings.pop_back();
+    if (m_buildings.empty()) {
+        // Fractional bonuses do not subtract back to zero: an empty city keeps the town hall alone
+        clearTotals();
+        return true;
+    }
+    m_totals.housing -= def.housing;
+    for (size_t r = 0; r < def.yield.size(); ++r) {
+        m_totals.resources[r] -= def.yield[r];
+        m_totals.productionBonus[r] -= def.productionBonus[r];
+    }
+    m_totals.military -= def.military;
+    return true;
+}
+
+void CityModel::serialize(std::ostream& out) const {
+    if (!m_founded) {
+        out << 0 << " ";
+        return;
+    }
+    out << 1 << " " << m_centerX << " " << m_centerY << " " << m_buildings.size() << " ";
+    for (const auto& building : m_buildings) {
+        out << building.def << " " << building.x << " " << building.y << " ";
+    }
+}
+
+void CityModel::deserialize(std::istream& in) {
+    int founded = 0;
+    in >> founded;
+    if (!founded) {
+        reset();
+        return;
+    }
+
+    float x = 0.0f;
+    float y = 0.0f;
+    size_t count = 0;
+    in >> x >> y >> count;
+    found(x, y);
+    const size_t numDefs = getBuildingDefs().size();
+    for (size_t i = 0; i < count && in; ++i) {
+        Building building;
+        in >> building.def >> building.x >> building.y;
+        if (in && building.def < numDefs) {
+            add(building);
+        }
+    }
+}
+
+} // namespace civ
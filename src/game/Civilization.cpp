@@ -1,13 +1,23 @@
 #include "game/Civilization.h"
+#include "game/SimdKernels.h"
 #include "core/Utils.h"
 #include "core/Logger.h"
 #include "core/ColorOutput.h"
+#include "core/Profiler.h"
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 
 namespace civ {
 
+namespace {
+
+// With one event per turn at most (longest duration - 1) effects are pending;
+// reserved up front so applyEvent and processTurn never allocate
+constexpr size_t LINGERING_EFFECT_CAPACITY = 16;
+
+} // namespace
+
 Civilization::Civilization(const std::string& name)
     : m_name(name)
     , m_population(INITIAL_POPULATION)
@@ -17,16 +27,31 @@ Civilization::Civilization(const std::string& name)
     , m_turn(0)
     , m_stableEconomyTurns(0)
 {
+    m_effects.reserveEffects(LINGERING_EFFECT_CAPACITY);
+    updateTechModifiers();
 }
 
 void Civilization::processTurn() {
     m_turn++;
 
-    // Reset resource multipliers before events
-    m_resources.resetMultipliers();
+    // Lingering events tick before the economy; expired ones stop after this turn,
+    // and an event applied this turn starts lingering from the next one
+    if (m_effects.hasActive(0)) {
+        CIV_PROFILE_SCOPE(EventEffects);
+        applyShare(m_effects.total(0));
+    }
+    m_effects.advance();
+
+    // Tech bonuses as of this turn (events and investments may have levelled a branch),
+    // building bonuses as of the city built since the last turn
+    updateTechModifiers();
+    updateBuildingModifiers();
 
     // Process resources
-    m_resources.processTurn(m_population, m_tech.getOverallTechLevel());
+    {
+        CIV_PROFILE_SCOPE(ResourceTurn);
+        m_resources.processTurn(m_population, m_tech.getOverallTechLevel());
+    }
 
     // Population growth
     growPopulation();
@@ -49,42 +74,81 @@ void Civilization::processTurn() {
     m_ecology = Utils::clamp(m_ecology, 0.0, 100.0);
     m_military = std::max(0.0, m_military);
     m_population = std::max(0, m_population);
+
+    // City buildings after the turn's own rules, as the city screen has always applied them
+    if (m_city.isFounded()) {
+        applyCity();
+    }
+}
+
+void Civilization::applyCity() {
+    const CityYield& totals = m_city.getTotals();
+    for (size_t r = 0; r < totals.resources.size(); ++r) {
+        m_resources.addResource(static_cast<ResourceType>(r), totals.resources[r]);
+    }
+    m_military = std::max(0.0, m_military + totals.military);
+    m_population = std::min(m_population, totals.housing);
+}
+
+PlaceResult Civilization::placeBuilding(size_t defIndex, float x, float y) {
+    PlaceResult result = m_city.place(defIndex, x, y, getCurrentEra(), m_resources);
+    if (result == PlaceResult::Placed) {
+        updateBuildingModifiers();
+    }
+    return result;
 }
 
 void Civilization::applyEvent(const GameEvent& event) {
+    CIV_PROFILE_SCOPE(ApplyEvent);
+
+    // The first share now, the rest over the following turns (not this turn's tick)
+    applyShare(EffectShare::initial(event));
+    if (event.duration > 1) {
+        m_effects.activate(0, EffectShare::perTurn(event), event.duration - 1);
+    }
+
+    Logger& logger = Logger::instance();
+    if (logger.isEnabled(LogLevel::Info)) {
+        logger.info("Event applied: " + event.name);
+    }
+}
+
+void Civilization::processQuietYear(const EffectShare& share, const std::string& eventName) {
+    {
+        CIV_PROFILE_SCOPE(ApplyEvent);
+        applyShare(share);
+        Logger& logger = Logger::instance();
+        if (logger.isEnabled(LogLevel::Info)) {
+            logger.info("Event applied: " + eventName);
+        }
+    }
+    processTurn();
+}
+
+void Civilization::applyShare(const EffectShare& share) {
     // Population effects
-    if (event.populationMultiplier != 1.0) {
-        m_population = static_cast<int>(m_population * event.populationMultiplier);
+    if (share.populationMultiplier != 1.0) {
+        m_population = static_cast<int>(m_population * share.populationMultiplier);
     }
-    m_population += event.populationEffect;
+    m_population += share.population;
     m_population = std::max(0, m_population);
 
     // Attribute effects
-    m_happiness += event.happinessEffect;
-    m_ecology += event.ecologyEffect;
-    m_military += event.militaryEffect;
+    m_happiness += share.happiness;
+    m_ecology += share.ecology;
+    m_military += share.military;
 
     // Resource effects
-    if (event.economyEffect != 0.0) {
-        m_resources.addResource(ResourceType::Money, event.economyEffect);
-    }
-    if (event.foodEffect != 0.0) {
-        m_resources.addResource(ResourceType::Food, event.foodEffect);
-    }
-    if (event.energyEffect != 0.0) {
-        m_resources.addResource(ResourceType::Energy, event.energyEffect);
-    }
-    if (event.materialsEffect != 0.0) {
-        m_resources.addResource(ResourceType::Materials, event.materialsEffect);
+    for (size_t r = 0; r < share.resources.size(); ++r) {
+        if (share.resources[r] != 0.0) {
+            m_resources.addResource(static_cast<ResourceType>(r), share.resources[r]);
+        }
     }
 
-    // Tech boost
-    if (event.techBoost > 0) {
-        // Distribute tech boost across all branches
-        double perBranch = static_cast<double>(event.techBoost) * 20.0 /
-                          static_cast<double>(TechBranch::COUNT);
+    // Tech boost, already spread across all branches
+    if (share.techInvestment > 0.0) {
         for (int i = 0; i < static_cast<int>(TechBranch::COUNT); ++i) {
-            m_tech.investInBranch(static_cast<TechBranch>(i), perBranch);
+            m_tech.investInBranch(static_cast<TechBranch>(i), share.techInvestment);
         }
     }
 
@@ -92,8 +156,48 @@ void Civilization::applyEvent(const GameEvent& event) {
     m_happiness = Utils::clamp(m_happiness, 0.0, 100.0);
     m_ecology = Utils::clamp(m_ecology, 0.0, 100.0);
     m_military = std::max(0.0, m_military);
+}
 
-    Logger::instance().info("Event applied: " + event.name);
+void Civilization::updateTechModifiers() {
+    int industryLevel = m_tech.getBranchLevel(TechBranch::Industry);
+    if (industryLevel == m_modifierIndustryLevel) return;
+    m_modifierIndustryLevel = industryLevel;
+
+    ModifierStack& modifiers = m_resources.getModifiers();
+    double bonus = TechnologyTree::productionBonusForLevel(industryLevel);
+    const auto& resources = TechnologyTree::INDUSTRY_BONUS_RESOURCES;
+    for (size_t i = 0; i < resources.size(); ++i) {
+        if (!modifiers.update(m_industryModifiers[i], 0.0, bonus)) {
+            Modifier modifier;
+            modifier.source = ModifierSource::Tech;
+            modifier.target = ModifierTarget::Production;
+            modifier.resource = resources[i];
+            modifier.multiplier = bonus;
+            m_industryModifiers[i] = modifiers.add(modifier);
+        }
+    }
+}
+
+void Civilization::updateBuildingModifiers() {
+    const auto& bonuses = m_city.getTotals().productionBonus;
+    if (bonuses == m_modifierBuildingBonus) return;
+    m_modifierBuildingBonus = bonuses;
+
+    ModifierStack& modifiers = m_resources.getModifiers();
+    for (size_t r = 0; r < bonuses.size(); ++r) {
+        ModifierId& id = m_buildingModifiers[r];
+        if (bonuses[r] == 0.0) {
+            modifiers.remove(id);
+            id = ModifierId{};
+        } else if (!modifiers.update(id, bonuses[r], 1.0)) {
+            Modifier modifier;
+            modifier.source = ModifierSource::Building;
+            modifier.target = ModifierTarget::Production;
+            modifier.resource = static_cast<ResourceType>(r);
+            modifier.additive = bonuses[r];
+            id = modifiers.add(modifier);
+        }
+    }
 }
 
 Era Civilization::getCurrentEra() const {
@@ -127,41 +231,18 @@ bool Civilization::isAlive() const {
 }
 
 void Civilization::growPopulation() {
-    double rate = getGrowthRate();
-    int growth = static_cast<int>(m_population * rate);
-    m_population += growth;
-    m_population = std::max(0, m_population);
-}
-
-double Civilization::getGrowthRate() const {
-    double baseRate = 0.02; // 2% base growth
-
-    // Food availability
+    CIV_PROFILE_SCOPE(GrowPopulation);
+    // Growth rate: 2% base, scaled by food availability, happiness, medicine and
+    // ecology; negative when food or happiness are critically low (see SimdKernels)
     double food = m_resources.getResource(ResourceType::Food);
-    double foodNeeded = m_population * 0.012;
-    double foodRatio = (foodNeeded > 0) ? food / foodNeeded : 1.0;
-    foodRatio = Utils::clamp(foodRatio, 0.0, 2.0);
-
-    // Happiness factor
-    double happinessFactor = m_happiness / 100.0;
-
-    // Medicine bonus
-    double medicineFactor = m_tech.getMedicineBonus();
-
-    // Ecology factor
-    double ecologyFactor = m_ecology / 100.0;
-
-    double rate = baseRate * foodRatio * happinessFactor * medicineFactor * ecologyFactor;
-
-    // Can be negative if conditions are terrible
-    if (foodRatio < 0.5 || m_happiness < 20.0) {
-        rate = std::min(rate, -0.01);
-    }
-
-    return Utils::clamp(rate, -0.05, 0.05);
+    int medicineLevel = m_tech.getBranchLevel(TechBranch::Medicine);
+    GrowthColumns columns{ &m_population, &food, &m_happiness, &m_ecology, &medicineLevel };
+    SimdKernels::growPopulation(columns, 1);
 }
 
 void Civilization::updateEcology() {
+    CIV_PROFILE_SCOPE(UpdateEcology);
+
     // В ранние эпохи (до Индустриальной) экология не падает, так как нет заводов
     if (getCurrentEra() < Era::Industrial) {
         m_ecology += 0.5;
@@ -186,6 +267,8 @@ void Civilization::updateEcology() {
 }
 
 void Civilization::updateHappiness() {
+    CIV_PROFILE_SCOPE(UpdateHappiness);
+
     // Base happiness drift toward 50
     double drift = (50.0 - m_happiness) * 0.02;
 
@@ -229,6 +312,17 @@ std::string Civilization::serialize() const {
     oss << m_name.size() << " " << m_name << " ";
     oss << m_population << " " << m_happiness << " " << m_ecology << " "
         << m_military << " " << m_turn << " " << m_stableEconomyTurns << " ";
+    oss << "FX " << m_effects.size() << " ";
+    m_effects.forEach([&oss](size_t, const EffectShare& share, int turnsLeft) {
+        oss << turnsLeft << " " << share.populationMultiplier << " " << share.population << " "
+            << share.happiness << " " << share.ecology << " " << share.military << " ";
+        for (double amount : share.resources) oss << amount << " ";
+        oss << share.techInvestment << " ";
+    });
+    if (m_city.isFounded()) {
+        oss << "CITY ";
+        m_city.serialize(oss);
+    }
     oss << "RES " << m_resources.serialize() << " ";
     oss << "TECH " << m_tech.serialize() << " ";
     return oss.str();
@@ -246,7 +340,27 @@ void Civilization::deserialize(const std::string& data) {
         >> m_military >> m_turn >> m_stableEconomyTurns;
 
     std::string marker;
-    iss >> marker; // "RES"
+    iss >> marker; // "FX" (absent in older saves) or "RES"
+    m_effects.clear();
+    if (marker == "FX") {
+        size_t count = 0;
+        iss >> count;
+        for (size_t i = 0; i < count; ++i) {
+            int turnsLeft = 0;
+            EffectShare share;
+            iss >> turnsLeft >> share.populationMultiplier >> share.population
+                >> share.happiness >> share.ecology >> share.military;
+            for (double& amount : share.resources) iss >> amount;
+            iss >> share.techInvestment;
+            m_effects.resume(0, share, turnsLeft);
+        }
+        iss >> marker; // "CITY" or "RES"
+    }
+    m_city.reset();
+    if (marker == "CITY") {
+        m_city.deserialize(iss);
+        iss >> marker; // "RES"
+    }
     // Read remaining for resources
     std::string resData;
     std::getline(iss, resData, 'T'); // Read until "TECH"
@@ -256,16 +370,34 @@ void Civilization::deserialize(const std::string& data) {
     std::string techData;
     std::getline(iss, techData);
     m_tech.deserialize(techData);
+    updateTechModifiers();
+    updateBuildingModifiers();
 }
 
 std::string Civilization::getStatusString() const {
+    char population[Utils::NUMBER_BUFFER_SIZE];
+    char happinessBar[32];
+    char happiness[Utils::DOUBLE_BUFFER_SIZE];
+    char ecologyBar[32];
+    char ecology[Utils::DOUBLE_BUFFER_SIZE];
+    char military[Utils::DOUBLE_BUFFER_SIZE];
+
+    auto view = [](const char* buf, size_t len) { return std::string_view(buf, len); };
+
     std::ostringstream oss;
-    oss << u8"  Население:   " << Utils::formatNumber(m_population) << "\n";
-    oss << u8"  Счастье:     " << Utils::progressBar(m_happiness, 100.0, 20)
-        << " " << Utils::formatDouble(m_happiness) << "%\n";
-    oss << u8"  Экология:    " << Utils::progressBar(m_ecology, 100.0, 20)
-        << " " << Utils::formatDouble(m_ecology) << "%\n";
-    oss << u8"  Армия:       " << Utils::formatDouble(m_military) << "\n";
+    oss << u8"  Население:   "
+        << view(population, Utils::formatNumberTo(population, sizeof(population), m_population)) << "\n";
+    oss << u8"  Счастье:     "
+        << view(happinessBar, Utils::progressBarTo(happinessBar, sizeof(happinessBar), m_happiness, 100.0, 20))
+        << " " << view(happiness, Utils::formatDoubleTo(happiness, sizeof(happiness), m_happiness)) << "%\n";
+    oss << u8"  Экология:    "
+        << view(ecologyBar, Utils::progressBarTo(ecologyBar, sizeof(ecologyBar), m_ecology, 100.0, 20))
+        << " " << view(ecology, Utils::formatDoubleTo(ecology, sizeof(ecology), m_ecology)) << "%\n";
+    oss << u8"  Армия:       "
+        << view(military, Utils::formatDoubleTo(military, sizeof(military), m_military)) << "\n";
+    if (!m_effects.empty()) {
+        oss << u8"  Длящиеся события: " << m_effects.size() << "\n";
+    }
     oss << u8"  Стаб. экон.: " << m_stableEconomyTurns << "/"
         << VICTORY_STABLE_ECONOMY_TURNS << u8" ходов\n";
     return oss.str();
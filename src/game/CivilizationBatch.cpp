@@ -0,0 +1,439 @@
+#include "game/CivilizationBatch.h"
+#include "core/BatchRandom.h"
+#include "game/Civilization.h"
+#include "game/EventCatalog.h"
+#include "game/SimdKernels.h"
+#include "game/TechnologyTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace civ {
+
+namespace {
+
+// Overall tech level at which Civilization::updateEcology starts charging for industry
+const int INDUSTRIAL_TECH_LEVEL = [] {
+    int level = 0;
+    while (TechnologyTree::eraForTechLevel(level) < Era::Industrial) ++level;
+    return level;
+}();
+
+// Same expression as Utils::clamp, inlined into the column loops
+inline double clampValue(double value, double min, double max) {
+    return std::max(min, std::min(max, value));
+}
+
+} // namespace
+
+size_t CivilizationBatch::add(const Civilization& civ) {
+    m_population.push_back(civ.getPopulation());
+    m_happiness.push_back(civ.getHappiness());
+    m_ecology.push_back(civ.getEcology());
+    m_military.push_back(civ.getMilitary());
+    m_turn.push_back(civ.getTurn());
+    m_stableEconomyTurns.push_back(civ.getStableEconomyTurns());
+
+    const ResourceManager& resources = civ.getResources();
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        auto type = static_cast<ResourceType>(r);
+        m_resources[r].push_back(resources.getResource(type));
+        m_production[r].push_back(resources.getBaseProduction(type));
+        m_consumption[r].push_back(resources.getConsumption(type));
+        m_productionMultiplier[r].push_back(1.0);
+    }
+
+    const TechnologyTree& tech = civ.getTech();
+    for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+        auto branch = static_cast<TechBranch>(b);
+        m_branchLevels[b].push_back(tech.getBranchLevel(branch));
+        m_branchProgress[b].push_back(tech.getBranchProgress(branch));
+    }
+    m_techLevel.push_back(tech.getOverallTechLevel());
+    m_effects.appendRow(civ.getActiveEffects(), 0);
+
+    const CityModel& city = civ.getCity();
+    const CityYield& totals = city.getTotals();
+    m_housing.push_back(city.isFounded() ? totals.housing : NO_CITY);
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        m_cityYield[r].push_back(totals.resources[r]);
+        m_cityBonus[r].push_back(totals.productionBonus[r]);
+    }
+    m_cityMilitary.push_back(totals.military);
+    if (city.isFounded()) m_cityRows++;
+
+    size_t row = size() - 1;
+    updateProductionMultipliers(row);
+    return row;
+}
+
+void CivilizationBatch::reserve(size_t capacity) {
+    m_population.reserve(capacity);
+    m_happiness.reserve(capacity);
+    m_ecology.reserve(capacity);
+    m_military.reserve(capacity);
+    m_turn.reserve(capacity);
+    m_stableEconomyTurns.reserve(capacity);
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        m_resources[r].reserve(capacity);
+        m_production[r].reserve(capacity);
+        m_consumption[r].reserve(capacity);
+        m_productionMultiplier[r].reserve(capacity);
+    }
+    for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+        m_branchLevels[b].reserve(capacity);
+        m_branchProgress[b].reserve(capacity);
+    }
+    m_techLevel.reserve(capacity);
+    m_effects.reserve(capacity);
+    m_housing.reserve(capacity);
+    for (auto& column : m_cityYield) column.reserve(capacity);
+    for (auto& column : m_cityBonus) column.reserve(capacity);
+    m_cityMilitary.reserve(capacity);
+}
+
+void CivilizationBatch::clear() {
+    m_population.clear();
+    m_happiness.clear();
+    m_ecology.clear();
+    m_military.clear();
+    m_turn.clear();
+    m_stableEconomyTurns.clear();
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        m_resources[r].clear();
+        m_production[r].clear();
+        m_consumption[r].clear();
+        m_productionMultiplier[r].clear();
+    }
+    for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+        m_branchLevels[b].clear();
+        m_branchProgress[b].clear();
+    }
+    m_techLevel.clear();
+    m_effects.resize(0);
+    m_effects.clear();
+    m_housing.clear();
+    for (auto& column : m_cityYield) column.clear();
+    for (auto& column : m_cityBonus) column.clear();
+    m_cityMilitary.clear();
+    m_cityRows = 0;
+}
+
+double CivilizationBatch::getResource(size_t row, ResourceType type) const {
+    return m_resources[static_cast<size_t>(type)][row];
+}
+
+double CivilizationBatch::getProduction(size_t row, ResourceType type) const {
+    return m_production[static_cast<size_t>(type)][row] * m_productionMultiplier[static_cast<size_t>(type)][row];
+}
+
+double CivilizationBatch::getConsumption(size_t row, ResourceType type) const {
+    return m_consumption[static_cast<size_t>(type)][row];
+}
+
+int CivilizationBatch::getBranchLevel(size_t row, TechBranch branch) const {
+    return m_branchLevels[static_cast<size_t>(branch)][row];
+}
+
+double CivilizationBatch::getBranchProgress(size_t row, TechBranch branch) const {
+    return m_branchProgress[static_cast<size_t>(branch)][row];
+}
+
+Era CivilizationBatch::getCurrentEra(size_t row) const {
+    return TechnologyTree::eraForTechLevel(m_techLevel[row]);
+}
+
+GameResult CivilizationBatch::checkGameResult(size_t row) const {
+    // Same order as Civilization::checkGameResult
+    if (m_population[row] <= 0) {
+        return GameResult::DefeatPopulation;
+    }
+    if (m_ecology[row] <= ECOLOGY_COLLAPSE_THRESHOLD) {
+        return GameResult::DefeatEcology;
+    }
+    if (getResource(row, ResourceType::Money) <= ECONOMY_COLLAPSE_THRESHOLD &&
+        getResource(row, ResourceType::Food) <= 0) {
+        return GameResult::DefeatEconomy;
+    }
+    if (getCurrentEra(row) == Era::Space) {
+        return GameResult::VictorySpace;
+    }
+    return GameResult::InProgress;
+}
+
+void CivilizationBatch::applyEvents(const EventCatalog& catalog, const int* eventIds) {
+    const size_t n = size();
+
+    // Population, attributes and resources: one gather per effect, no branches
+    {
+        int* population = m_population.data();
+        double* happiness = m_happiness.data();
+        double* ecology = m_ecology.data();
+        double* military = m_military.data();
+        const double* populationMultiplier = catalog.effectColumn(EventEffect::PopulationMultiplier);
+        const int* populationEffect = catalog.populationEffectColumn();
+        const double* happinessEffect = catalog.effectColumn(EventEffect::Happiness);
+        const double* ecologyEffect = catalog.effectColumn(EventEffect::Ecology);
+        const double* militaryEffect = catalog.effectColumn(EventEffect::Military);
+
+        for (size_t i = 0; i < n; ++i) {
+            int id = eventIds[i];
+            // A multiplier of 1.0 leaves the population unchanged, so it needs no special case
+            int scaled = static_cast<int>(population[i] * populationMultiplier[id]);
+            population[i] = std::max(0, scaled + populationEffect[id]);
+            happiness[i] = clampValue(happiness[i] + happinessEffect[id], 0.0, 100.0);
+            ecology[i] = clampValue(ecology[i] + ecologyEffect[id], 0.0, 100.0);
+            military[i] = std::max(0.0, military[i] + militaryEffect[id]);
+        }
+    }
+
+    static_assert(static_cast<size_t>(EventEffect::Materials) - static_cast<size_t>(EventEffect::Food) + 1 ==
+                  NUM_RESOURCES, "resource effects must follow ResourceType order");
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        double* amount = m_resources[r].data();
+        const double* effect = catalog.effectColumn(
+            static_cast<EventEffect>(static_cast<size_t>(EventEffect::Food) + r));
+        for (size_t i = 0; i < n; ++i) {
+            amount[i] += effect[eventIds[i]];
+        }
+    }
+
+    // Tech boosts are rare and may cross level thresholds: handle them row by row
+    const double* techInvestment = catalog.effectColumn(EventEffect::TechInvestment);
+    for (size_t i = 0; i < n; ++i) {
+        double perBranch = techInvestment[eventIds[i]];
+        if (perBranch <= 0.0) continue;
+
+        int techLevel = 0;
+        for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+            investInBranch(i, b, perBranch);
+            techLevel += m_branchLevels[b][i];
+        }
+        m_techLevel[i] = techLevel;
+    }
+
+    // Events lasting several turns: the remaining shares start on the next turn
+    const int* duration = catalog.durationColumn();
+    for (size_t i = 0; i < n; ++i) {
+        int id = eventIds[i];
+        if (duration[id] > 1) {
+            m_effects.activate(i, catalog.getLingeringShare(id), duration[id] - 1);
+        }
+    }
+}
+
+void CivilizationBatch::applyShare(size_t row, const EffectShare& share) {
+    // Civilization::applyShare
+    int& population = m_population[row];
+    if (share.populationMultiplier != 1.0) {
+        population = static_cast<int>(population * share.populationMultiplier);
+    }
+    population = std::max(0, population + share.population);
+    m_happiness[row] = clampValue(m_happiness[row] + share.happiness, 0.0, 100.0);
+    m_ecology[row] = clampValue(m_ecology[row] + share.ecology, 0.0, 100.0);
+    m_military[row] = std::max(0.0, m_military[row] + share.military);
+
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        m_resources[r][row] += share.resources[r];
+    }
+
+    if (share.techInvestment > 0.0) {
+        int techLevel = 0;
+        for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+            investInBranch(row, b, share.techInvestment);
+            techLevel += m_branchLevels[b][row];
+        }
+        m_techLevel[row] = techLevel;
+    }
+}
+
+void CivilizationBatch::generateEvents(const EventCatalog& catalog, BatchRandom& random, int* eventIds) {
+    const size_t n = size();
+    m_uniforms.resize(2 * n);
+    random.fillUniform(m_uniforms.data(), m_uniforms.size());
+
+    const double* uniforms = m_uniforms.data();
+    const int* techLevel = m_techLevel.data();
+    const int* medicine = m_branchLevels[static_cast<size_t>(TechBranch::Medicine)].data();
+    const double* military = m_military.data();
+    const double* happiness = m_happiness.data();
+    const int quietId = catalog.getQuietYearId();
+    const double quietChance = catalog.getQuietYearChance();
+
+    for (size_t i = 0; i < n; ++i) {
+        Era era = TechnologyTree::eraForTechLevel(techLevel[i]);
+        int bucket = EventSystem::conditionBucket(medicine[i], military[i], happiness[i]);
+        const std::vector<int>& pool = catalog.getEraEvents(era);
+        const AliasTable& table = catalog.getEraTable(era, bucket);
+        double quietRoll = uniforms[2 * i];
+        double pickRoll = uniforms[2 * i + 1];
+        if (quietRoll < quietChance || table.empty()) {
+            eventIds[i] = quietId;
+        } else {
+            eventIds[i] = pool[table.sample(pickRoll)];
+        }
+    }
+}
+
+void CivilizationBatch::investInBranch(size_t row, size_t branch, double amount) {
+    // TechnologyTree::investInBranch / checkLevelUp
+    int& level = m_branchLevels[branch][row];
+    double& progress = m_branchProgress[branch][row];
+    if (level >= TechnologyTree::MAX_BRANCH_LEVEL) return;
+
+    progress += amount;
+    int previousLevel = level;
+    while (level < TechnologyTree::MAX_BRANCH_LEVEL) {
+        double threshold = TechnologyTree::levelUpThreshold(level);
+        if (progress < threshold) break;
+        progress -= threshold;
+        level++;
+    }
+    if (level != previousLevel && branch == static_cast<size_t>(TechBranch::Industry)) {
+        updateProductionMultipliers(row);
+    }
+}
+
+void CivilizationBatch::updateProductionMultipliers(size_t row) {
+    // Civilization's modifier stack: an additive building bonus and a multiplicative tech
+    // bonus per resource, (1 + building) * tech. The city is fixed for the batch's lifetime.
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        m_productionMultiplier[r][row] = 1.0 + m_cityBonus[r][row];
+    }
+    double bonus = TechnologyTree::productionBonusForLevel(
+        m_branchLevels[static_cast<size_t>(TechBranch::Industry)][row]);
+    for (ResourceType type : TechnologyTree::INDUSTRY_BONUS_RESOURCES) {
+        m_productionMultiplier[static_cast<size_t>(type)][row] *= bonus;
+    }
+}
+
+void CivilizationBatch::processTurn() {
+    int* turn = m_turn.data();
+    const size_t n = size();
+    for (size_t i = 0; i < n; ++i) {
+        turn[i]++;
+    }
+
+    tickEffects();
+
+    // Production carries the tech and building modifiers; no consumption multiplier is applied
+    updateResources();
+    growPopulation();
+    updateEcology();
+    updateHappiness();
+    updateStability();
+    applyCities();
+}
+
+void CivilizationBatch::tickEffects() {
+    // Rows without lingering events are skipped; with none at all the wheel only advances
+    if (!m_effects.empty()) {
+        const size_t n = size();
+        for (size_t i = 0; i < n; ++i) {
+            if (m_effects.hasActive(i)) {
+                applyShare(i, m_effects.total(i));
+            }
+        }
+    }
+    m_effects.advance();
+}
+
+void CivilizationBatch::updateResources() {
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        ResourceColumns columns{
+            m_population.data(), m_techLevel.data(),
+            m_resources[r].data(), m_production[r].data(), m_consumption[r].data(),
+            m_productionMultiplier[r].data(),
+            ResourceManager::PRODUCTION_RATE[r], ResourceManager::CONSUMPTION_RATE[r] };
+        SimdKernels::updateResources(columns, size());
+    }
+}
+
+void CivilizationBatch::growPopulation() {
+    GrowthColumns columns{
+        m_population.data(),
+        m_resources[static_cast<size_t>(ResourceType::Food)].data(),
+        m_happiness.data(), m_ecology.data(),
+        m_branchLevels[static_cast<size_t>(TechBranch::Medicine)].data() };
+    SimdKernels::growPopulation(columns, size());
+}
+
+void CivilizationBatch::updateEcology() {
+    double* ecology = m_ecology.data();
+    const int* population = m_population.data();
+    const int* techLevel = m_techLevel.data();
+    const int* industry = m_branchLevels[static_cast<size_t>(TechBranch::Industry)].data();
+    const int* science = m_branchLevels[static_cast<size_t>(TechBranch::Science)].data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i) {
+        double ecologyChange = 0.5;
+        // No industrial damage before the Industrial era
+        if (techLevel[i] >= INDUSTRIAL_TECH_LEVEL) {
+            double industrialDamage = industry[i] * 0.10;
+            double scienceHelp = science[i] * 0.15;
+            double popPressure = std::log10(std::max(1, population[i])) * 0.15;
+            ecologyChange = scienceHelp - industrialDamage - popPressure + 0.5;
+        }
+        ecology[i] = clampValue(ecology[i] + ecologyChange, 0.0, 100.0);
+    }
+}
+
+void CivilizationBatch::updateHappiness() {
+    double* happiness = m_happiness.data();
+    const double* ecology = m_ecology.data();
+    const double* foodProd = m_production[static_cast<size_t>(ResourceType::Food)].data();
+    const double* foodMult = m_productionMultiplier[static_cast<size_t>(ResourceType::Food)].data();
+    const double* foodCons = m_consumption[static_cast<size_t>(ResourceType::Food)].data();
+    const double* moneyProd = m_production[static_cast<size_t>(ResourceType::Money)].data();
+    const double* moneyMult = m_productionMultiplier[static_cast<size_t>(ResourceType::Money)].data();
+    const double* moneyCons = m_consumption[static_cast<size_t>(ResourceType::Money)].data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i) {
+        double drift = (50.0 - happiness[i]) * 0.02;
+        double foodHappiness = clampValue((foodProd[i] * foodMult[i] - foodCons[i]) * 0.05, -5.0, 5.0);
+        double moneyHappiness = clampValue((moneyProd[i] * moneyMult[i] - moneyCons[i]) * 0.03, -3.0, 3.0);
+        double ecoHappiness = (ecology[i] - 50.0) * 0.02;
+
+        happiness[i] += drift + foodHappiness + moneyHappiness + ecoHappiness;
+        happiness[i] = clampValue(happiness[i], 0.0, 100.0);
+    }
+}
+
+void CivilizationBatch::updateStability() {
+    int* stableTurns = m_stableEconomyTurns.data();
+    double* military = m_military.data();
+    const double* money = m_resources[static_cast<size_t>(ResourceType::Money)].data();
+    const double* food = m_resources[static_cast<size_t>(ResourceType::Food)].data();
+    const double* happiness = m_happiness.data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i) {
+        bool stable = (money[i] > 0) & (food[i] > 0) & (happiness[i] > 50.0);
+        stableTurns[i] = stable ? stableTurns[i] + 1 : std::max(0, stableTurns[i] - 1);
+        // Happiness, ecology and population are already in range after their phases
+        military[i] = std::max(0.0, military[i]);
+    }
+}
+
+void CivilizationBatch::applyCities() {
+    // Civilization::applyCity; ensembles without cities skip the pass
+    if (m_cityRows == 0) return;
+
+    int* population = m_population.data();
+    double* military = m_military.data();
+    const int* housing = m_housing.data();
+    const double* cityMilitary = m_cityMilitary.data();
+    const size_t n = size();
+
+    for (size_t i = 0; i < n; ++i) {
+        if (housing[i] == NO_CITY) continue;
+        for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+            m_resources[r][i] += m_cityYield[r][i];
+        }
+        military[i] = std::max(0.0, military[i] + cityMilitary[i]);
+        population[i] = std::min(population[i], housing[i]);
+    }
+}
+
+} // namespace civ
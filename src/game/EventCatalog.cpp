@@ -0,0 +1,51 @@
+#include "game/EventCatalog.h"
+#include <algorithm>
+
+namespace civ {
+
+int EventCatalog::add(const GameEvent& event) {
+    auto column = [this](EventEffect effect) -> std::vector<double>& {
+        return m_effects[static_cast<size_t>(effect)];
+    };
+
+    EffectShare first = EffectShare::initial(event);
+    column(EventEffect::PopulationMultiplier).push_back(first.populationMultiplier);
+    column(EventEffect::Happiness).push_back(first.happiness);
+    column(EventEffect::Ecology).push_back(first.ecology);
+    column(EventEffect::Military).push_back(first.military);
+    column(EventEffect::Food).push_back(first.resources[static_cast<size_t>(ResourceType::Food)]);
+    column(EventEffect::Money).push_back(first.resources[static_cast<size_t>(ResourceType::Money)]);
+    column(EventEffect::Energy).push_back(first.resources[static_cast<size_t>(ResourceType::Energy)]);
+    column(EventEffect::Materials).push_back(first.resources[static_cast<size_t>(ResourceType::Materials)]);
+    column(EventEffect::TechInvestment).push_back(first.techInvestment);
+    m_populationEffect.push_back(first.population);
+
+    m_duration.push_back(std::max(1, event.duration));
+    m_lingeringShares.push_back(EffectShare::perTurn(event));
+    m_events.push_back(event);
+    return static_cast<int>(m_events.size() - 1);
+}
+
+void EventCatalog::addToEra(Era era, int id) {
+    m_eraEvents[static_cast<size_t>(era)].push_back(id);
+}
+
+void EventCatalog::setEraTable(Era era, int bucket, const AliasTable& table) {
+    m_eraTables[static_cast<size_t>(era)][static_cast<size_t>(bucket)] = table;
+}
+
+void EventCatalog::setQuietYear(int id, double chance) {
+    m_quietYearId = id;
+    m_quietYearChance = chance;
+}
+
+int EventCatalog::findByName(std::string_view name) const {
+    for (size_t i = 0; i < m_events.size(); ++i) {
+        if (m_events[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace civ
@@ -1,4 +1,6 @@
 #include "game/EventSystem.h"
+#include "game/EventCatalog.h"
+#include "game/Civilization.h"
 #include "core/Utils.h"
 #include "core/Logger.h"
 #include <sstream>
@@ -18,6 +20,7 @@ void EventSystem::init(Difficulty difficulty) {
 
 void EventSystem::setDifficulty(Difficulty difficulty) {
     m_difficulty = difficulty;
+    buildEventPool();
 }
 
 double EventSystem::getDifficultyMultiplier() const {
@@ -31,8 +34,60 @@ double EventSystem::getDifficultyMultiplier() const {
 }
 
 void EventSystem::buildEventPool() {
-    // Пул событий теперь генерируется динамически в getEventsForEra
-    m_eventPool.clear();
+    // Пулы эпох строятся один раз на сложность, а не на каждый ход
+    for (size_t e = 0; e < m_eraPools.size(); ++e) {
+        auto& pool = m_eraPools[e];
+        pool.clear();
+        for (const auto& event : getEventsForEra(static_cast<Era>(e))) {
+            pool.push_back(scaleForDifficulty(event));
+        }
+        buildEraTables(e);
+    }
+}
+
+void EventSystem::buildEraTables(size_t era) {
+    std::vector<double> weights;
+    for (int bucket = 0; bucket < CONDITION_BUCKETS; ++bucket) {
+        weights.clear();
+        for (const auto& event : m_eraPools[era]) {
+            weights.push_back(eventWeight(event, bucket));
+        }
+        m_eraTables[era][static_cast<size_t>(bucket)].build(weights);
+    }
+}
+
+void EventSystem::setEraEvents(Era era, const std::vector<GameEvent>& events) {
+    auto& pool = m_eraPools[static_cast<size_t>(era)];
+    pool.clear();
+    for (const auto& event : events) {
+        pool.push_back(scaleForDifficulty(event));
+    }
+    buildEraTables(static_cast<size_t>(era));
+}
+
+int EventSystem::conditionBucket(int medicineLevel, double military, double happiness) {
+    int medicineBand = (medicineLevel < 3) ? 0 : (medicineLevel < 8) ? 1 : 2;
+    int militaryBand = (military < 5.0) ? 0 : (military < 30.0) ? 1 : 2;
+    int happinessBand = (happiness < 30.0) ? 0 : (happiness < 70.0) ? 1 : 2;
+    return (medicineBand * CONDITION_BANDS + militaryBand) * CONDITION_BANDS + happinessBand;
+}
+
+double EventSystem::eventWeight(const GameEvent& event, int bucket) {
+    // Multipliers for the low / normal / high band
+    static constexpr double EPIDEMIC_BY_MEDICINE[CONDITION_BANDS]  = { 2.5, 1.0, 0.4 };
+    static constexpr double WAR_BY_MILITARY[CONDITION_BANDS]       = { 2.0, 1.0, 0.5 };
+    static constexpr double REVOLUTION_BY_HAPPINESS[CONDITION_BANDS] = { 2.0, 1.0, 0.5 };
+
+    int happinessBand = bucket % CONDITION_BANDS;
+    int militaryBand = (bucket / CONDITION_BANDS) % CONDITION_BANDS;
+    int medicineBand = bucket / (CONDITION_BANDS * CONDITION_BANDS);
+
+    switch (event.type) {
+        case EventType::Epidemic:   return EPIDEMIC_BY_MEDICINE[medicineBand];
+        case EventType::War:        return WAR_BY_MILITARY[militaryBand];
+        case EventType::Revolution: return REVOLUTION_BY_HAPPINESS[happinessBand];
+        default:                    return 1.0;
+    }
 }
 
 std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
@@ -69,6 +124,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
         e.foodEffect = -80.0;
         e.happinessEffect = -10.0;
         e.ecologyEffect = -3.0;
+        e.duration = 3;
         pool.push_back(e);
     }
     {
@@ -112,6 +168,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.militaryEffect = -5.0;
             e.happinessEffect = -5.0;
             e.economyEffect = -10.0;
+            e.duration = 3;
             pool.push_back(e);
         }
     }
@@ -126,6 +183,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.populationMultiplier = 0.85;
             e.happinessEffect = -20.0;
             e.economyEffect = -50.0;
+            e.duration = 4;
             pool.push_back(e);
         }
         {
@@ -146,6 +204,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.populationMultiplier = 0.95;
             e.happinessEffect = -15.0;
             e.economyEffect = -40.0;
+            e.duration = 2;
             pool.push_back(e);
         }
     }
@@ -160,6 +219,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.economyEffect = 100.0;
             e.materialsEffect = 50.0;
             e.ecologyEffect = -10.0;
+            e.duration = 3;
             pool.push_back(e);
         }
         {
@@ -170,6 +230,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.economyEffect = -80.0;
             e.materialsEffect = -40.0;
             e.happinessEffect = -10.0;
+            e.duration = 2;
             pool.push_back(e);
         }
         {
@@ -188,6 +249,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.type = EventType::EconomicCrisis;
             e.economyEffect = -200.0;
             e.happinessEffect = -20.0;
+            e.duration = 4;
             pool.push_back(e);
         }
     }
@@ -220,6 +282,7 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
             e.type = EventType::GoldenAge;
             e.materialsEffect = 200.0;
             e.economyEffect = 100.0;
+            e.duration = 3;
             pool.push_back(e);
         }
     }
@@ -227,9 +290,32 @@ std::vector<GameEvent> EventSystem::getEventsForEra(Era era) const {
     return pool;
 }
 
+GameEvent EventSystem::generateEvent(const Civilization& civ) const {
+    int bucket = conditionBucket(civ.getTech().getBranchLevel(TechBranch::Medicine),
+                                 civ.getMilitary(), civ.getHappiness());
+    return sampleEvent(civ.getCurrentEra(), bucket);
+}
+
+bool EventSystem::hasEvents(Era era) const {
+    return !m_eraTables[static_cast<size_t>(era)][0].empty();
+}
+
+bool EventSystem::rollQuietYear() const {
+    return Utils::randomChance(getQuietYearChance());
+}
+
+GameEvent EventSystem::pickEvent(const Civilization& civ) const {
+    int bucket = conditionBucket(civ.getTech().getBranchLevel(TechBranch::Medicine),
+                                 civ.getMilitary(), civ.getHappiness());
+    return pickFromTable(civ.getCurrentEra(), bucket);
+}
+
 GameEvent EventSystem::generateEvent(Era currentEra, int /*turn*/) const {
-    auto pool = getEventsForEra(currentEra);
-    if (pool.empty()) {
+    return sampleEvent(currentEra, NEUTRAL_BUCKET);
+}
+
+GameEvent EventSystem::sampleEvent(Era era, int bucket) const {
+    if (!hasEvents(era)) {
         GameEvent fallback;
         fallback.name = u8"Тихий год";
         fallback.description = u8"Ничего значительного не произошло.";
@@ -237,23 +323,37 @@ GameEvent EventSystem::generateEvent(Era currentEra, int /*turn*/) const {
         return fallback;
     }
 
-    double diffMult = getDifficultyMultiplier();
-
     // 30% шанс мирного года
-    double noEventChance = 0.30 / diffMult;
-    if (Utils::randomChance(noEventChance)) {
-        GameEvent quiet;
-        quiet.name = u8"Мирный год";
-        quiet.description = u8"Спокойный и безмятежный год прошёл.";
-        quiet.type = EventType::GoldenAge;
-        quiet.happinessEffect = 2.0;
-        quiet.foodEffect = 10.0;
-        return quiet;
+    if (rollQuietYear()) {
+        return m_quietYear;
     }
+    return pickFromTable(era, bucket);
+}
+
+GameEvent EventSystem::pickFromTable(Era era, int bucket) const {
+    const auto& pool = m_eraPools[static_cast<size_t>(era)];
+    const AliasTable& table = m_eraTables[static_cast<size_t>(era)][static_cast<size_t>(bucket)];
+
+    // Взвешенный выбор события (O(1) по таблице псевдонимов)
+    return pool[table.sample(Utils::randomDouble(0.0, 1.0))];
+}
+
+double EventSystem::getQuietYearChance() const {
+    return 0.30 / getDifficultyMultiplier();
+}
 
-    // Выбор случайного события
-    int idx = Utils::randomInt(0, static_cast<int>(pool.size()) - 1);
-    GameEvent event = pool[idx];
+GameEvent EventSystem::makeQuietYear() {
+    GameEvent quiet;
+    quiet.name = u8"Мирный год";
+    quiet.description = u8"Спокойный и безмятежный год прошёл.";
+    quiet.type = EventType::GoldenAge;
+    quiet.happinessEffect = 2.0;
+    quiet.foodEffect = 10.0;
+    return quiet;
+}
+
+GameEvent EventSystem::scaleForDifficulty(GameEvent event) const {
+    double diffMult = getDifficultyMultiplier();
 
     // Масштабирование негативных эффектов по сложности
     if (event.populationMultiplier < 1.0) {
@@ -281,10 +381,32 @@ GameEvent EventSystem::generateEvent(Era currentEra, int /*turn*/) const {
     return event;
 }
 
+EventCatalog EventSystem::buildCatalog() const {
+    EventCatalog catalog;
+    catalog.setQuietYear(catalog.add(makeQuietYear()), getQuietYearChance());
+
+    for (size_t e = 0; e < m_eraPools.size(); ++e) {
+        auto era = static_cast<Era>(e);
+        for (const auto& event : m_eraPools[e]) {
+            // One entry per era slot: universal events keep their era's text
+            // (e.g. the harvest description changes with the era)
+            catalog.addToEra(era, catalog.add(event));
+        }
+        for (int bucket = 0; bucket < CONDITION_BUCKETS; ++bucket) {
+            catalog.setEraTable(era, bucket, m_eraTables[e][static_cast<size_t>(bucket)]);
+        }
+    }
+    return catalog;
+}
+
 void EventSystem::recordEvent(const GameEvent& event) {
     m_eventHistory.push_back(event);
 }
 
+void EventSystem::recordEvent(const GameEvent& event, size_t count) {
+    m_eventHistory.insert(m_eventHistory.end(), count, event);
+}
+
 const std::vector<GameEvent>& EventSystem::getEventHistory() const {
     return m_eventHistory;
 }
@@ -305,6 +427,7 @@ void EventSystem::deserialize(const std::string& data) {
     int diff;
     iss >> diff;
     m_difficulty = static_cast<Difficulty>(diff);
+    buildEventPool();
 
     size_t histSize;
     iss >> histSize;
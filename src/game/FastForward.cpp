@@ -0,0 +1,10 @@
+#include "game/FastForward.h"
+
+namespace civ {
+
+FastForwardResult FastForward::skipQuietTurns(Civilization& civ, EventSystem& events,
+                                              int maxTurns, bool recordHistory) {
+    return skipQuietTurns(civ, events, maxTurns, recordHistory, [](Civilization&) {});
+}
+
+} // namespace civ
@@ -1,7 +1,10 @@
 #include "game/GameEngine.h"
+#include "game/TurnAdvance.h"
+#include "ui/ScriptRunner.h"
 #include "core/Logger.h"
 #include "core/ColorOutput.h"
 #include "core/Utils.h"
+#include "core/Profiler.h"
 #include <iostream>
 #include <stdexcept>
 
@@ -15,9 +18,13 @@ void GameEngine::initSystems() {
     m_events = std::make_unique<EventSystem>();
     m_saveSystem = std::make_unique<SaveSystem>();
     m_display = std::make_unique<Display>();
+    m_simulation = std::make_unique<SimulationThread>();
+    InputHandler::setIdleHandler([this] { collectPredictions(); });
 }
 
 void GameEngine::cleanup() {
+    InputHandler::setIdleHandler(nullptr);
+    m_simulation.reset();
     m_civ.reset();
     m_events.reset();
     m_saveSystem.reset();
@@ -32,13 +39,28 @@ void GameEngine::run() {
 
         initSystems();
         m_running = true;
+#ifdef INTSIM_PROFILING
+        std::string tracePath = Tracer::instance().startFromEnvironment();
+#endif
 
-        while (m_running) {
-            showMainMenu();
+        try {
+            while (m_running) {
+                showMainMenu();
+            }
+        }
+        catch (const InputClosedError&) {
+            Logger::instance().info("Input closed, exiting");
         }
 
         Logger::instance().info("=== Civilization Simulator Ended ===");
         Logger::instance().shutdown();
+        CIV_PROFILE_DUMP("civsim_profile.txt");
+#ifdef INTSIM_PROFILING
+        if (!tracePath.empty()) {
+            Tracer::instance().stop();
+            Tracer::instance().writeJson(tracePath);
+        }
+#endif
     }
     catch (const std::exception& e) {
         Logger::instance().critical(std::string("Fatal error: ") + e.what());
@@ -46,6 +68,20 @@ void GameEngine::run() {
     }
 }
 
+int GameEngine::runScript(std::istream& script, std::ostream& report) {
+    Logger::instance().init("civsim.log", LogLevel::Debug);
+    Logger::instance().info("=== Civilization Simulator Script Started ===");
+
+    initSystems();
+    ScriptRunner runner(*this);
+    int exitCode = runner.run(script, report);
+
+    Logger::instance().info("=== Civilization Simulator Script Ended ===");
+    Logger::instance().shutdown();
+    CIV_PROFILE_DUMP("civsim_profile.txt");
+    return exitCode;
+}
+
 void GameEngine::showMainMenu() {
     m_display->showTitle();
     m_display->showMainMenu();
@@ -81,13 +117,7 @@ void GameEngine::startNewGame() {
     std::string name = InputHandler::getString(u8"Введите название цивилизации");
     if (name.empty()) name = u8"Человечество";
 
-    m_civ = std::make_unique<Civilization>(name);
-    m_events = std::make_unique<EventSystem>();
-    m_events->init(m_difficulty);
-    m_result = GameResult::InProgress;
-
-    Logger::instance().info("New game started: " + name +
-                           " (Difficulty: " + difficultyToString(m_difficulty) + ")");
+    newGame(m_difficulty, name);
 
     m_display->clearScreen();
     std::cout << ColorOutput::bold(ColorOutput::cyan(
@@ -107,13 +137,8 @@ void GameEngine::loadGame() {
         return;
     }
 
-    m_civ = std::make_unique<Civilization>();
-    m_events = std::make_unique<EventSystem>();
-
-    if (m_saveSystem->loadGame(*m_civ, *m_events, m_difficulty)) {
-        m_result = GameResult::InProgress;
+    if (loadSavedGame()) {
         std::cout << "\n  " << ColorOutput::success(u8"Игра успешно загружена!") << "\n";
-        Logger::instance().info("Game loaded from save file");
         InputHandler::waitForKey();
         gameLoop();
     } else {
@@ -122,13 +147,133 @@ void GameEngine::loadGame() {
     }
 }
 
+void GameEngine::newGame(Difficulty difficulty, const std::string& name) {
+    m_difficulty = difficulty;
+    m_civ = std::make_unique<Civilization>(name);
+    m_events = std::make_unique<EventSystem>();
+    m_events->init(m_difficulty);
+    m_orders = StandingOrders{};
+    m_display->resetView();
+    m_stateVersion++;
+    m_result = GameResult::InProgress;
+
+    Logger::instance().info("New game started: " + name +
+                           " (Difficulty: " + difficultyToString(m_difficulty) + ")");
+}
+
+bool GameEngine::loadSavedGame(const std::string& filename) {
+    m_civ = std::make_unique<Civilization>();
+    m_events = std::make_unique<EventSystem>();
+    m_orders = StandingOrders{};
+    m_display->resetView();
+    m_stateVersion++;
+    m_result = GameResult::InProgress;
+
+    if (!m_saveSystem->loadGame(*m_civ, *m_events, m_difficulty, filename)) {
+        return false;
+    }
+    Logger::instance().info("Game loaded from save file");
+    return true;
+}
+
+bool GameEngine::saveCurrentGame(const std::string& filename) {
+    return m_saveSystem->saveGame(*m_civ, *m_events, m_difficulty, filename);
+}
+
+const std::string& GameEngine::getLastSaveError() const {
+    return m_saveSystem->getLastError();
+}
+
+GameEvent GameEngine::playTurn() {
+    CIV_TRACE_TURN(m_civ->getTurn() + 1);
+    CIV_PROFILE_SCOPE(Turn);
+    Logger::instance().info("=== Turn " + std::to_string(m_civ->getTurn() + 1) + " ===");
+
+    GameEvent event;
+    collectPredictions();
+    if (m_hasPrediction && m_prediction.version == m_stateVersion) {
+        // Played ahead from this very state: adopting it is the same as playing the turn now
+        event = std::move(m_prediction.event);
+        m_events->recordEvent(event);
+        *m_civ = std::move(m_prediction.civ);
+        Utils::setRandomState(m_prediction.random);
+        m_hasPrediction = false;
+        Logger::instance().info("Event applied: " + event.name + " (played ahead)");
+    } else {
+        {
+            CIV_PROFILE_SCOPE(GenerateEvent);
+            event = m_events->generateEvent(*m_civ);
+        }
+        m_events->recordEvent(event);
+
+        m_civ->applyEvent(event);
+        m_civ->processTurn();
+    }
+    if (!m_orders.empty()) {
+        OrdersReport orders;
+        m_orders.execute(*m_civ, orders);
+        for (const auto& name : orders.researched) {
+            Logger::instance().info("Researched technology (standing order): " + name);
+        }
+    }
+    m_stateVersion++;
+    checkEndConditions();
+
+    Logger::instance().info("Turn processed. Pop: " + std::to_string(m_civ->getPopulation()) +
+                           " Tech: " + std::to_string(m_civ->getTech().getOverallTechLevel()));
+    return event;
+}
+
+bool GameEngine::invest(TechBranch branch, double amount) {
+    if (amount <= 0 || amount > m_civ->getResources().getResource(ResourceType::Money)) {
+        return false;
+    }
+    m_civ->getResources().removeResource(ResourceType::Money, amount);
+    m_civ->getTech().investInBranch(branch, amount);
+    m_stateVersion++;
+    Logger::instance().info("Invested " + Utils::formatDouble(amount) +
+                           " in " + techBranchToString(branch));
+    return true;
+}
+
+bool GameEngine::research(const std::string& techName) {
+    const TechnologyTree& tree = m_civ->getTech();
+    const Technology* tech = nullptr;
+    for (TechId id : tree.getAvailableIds()) {
+        if (tree.getTechnology(id).name == techName) tech = &tree.getTechnology(id);
+    }
+    if (!tech || m_civ->getResources().getResource(ResourceType::Money) < tech->cost) {
+        return false;
+    }
+
+    m_civ->getResources().removeResource(ResourceType::Money, tech->cost);
+    m_stateVersion++;
+    if (!m_civ->getTech().researchTech(techName)) return false;
+    Logger::instance().info("Researched technology: " + techName);
+    return true;
+}
+
+TurnSummary GameEngine::advanceTurns(int turns) {
+    TurnSummary summary = TurnAdvance::run(*m_civ, *m_events, m_orders, turns);
+    m_stateVersion++;
+    checkEndConditions();
+
+    Logger::instance().info("Advanced " + std::to_string(summary.turnsPlayed) + " turns to turn " +
+                           std::to_string(m_civ->getTurn()) + ": " +
+                           std::to_string(summary.events.size()) + " events, " +
+                           std::to_string(summary.orders.researched.size()) + " techs researched. Pop: " +
+                           std::to_string(m_civ->getPopulation()));
+    return summary;
+}
+
 void GameEngine::gameLoop() {
     static constexpr auto QUIT_SENTINEL = static_cast<GameResult>(255);
     Era previousEra = m_civ->getCurrentEra();
 
     while (m_result == GameResult::InProgress) {
+        speculateNextTurn();
         m_display->clearScreen();
-        m_display->showGameStatus(*m_civ);
+        m_display->showGameStatus(*m_civ, *m_events);
 
         Era currentEra = m_civ->getCurrentEra();
         if (currentEra != previousEra) {
@@ -156,41 +301,51 @@ void GameEngine::gameLoop() {
 void GameEngine::handlePlayerAction() {
     m_display->showTurnMenu(*m_civ);
 
-    int choice = InputHandler::getInt(u8"Действие", 1, 9);
+    int choice = InputHandler::getInt(u8"Действие", 1, 11);
 
     switch (choice) {
         case 1:
             processTurn();
             break;
         case 2:
-            handleInvestment();
+            handleAdvanceTurns();
             break;
         case 3:
-            handleTechResearch();
+            handleStandingOrders();
             break;
         case 4:
+            handleInvestment();
+            break;
+        case 5:
+            handleTechResearch();
+            break;
+        case 6:
             m_display->clearScreen();
-            m_display->showGameStatus(*m_civ);
+            m_display->showGameStatus(*m_civ, *m_events);
+            collectPredictions();
+            if (m_hasPrediction && m_prediction.version == m_stateVersion) {
+                m_display->showForecast(*m_civ, m_prediction.forecast);
+            }
             InputHandler::waitForKey();
             break;
-        case 5:
+        case 7:
             m_display->clearScreen();
             m_display->showTechTree(*m_civ);
             InputHandler::waitForKey();
             break;
-        case 6:
+        case 8:
             m_display->clearScreen();
             m_display->showEventLog(*m_events);
             InputHandler::waitForKey();
             break;
-        case 7:
+        case 9:
             handleSaveGame();
             break;
-        case 8:
+        case 10:
             m_display->showHelp();
             InputHandler::waitForKey();
             break;
-        case 9:
+        case 11:
             if (InputHandler::getYesNo(u8"Сохранить перед выходом?")) {
                 handleSaveGame();
             }
@@ -200,22 +355,77 @@ void GameEngine::handlePlayerAction() {
 }
 
 void GameEngine::processTurn() {
-    Logger::instance().info("=== Turn " + std::to_string(m_civ->getTurn() + 1) + " ===");
+    GameEvent event = playTurn();
 
-    GameEvent event = m_events->generateEvent(m_civ->getCurrentEra(), m_civ->getTurn());
-    m_events->recordEvent(event);
+    {
+        CIV_PROFILE_SCOPE(Rendering);
+        m_display->showEvent(event);
+    }
 
-    m_display->showEvent(event);
+    InputHandler::waitForKey();
+}
 
-    m_civ->applyEvent(event);
-    m_civ->processTurn();
+void GameEngine::speculateNextTurn() {
+    if (m_speculatedVersion == m_stateVersion) return;
+    m_hasPrediction = false;
+    m_simulation->speculate(m_stateVersion, *m_civ, *m_events);
+    m_speculatedVersion = m_stateVersion;
+}
 
-    Logger::instance().info("Turn processed. Pop: " + std::to_string(m_civ->getPopulation()) +
-                           " Tech: " + std::to_string(m_civ->getTech().getOverallTechLevel()));
+void GameEngine::collectPredictions() {
+    TurnPrediction prediction;
+    while (m_simulation->poll(prediction)) {
+        if (prediction.version == m_stateVersion) {
+            m_prediction = std::move(prediction);
+            m_hasPrediction = true;
+        }
+    }
+}
+
+void GameEngine::handleAdvanceTurns() {
+    int turns = InputHandler::getInt(u8"Сколько ходов пропустить", 1, MAX_ADVANCE_TURNS);
+
+    TurnSummary summary = advanceTurns(turns);
+
+    {
+        CIV_PROFILE_SCOPE(Rendering);
+        m_display->clearScreen();
+        m_display->showTurnSummary(summary);
+    }
 
     InputHandler::waitForKey();
 }
 
+void GameEngine::handleStandingOrders() {
+    while (true) {
+        m_display->clearScreen();
+        m_display->showStandingOrders(m_orders);
+
+        int choice = InputHandler::getInt(u8"Выбор", 0, 3);
+        switch (choice) {
+            case 0:
+                return;
+            case 1: {
+                m_display->showInvestmentMenu(*m_civ);
+                int branch = InputHandler::getInt(u8"Выберите ветку (0 - отмена)", 0,
+                                                  static_cast<int>(TechBranch::COUNT));
+                if (branch == 0) break;
+                double percent = InputHandler::getDouble(u8"Доля денег каждый ход, %", 1, 100);
+                m_orders.setInvestment(static_cast<TechBranch>(branch - 1), percent / 100.0);
+                Logger::instance().info("Standing order: invest " + Utils::formatDouble(percent, 0) +
+                                       "% in " + techBranchToString(static_cast<TechBranch>(branch - 1)));
+                break;
+            }
+            case 2:
+                m_orders.clearInvestment();
+                break;
+            case 3:
+                m_orders.setAutoResearch(!m_orders.isAutoResearch());
+                break;
+        }
+    }
+}
+
 void GameEngine::handleInvestment() {
     m_display->clearScreen();
     m_display->showInvestmentMenu(*m_civ);
@@ -237,14 +447,9 @@ void GameEngine::handleInvestment() {
     double amount = InputHandler::getDouble(u8"Сумма инвестиций (макс " +
                                             Utils::formatDouble(maxInvest, 0) + ")", 0, maxInvest);
 
-    if (amount > 0) {
-        m_civ->getResources().removeResource(ResourceType::Money, amount);
-        m_civ->getTech().investInBranch(branch, amount);
-
+    if (invest(branch, amount)) {
         std::cout << "  " << ColorOutput::success(u8"Инвестировано " + Utils::formatDouble(amount, 0) +
                   u8" в " + techBranchToString(branch) + "!") << "\n";
-        Logger::instance().info("Invested " + Utils::formatDouble(amount) +
-                               " in " + techBranchToString(branch));
     }
 
     InputHandler::waitForKey();
@@ -254,8 +459,8 @@ void GameEngine::handleTechResearch() {
     m_display->clearScreen();
     m_display->showTechTree(*m_civ);
 
-    auto available = m_civ->getTech().getAvailableTechs();
-    if (available.empty()) {
+    const TechnologyTree& tree = m_civ->getTech();
+    if (tree.getAvailableIds().empty()) {
         std::cout << "\n  " << ColorOutput::warning(u8"Нет доступных технологий для исследования.") << "\n";
         std::cout << "  " << ColorOutput::dim(u8"Инвестируйте в ветки технологий для открытия новых.") << "\n";
         InputHandler::waitForKey();
@@ -263,32 +468,31 @@ void GameEngine::handleTechResearch() {
     }
 
     std::cout << "\n  " << ColorOutput::cyan(u8"Выберите технологию (0 - отмена)") << "\n";
-    int choice = InputHandler::getInt(u8"Выбор", 0, static_cast<int>(available.size()));
+    int choice = InputHandler::getInt(u8"Выбор", 0, static_cast<int>(tree.getAvailableIds().size()));
 
     if (choice == 0) return;
 
-    const Technology* tech = available[choice - 1];
+    // Technologies keep their place in the tree, so the reference outlives the research
+    const Technology& tech = tree.getTechnology(tree.getAvailableIds()[choice - 1]);
     double money = m_civ->getResources().getResource(ResourceType::Money);
 
-    if (money < tech->cost) {
+    if (money < tech.cost) {
         std::cout << "  " << ColorOutput::error(u8"Недостаточно денег! Нужно " +
-                  std::to_string(tech->cost) + u8", есть " + Utils::formatDouble(money, 0)) << "\n";
+                  std::to_string(tech.cost) + u8", есть " + Utils::formatDouble(money, 0)) << "\n";
         InputHandler::waitForKey();
         return;
     }
 
-    m_civ->getResources().removeResource(ResourceType::Money, tech->cost);
-    if (m_civ->getTech().researchTech(tech->name)) {
-        std::cout << "  " << ColorOutput::success(u8"Исследовано: " + tech->name + "!") << "\n";
-        std::cout << "  " << ColorOutput::dim(tech->description) << "\n";
-        Logger::instance().info("Researched technology: " + tech->name);
+    if (research(tech.name)) {
+        std::cout << "  " << ColorOutput::success(u8"Исследовано: " + tech.name + "!") << "\n";
+        std::cout << "  " << ColorOutput::dim(tech.description) << "\n";
     }
 
     InputHandler::waitForKey();
 }
 
 void GameEngine::handleSaveGame() {
-    if (m_saveSystem->saveGame(*m_civ, *m_events, m_difficulty)) {
+    if (saveCurrentGame()) {
         std::cout << "\n  " << ColorOutput::success(u8"Игра успешно сохранена!") << "\n";
     } else {
         std::cout << "\n  " << ColorOutput::error(u8"Ошибка сохранения: " + m_saveSystem->getLastError()) << "\n";
@@ -0,0 +1,65 @@
+#include "game/GameSnapshot.h"
+#include "game/Civilization.h"
+#include "game/EventSystem.h"
+#include <algorithm>
+
+namespace civ {
+
+void GameSnapshot::capture(const Civilization& civ, const EventSystem& events) {
+    hasGame = true;
+    name = civ.getName();
+    turn = civ.getTurn();
+    era = civ.getCurrentEra();
+    population = civ.getPopulation();
+    happiness = civ.getHappiness();
+    ecology = civ.getEcology();
+    military = civ.getMilitary();
+    activeEffects = civ.getActiveEffects().size();
+    stableEconomyTurns = civ.getStableEconomyTurns();
+    techLevel = civ.getTech().getOverallTechLevel();
+    researchedCount = civ.getTech().getResearchedCount();
+    result = civ.checkGameResult();
+
+    for (size_t r = 0; r < NUM_RESOURCES; ++r) {
+        auto type = static_cast<ResourceType>(r);
+        resources[r] = civ.getResources().getResource(type);
+        netIncome[r] = civ.getResources().getNetIncome(type);
+    }
+    for (size_t b = 0; b < NUM_BRANCHES; ++b) {
+        auto branch = static_cast<TechBranch>(b);
+        branchLevels[b] = civ.getTech().getBranchLevel(branch);
+        branchProgress[b] = civ.getTech().getBranchProgress(branch);
+        branchThreshold[b] = civ.getTech().getBranchThreshold(branch);
+    }
+
+    const auto& history = events.getEventHistory();
+    totalEvents = history.size();
+    recentCount = std::min(history.size(), RECENT_EVENTS);
+    size_t start = history.size() - recentCount;
+    for (size_t i = 0; i < recentCount; ++i) {
+        recentEvents[i].type = history[start + i].type;
+        recentEvents[i].name.assign(history[start + i].name);
+    }
+}
+
+void GameSnapshot::clear() {
+    uint64_t keptSequence = sequence;
+    *this = GameSnapshot{};
+    sequence = keptSequence;
+}
+
+void SnapshotChannel::publish(const Civilization& civ, const EventSystem& events) {
+    GameSnapshot& snapshot = m_buffer.back();
+    snapshot.capture(civ, events);
+    snapshot.sequence = ++m_published;
+    m_buffer.publish();
+}
+
+void SnapshotChannel::publishEmpty() {
+    GameSnapshot& snapshot = m_buffer.back();
+    snapshot.clear();
+    snapshot.sequence = ++m_published;
+    m_buffer.publish();
+}
+
+} // namespace civ
@@ -0,0 +1,87 @@
+#include "game/GameViewModel.h"
+#include <utility>
+
+namespace civ {
+
+namespace {
+
+template <typename T, size_t N>
+bool sameArray(const std::array<T, N>& a, const std::array<T, N>& b) {
+    for (size_t i = 0; i < N; ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+bool sameEvents(const GameSnapshot& a, const GameSnapshot& b) {
+    if (a.totalEvents != b.totalEvents || a.recentCount != b.recentCount) return false;
+    for (size_t i = 0; i < a.recentCount; ++i) {
+        if (a.recentEvents[i].type != b.recentEvents[i].type ||
+            a.recentEvents[i].name != b.recentEvents[i].name) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+ViewChanges GameViewModel::diff(const GameSnapshot& before, const GameSnapshot& after) {
+    ViewChanges changes;
+    if (before.hasGame != after.hasGame || before.name != after.name || before.result != after.result) {
+        changes.add(ViewChange::Game);
+    }
+    if (before.turn != after.turn) changes.add(ViewChange::Turn);
+    if (before.era != after.era) changes.add(ViewChange::Era);
+    if (before.population != after.population) changes.add(ViewChange::Population);
+    if (before.happiness != after.happiness) changes.add(ViewChange::Happiness);
+    if (before.ecology != after.ecology) changes.add(ViewChange::Ecology);
+    if (before.military != after.military) changes.add(ViewChange::Military);
+    if (before.activeEffects != after.activeEffects ||
+        before.stableEconomyTurns != after.stableEconomyTurns) {
+        changes.add(ViewChange::Effects);
+    }
+    if (!sameArray(before.resources, after.resources)) changes.add(ViewChange::Resources);
+    if (!sameArray(before.netIncome, after.netIncome)) changes.add(ViewChange::Income);
+    if (before.techLevel != after.techLevel) changes.add(ViewChange::TechLevel);
+    if (!sameArray(before.branchLevels, after.branchLevels)) changes.add(ViewChange::BranchLevels);
+    if (!sameArray(before.branchProgress, after.branchProgress) ||
+        !sameArray(before.branchThreshold, after.branchThreshold)) {
+        changes.add(ViewChange::BranchProgress);
+    }
+    if (before.researchedCount != after.researchedCount) changes.add(ViewChange::Research);
+    if (!sameEvents(before, after)) changes.add(ViewChange::Events);
+    return changes;
+}
+
+ViewChanges GameViewModel::changesTo(const GameSnapshot& next) const {
+    if (m_valid) return diff(m_current, next);
+    ViewChanges changes;
+    changes.add(ViewChange::All);
+    return changes;
+}
+
+ViewChanges GameViewModel::update(const GameSnapshot& next) {
+    ViewChanges changes = changesTo(next);
+    m_current = next;   // Reuses the strings' capacity
+    m_valid = true;
+    return changes;
+}
+
+ViewChanges GameViewModel::update(const Civilization& civ, const EventSystem& events) {
+    m_scratch.capture(civ, events);
+    ViewChanges changes = changesTo(m_scratch);
+    std::swap(m_current, m_scratch);
+    m_valid = true;
+    return changes;
+}
+
+ViewChanges GameViewModel::clear() {
+    m_scratch.clear();
+    ViewChanges changes = changesTo(m_scratch);
+    std::swap(m_current, m_scratch);
+    m_valid = true;
+    return changes;
+}
+
+} // namespace civ
@@ -0,0 +1,122 @@
+#include "game/ModifierStack.h"
+
+namespace civ {
+
+ModifierStack::ModifierStack() {
+    for (auto& target : m_effective) target.fill(1.0);
+}
+
+ModifierId ModifierStack::add(const Modifier& modifier) {
+    if (modifier.multiplier == 0.0) return ModifierId{};
+
+    uint32_t index;
+    if (m_free != UINT32_MAX) {
+        index = m_free;
+        m_free = m_entries[index].nextFree;
+    } else {
+        m_entries.emplace_back();
+        index = static_cast<uint32_t>(m_entries.size() - 1);
+    }
+
+    Entry& entry = m_entries[index];
+    entry.modifier = modifier;
+    entry.active = true;
+    ++m_size;
+    include(modifier);
+
+    ModifierId id{ index, entry.generation };
+    if (modifier.turns != Modifier::PERMANENT) {
+        m_expiry.schedule(id, static_cast<uint64_t>(modifier.turns > 0 ? modifier.turns : 1));
+    }
+    return id;
+}
+
+bool ModifierStack::remove(ModifierId id) {
+    Entry* entry = find(id);
+    if (!entry) return false;
+
+    exclude(entry->modifier);
+    entry->active = false;
+    entry->generation++;   // Invalidates id, including a pending expiry
+    entry->nextFree = m_free;
+    m_free = id.index;
+    --m_size;
+    return true;
+}
+
+bool ModifierStack::update(ModifierId id, double additive, double multiplier) {
+    if (multiplier == 0.0) return false;
+
+    Entry* entry = find(id);
+    if (!entry) return false;
+
+    exclude(entry->modifier);
+    entry->modifier.additive = additive;
+    entry->modifier.multiplier = multiplier;
+    include(entry->modifier);
+    return true;
+}
+
+void ModifierStack::removeSource(ModifierSource source) {
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.active && entry.modifier.source == source) {
+            remove(ModifierId{ i, entry.generation });
+        }
+    }
+}
+
+void ModifierStack::clear() {
+    m_entries.clear();
+    m_free = UINT32_MAX;
+    m_size = 0;
+    m_expiry.clear();
+    for (auto& target : m_aggregates) target.fill(Aggregate{});
+    for (auto& target : m_effective) target.fill(1.0);
+}
+
+void ModifierStack::advanceTurn() {
+    // Ids of modifiers removed earlier no longer match and are skipped by remove()
+    m_expiry.advance([this](ModifierId id) { remove(id); });
+}
+
+const Modifier* ModifierStack::get(ModifierId id) const {
+    if (id.index >= m_entries.size()) return nullptr;
+    const Entry& entry = m_entries[id.index];
+    return (entry.active && entry.generation == id.generation) ? &entry.modifier : nullptr;
+}
+
+ModifierStack::Entry* ModifierStack::find(ModifierId id) {
+    if (id.index >= m_entries.size()) return nullptr;
+    Entry& entry = m_entries[id.index];
+    return (entry.active && entry.generation == id.generation) ? &entry : nullptr;
+}
+
+void ModifierStack::include(const Modifier& modifier) {
+    Aggregate& aggregate = m_aggregates[static_cast<size_t>(modifier.target)][static_cast<size_t>(modifier.resource)];
+    aggregate.additive += modifier.additive;
+    aggregate.product *= modifier.multiplier;
+    aggregate.count++;
+    refresh(modifier);
+}
+
+void ModifierStack::exclude(const Modifier& modifier) {
+    Aggregate& aggregate = m_aggregates[static_cast<size_t>(modifier.target)][static_cast<size_t>(modifier.resource)];
+    if (--aggregate.count == 0) {
+        // The pair's last modifier: back to additive 0 and product 1, an effective 1.0
+        aggregate = Aggregate{};
+    } else {
+        aggregate.additive -= modifier.additive;
+        aggregate.product /= modifier.multiplier;
+    }
+    refresh(modifier);
+}
+
+void ModifierStack::refresh(const Modifier& modifier) {
+    auto target = static_cast<size_t>(modifier.target);
+    auto resource = static_cast<size_t>(modifier.resource);
+    const Aggregate& aggregate = m_aggregates[target][resource];
+    m_effective[target][resource] = (1.0 + aggregate.additive) * aggregate.product;
+}
+
+} // namespace civ
@@ -1,4 +1,5 @@
 #include "game/ResourceManager.h"
+#include "game/SimdKernels.h"
 #include "core/Utils.h"
 #include "core/ColorOutput.h"
 #include <sstream>
@@ -11,8 +12,6 @@ ResourceManager::ResourceManager() {
     m_resources.fill(0.0);
     m_production.fill(0.0);
     m_consumption.fill(0.0);
-    m_prodMultiplier.fill(1.0);
-    m_consMultiplier.fill(1.0);
 
     // Starting resources
     m_resources[static_cast<size_t>(ResourceType::Food)]      = 500.0;
@@ -26,11 +25,15 @@ double ResourceManager::getResource(ResourceType type) const {
 }
 
 double ResourceManager::getProduction(ResourceType type) const {
-    return m_production[static_cast<size_t>(type)] * m_prodMultiplier[static_cast<size_t>(type)];
+    return m_production[static_cast<size_t>(type)] * m_modifiers.getMultiplier(ModifierTarget::Production, type);
+}
+
+double ResourceManager::getBaseProduction(ResourceType type) const {
+    return m_production[static_cast<size_t>(type)];
 }
 
 double ResourceManager::getConsumption(ResourceType type) const {
-    return m_consumption[static_cast<size_t>(type)] * m_consMultiplier[static_cast<size_t>(type)];
+    return m_consumption[static_cast<size_t>(type)] * m_modifiers.getMultiplier(ModifierTarget::Consumption, type);
 }
 
 double ResourceManager::getNetIncome(ResourceType type) const {
@@ -53,30 +56,19 @@ void ResourceManager::setConsumption(ResourceType type, double amount) {
     m_consumption[static_cast<size_t>(type)] = amount;
 }
 
-void ResourceManager::applyProductionMultiplier(ResourceType type, double multiplier) {
-    m_prodMultiplier[static_cast<size_t>(type)] *= multiplier;
-}
-
-void ResourceManager::applyConsumptionMultiplier(ResourceType type, double multiplier) {
-    m_consMultiplier[static_cast<size_t>(type)] *= multiplier;
-}
-
-void ResourceManager::resetMultipliers() {
-    m_prodMultiplier.fill(1.0);
-    m_consMultiplier.fill(1.0);
-}
-
 void ResourceManager::processTurn(int population, int techLevel) {
-    updateProduction(population, techLevel);
-    updateConsumption(population);
+    double popFactor = static_cast<double>(population) * 0.01;
+    double techFactor = 1.0 + techLevel * 0.02;
 
-    for (size_t i = 0; i < NUM_RESOURCES; ++i) {
-        double net = getProduction(static_cast<ResourceType>(i))
-                   - getConsumption(static_cast<ResourceType>(i));
-        m_resources[i] += net;
-        // Resources can go negative (debt) but floor at a reasonable limit
-        m_resources[i] = std::max(m_resources[i], -10000.0);
-    }
+    // Resources can go negative (debt) but floor at a reasonable limit
+    SimdKernels::updateResourceLanes(popFactor, techFactor,
+                                     PRODUCTION_RATE.data(), CONSUMPTION_RATE.data(),
+                                     m_modifiers.multipliers(ModifierTarget::Production),
+                                     m_modifiers.multipliers(ModifierTarget::Consumption),
+                                     m_production.data(), m_consumption.data(), m_resources.data());
+
+    // The turn has used the modifiers: timed ones count down
+    m_modifiers.advanceTurn();
 }
 
 double ResourceManager::getTotalSurplus() const {
@@ -88,26 +80,6 @@ double ResourceManager::getTotalSurplus() const {
     return surplus;
 }
 
-void ResourceManager::updateProduction(int population, int techLevel) {
-    // Изменено с sqrt на линейную зависимость, чтобы экономика не рушилась при росте населения
-    double popFactor = static_cast<double>(population) * 0.01; 
-    double techFactor = 1.0 + techLevel * 0.02;
-
-    m_production[static_cast<size_t>(ResourceType::Food)]      = popFactor * 1.5 * techFactor; // База 1.5 > Потр 1.2
-    m_production[static_cast<size_t>(ResourceType::Money)]     = popFactor * 1.1 * techFactor; // База 1.1 > Потр 0.8
-    m_production[static_cast<size_t>(ResourceType::Energy)]    = popFactor * 0.8 * techFactor; // База 0.8 > Потр 0.5
-    m_production[static_cast<size_t>(ResourceType::Materials)] = popFactor * 0.6 * techFactor; // База 0.6 > Потр 0.3
-}
-
-void ResourceManager::updateConsumption(int population) {
-    double popFactor = static_cast<double>(population) * 0.01;
-
-    m_consumption[static_cast<size_t>(ResourceType::Food)]      = popFactor * 1.2;
-    m_consumption[static_cast<size_t>(ResourceType::Money)]     = popFactor * 0.8;
-    m_consumption[static_cast<size_t>(ResourceType::Energy)]    = popFactor * 0.5;
-    m_consumption[static_cast<size_t>(ResourceType::Materials)] = popFactor * 0.3;
-}
-
 std::string ResourceManager::serialize() const {
     std::ostringstream oss;
     for (size_t i = 0; i < NUM_RESOURCES; ++i) {
@@ -125,16 +97,24 @@ void ResourceManager::deserialize(const std::string& data) {
 
 std::string ResourceManager::getStatusString() const {
     std::ostringstream oss;
+    char name[64];
+    char value[Utils::DOUBLE_BUFFER_SIZE];
+    char padded[Utils::DOUBLE_BUFFER_SIZE];
+    char net[Utils::DOUBLE_BUFFER_SIZE];
     for (size_t i = 0; i < NUM_RESOURCES; ++i) {
         auto type = static_cast<ResourceType>(i);
-        std::string name = resourceTypeToString(type);
-        double val = m_resources[i];
-        double net = getNetIncome(type);
-
-        std::string netStr = (net >= 0 ? "+" : "") + Utils::formatDouble(net);
-        oss << "  " << Utils::padRight(name, 14) << ": "
-            << Utils::padLeft(Utils::formatDouble(val, 0), 8)
-            << " (" << netStr << u8"/ход)\n";
+        double netIncome = getNetIncome(type);
+
+        size_t nameLen = Utils::padRightTo(name, sizeof(name), resourceTypeToString(type), 14);
+        size_t valueLen = Utils::formatDoubleTo(value, sizeof(value), m_resources[i], 0);
+        size_t paddedLen = Utils::padLeftTo(padded, sizeof(padded),
+                                            std::string_view(value, valueLen), 8);
+        size_t netLen = Utils::formatDoubleTo(net, sizeof(net), netIncome);
+
+        oss << "  " << std::string_view(name, nameLen) << ": "
+            << std::string_view(padded, paddedLen)
+            << " (" << (netIncome >= 0 ? "+" : "") << std::string_view(net, netLen)
+            << u8"/ход)\n";
     }
     return oss.str();
 }
@@ -1,5 +1,6 @@
 #include "game/SaveSystem.h"
 #include "core/Logger.h"
+#include "core/Profiler.h"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -8,6 +9,7 @@ namespace civ {
 
 bool SaveSystem::saveGame(const Civilization& civ, const EventSystem& events,
                           Difficulty difficulty, const std::string& filename) {
+    CIV_PROFILE_SCOPE(SaveGame);
     try {
         std::ofstream file(filename, std::ios::out | std::ios::trunc);
         if (!file.is_open()) {
@@ -35,6 +37,7 @@ bool SaveSystem::saveGame(const Civilization& civ, const EventSystem& events,
 
 bool SaveSystem::loadGame(Civilization& civ, EventSystem& events,
                           Difficulty& difficulty, const std::string& filename) {
+    CIV_PROFILE_SCOPE(LoadGame);
     try {
         std::ifstream file(filename, std::ios::in);
         if (!file.is_open()) {
@@ -0,0 +1,124 @@
+#include "game/SettlerSystem.h"
+#include "game/SimdKernels.h"
+#include <algorithm>
+
+namespace civ {
+
+SettlerSystem::SettlerSystem(uint64_t seed) : m_random(seed) {}
+
+size_t SettlerSystem::targetCount(int population) {
+    if (population <= 0) return 0;
+    return std::min(MAX_SETTLERS, static_cast<size_t>(population / PEOPLE_PER_SETTLER));
+}
+
+void SettlerSystem::setBounds(float width, float height) {
+    m_width = std::max(0.0f, width);
+    m_height = std::max(0.0f, height);
+}
+
+void SettlerSystem::reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_vx.reserve(count);
+    m_vy.reserve(count);
+    m_target.reserve(count);
+}
+
+void SettlerSystem::spawn(float x, float y) {
+    uint64_t bits = nextBits();
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_vx.push_back(speedFromBits(static_cast<uint32_t>(bits)));
+    m_vy.push_back(speedFromBits(static_cast<uint32_t>(bits >> 16)));
+    m_target.push_back(CityFlowFields::NO_TARGET);
+}
+
+void SettlerSystem::truncate(size_t count) {
+    if (count >= size()) return;
+    m_x.resize(count);
+    m_y.resize(count);
+    m_vx.resize(count);
+    m_vy.resize(count);
+    m_target.resize(count);
+}
+
+void SettlerSystem::clear() {
+    truncate(0);
+    m_pending = 0.0;
+    m_wanderDebt = 0.0;
+}
+
+int SettlerSystem::advance(double seconds, const CityFlowFields* fields) {
+    m_pending += std::max(0.0, seconds);
+    int steps = 0;
+    while (m_pending >= STEP_SECONDS && steps < MAX_CATCH_UP_STEPS) {
+        step(fields);
+        m_pending -= STEP_SECONDS;
+        ++steps;
+    }
+    if (steps == MAX_CATCH_UP_STEPS) {
+        // Too far behind: let the backlog go instead of spiralling
+        m_pending = std::min(m_pending, STEP_SECONDS);
+    }
+    return steps;
+}
+
+void SettlerSystem::step(const CityFlowFields* fields) {
+    if (m_x.empty()) return;
+    if (fields && !fields->empty()) {
+        steer(*fields);
+    } else {
+        wander();
+    }
+    SettlerColumns columns{ m_x.data(), m_y.data(), m_vx.data(), m_vy.data(),
+                            m_width, m_height, static_cast<float>(STEP_SECONDS) };
+    SimdKernels::moveSettlers(columns, m_x.size());
+}
+
+void SettlerSystem::wander() {
+    // Turns WANDER_PER_SECOND of the settlers per second on average: a few
+    // random picks per step instead of a random draw for every settler
+    m_wanderDebt += static_cast<double>(m_x.size()) * WANDER_PER_SECOND * STEP_SECONDS;
+    const auto count = static_cast<size_t>(m_wanderDebt);
+    m_wanderDebt -= static_cast<double>(count);
+
+    const uint64_t n = m_x.size();
+    for (size_t k = 0; k < count; ++k) {
+        uint64_t bits = nextBits();
+        // High 32 bits scaled to [0, n) without a division
+        auto index = static_cast<size_t>(((bits >> 32) * n) >> 32);
+        m_vx[index] = speedFromBits(static_cast<uint32_t>(bits));
+        m_vy[index] = speedFromBits(static_cast<uint32_t>(bits >> 16));
+    }
+}
+
+void SettlerSystem::steer(const CityFlowFields& fields) {
+    // One field lookup per settler; a random draw only on arrival
+    const size_t n = m_x.size();
+    for (size_t i = 0; i < n; ++i) {
+        float dx = 0.0f;
+        float dy = 0.0f;
+        if (m_target[i] == CityFlowFields::NO_TARGET ||
+            !fields.direction(m_target[i], m_x[i], m_y[i], dx, dy)) {
+            m_target[i] = fields.nextTarget(m_target[i], static_cast<uint32_t>(nextBits() >> 32));
+            fields.direction(m_target[i], m_x[i], m_y[i], dx, dy);
+        }
+        m_vx[i] = dx * COMMUTE_SPEED;
+        m_vy[i] = dy * COMMUTE_SPEED;
+    }
+}
+
+uint64_t SettlerSystem::nextBits() {
+    if (m_bitsLeft == 0) {
+        m_random.next(m_bits);
+        m_bitsLeft = m_bits.size();
+    }
+    return m_bits[--m_bitsLeft];
+}
+
+float SettlerSystem::speedFromBits(uint32_t bits) {
+    float unit = static_cast<float>(bits & 0xFFFFu) * (1.0f / 65536.0f);   // [0, 1)
+    return (unit * 2.0f - 1.0f) * MAX_SPEED;
+}
+
+} // namespace civ
@@ -0,0 +1,242 @@
+#include "game/SimdKernels.h"
+#include "SimdKernelsBackends.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace civ {
+
+// ============================================================
+// Portable kernels (reference implementation and loop tails)
+// ============================================================
+
+namespace simd::scalar {
+
+namespace {
+
+// Same expression as Utils::clamp, inlined into the loops
+inline double clampValue(double value, double min, double max) {
+    return std::max(min, std::min(max, value));
+}
+
+} // namespace
+
+void updateResources(const ResourceColumns& columns, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        double popFactor = static_cast<double>(columns.population[i]) * 0.01;
+        double techFactor = 1.0 + columns.techLevel[i] * 0.02;
+        double production = popFactor * columns.productionRate * techFactor;
+        double consumption = popFactor * columns.consumptionRate;
+        columns.production[i] = production;
+        columns.consumption[i] = consumption;
+        double net = production * columns.productionMultiplier[i] - consumption;
+        columns.amount[i] = std::max(columns.amount[i] + net, -10000.0);
+    }
+}
+
+void growPopulation(const GrowthColumns& columns, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        // Civilization::getGrowthRate
+        int population = columns.population[i];
+        double foodNeeded = population * 0.012;
+        double foodRatio = (foodNeeded > 0) ? columns.food[i] / foodNeeded : 1.0;
+        foodRatio = clampValue(foodRatio, 0.0, 2.0);
+
+        double happinessFactor = columns.happiness[i] / 100.0;
+        double medicineFactor = 1.0 + columns.medicineLevel[i] * 0.04;
+        double ecologyFactor = columns.ecology[i] / 100.0;
+
+        double rate = 0.02 * foodRatio * happinessFactor * medicineFactor * ecologyFactor;
+        if (foodRatio < 0.5 || columns.happiness[i] < 20.0) {
+            rate = std::min(rate, -0.01);
+        }
+        rate = clampValue(rate, -0.05, 0.05);
+
+        int growth = static_cast<int>(population * rate);
+        columns.population[i] = std::max(0, population + growth);
+    }
+}
+
+void updateResourceLanes(double popFactor, double techFactor,
+                         const double* productionRate, const double* consumptionRate,
+                         const double* productionMultiplier, const double* consumptionMultiplier,
+                         double* production, double* consumption, double* amount) {
+    for (size_t r = 0; r < SimdKernels::RESOURCE_LANES; ++r) {
+        production[r] = popFactor * productionRate[r] * techFactor;
+        consumption[r] = popFactor * consumptionRate[r];
+        double net = production[r] * productionMultiplier[r] - consumption[r] * consumptionMultiplier[r];
+        amount[r] = std::max(amount[r] + net, -10000.0);
+    }
+}
+
+void moveSettlers(const SettlerColumns& columns, size_t begin, size_t end) {
+    const float width = columns.width;
+    const float height = columns.height;
+    for (size_t i = begin; i < end; ++i) {
+        float x = columns.x[i] + columns.vx[i] * columns.dt;
+        float y = columns.y[i] + columns.vy[i] * columns.dt;
+        // Mirror a settler that crossed an edge back inside and turn it around;
+        // the clamp catches steps longer than the map
+        bool flipX = x < 0.0f || x > width;
+        bool flipY = y < 0.0f || y > height;
+        x = x < 0.0f ? -x : x;
+        x = x > width ? (width + width) - x : x;
+        y = y < 0.0f ? -y : y;
+        y = y > height ? (height + height) - y : y;
+        columns.x[i] = std::min(width, std::max(0.0f, x));
+        columns.y[i] = std::min(height, std::max(0.0f, y));
+        columns.vx[i] = flipX ? -columns.vx[i] : columns.vx[i];
+        columns.vy[i] = flipY ? -columns.vy[i] : columns.vy[i];
+    }
+}
+
+} // namespace simd::scalar
+
+// ============================================================
+// Runtime dispatch
+// ============================================================
+
+namespace {
+
+bool cpuSupports(SimdLevel level) {
+    if (level == SimdLevel::Scalar) return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (level == SimdLevel::AVX2) return __builtin_cpu_supports("avx2");
+    return __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0; // OSXSAVE
+    if (!osSavesAvx) return false;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (level == SimdLevel::AVX2) {
+        return (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    }
+    return (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool builtWith(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return true;
+#ifdef INTSIM_SIMD_AVX2
+        case SimdLevel::AVX2:   return true;
+#endif
+#ifdef INTSIM_SIMD_AVX512
+        case SimdLevel::AVX512: return true;
+#endif
+        default:                return false;
+    }
+}
+
+SimdLevel initialLevel() {
+    SimdLevel level = SimdKernels::detect();
+    if (const char* requested = std::getenv("INTSIM_SIMD")) {
+        for (SimdLevel candidate : { SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+            if (std::strcmp(requested, simdLevelToString(candidate)) == 0) {
+                level = std::min(level, candidate);
+            }
+        }
+    }
+    return level;
+}
+
+std::atomic<SimdLevel>& activeLevel() {
+    static std::atomic<SimdLevel> level{initialLevel()};
+    return level;
+}
+
+} // namespace
+
+const char* simdLevelToString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::AVX2:   return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default:                return "unknown";
+    }
+}
+
+SimdLevel SimdKernels::detect() {
+    static const SimdLevel detected = [] {
+        SimdLevel best = SimdLevel::Scalar;
+        for (SimdLevel level : { SimdLevel::AVX2, SimdLevel::AVX512 }) {
+            if (builtWith(level) && cpuSupports(level)) best = level;
+        }
+        return best;
+    }();
+    return detected;
+}
+
+SimdLevel SimdKernels::getLevel() {
+    return activeLevel().load(std::memory_order_relaxed);
+}
+
+void SimdKernels::setLevel(SimdLevel level) {
+    activeLevel().store(std::min(level, detect()), std::memory_order_relaxed);
+}
+
+void SimdKernels::updateResources(const ResourceColumns& columns, size_t n) {
+    switch (getLevel()) {
+#ifdef INTSIM_SIMD_AVX512
+        case SimdLevel::AVX512: simd::avx512::updateResources(columns, n); return;
+#endif
+#ifdef INTSIM_SIMD_AVX2
+        case SimdLevel::AVX2:   simd::avx2::updateResources(columns, n); return;
+#endif
+        default:                simd::scalar::updateResources(columns, 0, n); return;
+    }
+}
+
+void SimdKernels::growPopulation(const GrowthColumns& columns, size_t n) {
+    switch (getLevel()) {
+#ifdef INTSIM_SIMD_AVX512
+        case SimdLevel::AVX512: simd::avx512::growPopulation(columns, n); return;
+#endif
+#ifdef INTSIM_SIMD_AVX2
+        case SimdLevel::AVX2:   simd::avx2::growPopulation(columns, n); return;
+#endif
+        default:                simd::scalar::growPopulation(columns, 0, n); return;
+    }
+}
+
+void SimdKernels::moveSettlers(const SettlerColumns& columns, size_t n) {
+    switch (getLevel()) {
+#ifdef INTSIM_SIMD_AVX512
+        case SimdLevel::AVX512: simd::avx512::moveSettlers(columns, n); return;
+#endif
+#ifdef INTSIM_SIMD_AVX2
+        case SimdLevel::AVX2:   simd::avx2::moveSettlers(columns, n); return;
+#endif
+        default:                simd::scalar::moveSettlers(columns, 0, n); return;
+    }
+}
+
+void SimdKernels::updateResourceLanes(double popFactor, double techFactor,
+                                      const double* productionRate, const double* consumptionRate,
+                                      const double* productionMultiplier, const double* consumptionMultiplier,
+                                      double* production, double* consumption, double* amount) {
+#ifdef INTSIM_SIMD_AVX2
+    // Four lanes fill exactly one AVX2 register; AVX-512 has nothing to add here
+    if (getLevel() != SimdLevel::Scalar) {
+        simd::avx2::updateResourceLanes(popFactor, techFactor, productionRate, consumptionRate,
+                                        productionMultiplier, consumptionMultiplier,
+                                        production, consumption, amount);
+        return;
+    }
+#endif
+    simd::scalar::updateResourceLanes(popFactor, techFactor, productionRate, consumptionRate,
+                                      productionMultiplier, consumptionMultiplier,
+                                      production, consumption, amount);
+}
+
+} // namespace civ
@@ -0,0 +1,140 @@
+#include "SimdKernelsBackends.h"
+#include <immintrin.h>
+
+// Compiled with AVX2 enabled (and FMA contraction disabled); only called after
+// SimdKernels has checked the CPU. Lane-for-lane the same operations as the
+// scalar kernels: _mm256_min_pd(a, b) / _mm256_max_pd(a, b) select like
+// std::min(b, a) / std::max(b, a), which is how the scalar clamps are written.
+
+namespace civ::simd::avx2 {
+
+void updateResources(const ResourceColumns& columns, size_t n) {
+    const __m256d hundredth = _mm256_set1_pd(0.01);
+    const __m256d techStep = _mm256_set1_pd(0.02);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d floor = _mm256_set1_pd(-10000.0);
+    const __m256d prodRate = _mm256_set1_pd(columns.productionRate);
+    const __m256d consRate = _mm256_set1_pd(columns.consumptionRate);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d population = _mm256_cvtepi32_pd(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.population + i)));
+        __m256d techLevel = _mm256_cvtepi32_pd(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.techLevel + i)));
+
+        __m256d popFactor = _mm256_mul_pd(population, hundredth);
+        __m256d techFactor = _mm256_add_pd(one, _mm256_mul_pd(techLevel, techStep));
+        __m256d production = _mm256_mul_pd(_mm256_mul_pd(popFactor, prodRate), techFactor);
+        __m256d consumption = _mm256_mul_pd(popFactor, consRate);
+
+        __m256d amount = _mm256_loadu_pd(columns.amount + i);
+        __m256d multiplier = _mm256_loadu_pd(columns.productionMultiplier + i);
+        amount = _mm256_add_pd(amount, _mm256_sub_pd(_mm256_mul_pd(production, multiplier), consumption));
+        _mm256_storeu_pd(columns.amount + i, _mm256_max_pd(amount, floor));
+        _mm256_storeu_pd(columns.production + i, production);
+        _mm256_storeu_pd(columns.consumption + i, consumption);
+    }
+    scalar::updateResources(columns, i, n);
+}
+
+void growPopulation(const GrowthColumns& columns, size_t n) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d foodPerCapita = _mm256_set1_pd(0.012);
+    const __m256d baseRate = _mm256_set1_pd(0.02);
+    const __m256d medicineStep = _mm256_set1_pd(0.04);
+    const __m256d unhappy = _mm256_set1_pd(20.0);
+    const __m256d decline = _mm256_set1_pd(-0.01);
+    const __m256d minRate = _mm256_set1_pd(-0.05);
+    const __m256d maxRate = _mm256_set1_pd(0.05);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i populationInt = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.population + i));
+        __m256d population = _mm256_cvtepi32_pd(populationInt);
+        __m256d food = _mm256_loadu_pd(columns.food + i);
+        __m256d happiness = _mm256_loadu_pd(columns.happiness + i);
+        __m256d ecology = _mm256_loadu_pd(columns.ecology + i);
+        __m256d medicine = _mm256_cvtepi32_pd(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.medicineLevel + i)));
+
+        // foodRatio = foodNeeded > 0 ? food / foodNeeded : 1, clamped to [0, 2]
+        __m256d foodNeeded = _mm256_mul_pd(population, foodPerCapita);
+        __m256d hasNeed = _mm256_cmp_pd(foodNeeded, zero, _CMP_GT_OQ);
+        __m256d foodRatio = _mm256_div_pd(food, _mm256_blendv_pd(one, foodNeeded, hasNeed));
+        foodRatio = _mm256_blendv_pd(one, foodRatio, hasNeed);
+        foodRatio = _mm256_max_pd(_mm256_min_pd(foodRatio, two), zero);
+
+        __m256d happinessFactor = _mm256_div_pd(happiness, hundred);
+        __m256d medicineFactor = _mm256_add_pd(one, _mm256_mul_pd(medicine, medicineStep));
+        __m256d ecologyFactor = _mm256_div_pd(ecology, hundred);
+
+        __m256d rate = _mm256_mul_pd(baseRate, foodRatio);
+        rate = _mm256_mul_pd(rate, happinessFactor);
+        rate = _mm256_mul_pd(rate, medicineFactor);
+        rate = _mm256_mul_pd(rate, ecologyFactor);
+
+        __m256d distressed = _mm256_or_pd(_mm256_cmp_pd(foodRatio, half, _CMP_LT_OQ),
+                                          _mm256_cmp_pd(happiness, unhappy, _CMP_LT_OQ));
+        rate = _mm256_blendv_pd(rate, _mm256_min_pd(decline, rate), distressed);
+        rate = _mm256_max_pd(_mm256_min_pd(rate, maxRate), minRate);
+
+        __m128i growth = _mm256_cvttpd_epi32(_mm256_mul_pd(population, rate));
+        __m128i grown = _mm_max_epi32(_mm_add_epi32(populationInt, growth), _mm_setzero_si128());
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(columns.population + i), grown);
+    }
+    scalar::growPopulation(columns, i, n);
+}
+
+void updateResourceLanes(double popFactor, double techFactor,
+                         const double* productionRate, const double* consumptionRate,
+                         const double* productionMultiplier, const double* consumptionMultiplier,
+                         double* production, double* consumption, double* amount) {
+    __m256d pop = _mm256_set1_pd(popFactor);
+    __m256d prod = _mm256_mul_pd(_mm256_mul_pd(pop, _mm256_loadu_pd(productionRate)),
+                                 _mm256_set1_pd(techFactor));
+    __m256d cons = _mm256_mul_pd(pop, _mm256_loadu_pd(consumptionRate));
+    __m256d net = _mm256_sub_pd(_mm256_mul_pd(prod, _mm256_loadu_pd(productionMultiplier)),
+                                _mm256_mul_pd(cons, _mm256_loadu_pd(consumptionMultiplier)));
+    __m256d total = _mm256_add_pd(_mm256_loadu_pd(amount), net);
+
+    _mm256_storeu_pd(production, prod);
+    _mm256_storeu_pd(consumption, cons);
+    _mm256_storeu_pd(amount, _mm256_max_pd(total, _mm256_set1_pd(-10000.0)));
+}
+
+void moveSettlers(const SettlerColumns& columns, size_t n) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 dt = _mm256_set1_ps(columns.dt);
+    const __m256 width = _mm256_set1_ps(columns.width);
+    const __m256 height = _mm256_set1_ps(columns.height);
+    const __m256 twoWidth = _mm256_set1_ps(columns.width + columns.width);
+    const __m256 twoHeight = _mm256_set1_ps(columns.height + columns.height);
+
+    // One axis: move, mirror off both edges, clamp, and turn the velocity
+    // around where an edge was crossed
+    auto axis = [&](float* position, float* velocity, __m256 limit, __m256 twoLimit) {
+        __m256 v = _mm256_loadu_ps(velocity);
+        __m256 p = _mm256_add_ps(_mm256_loadu_ps(position), _mm256_mul_ps(v, dt));
+        __m256 below = _mm256_cmp_ps(p, zero, _CMP_LT_OQ);
+        __m256 flip = _mm256_or_ps(below, _mm256_cmp_ps(p, limit, _CMP_GT_OQ));
+        p = _mm256_blendv_ps(p, _mm256_xor_ps(p, sign), below);
+        p = _mm256_blendv_ps(p, _mm256_sub_ps(twoLimit, p), _mm256_cmp_ps(p, limit, _CMP_GT_OQ));
+        _mm256_storeu_ps(position, _mm256_min_ps(_mm256_max_ps(p, zero), limit));
+        _mm256_storeu_ps(velocity, _mm256_xor_ps(v, _mm256_and_ps(flip, sign)));
+    };
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        axis(columns.x + i, columns.vx + i, width, twoWidth);
+        axis(columns.y + i, columns.vy + i, height, twoHeight);
+    }
+    scalar::moveSettlers(columns, i, n);
+}
+
+} // namespace civ::simd::avx2
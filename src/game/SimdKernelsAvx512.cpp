@@ -0,0 +1,129 @@
+#include "SimdKernelsBackends.h"
+#include <immintrin.h>
+
+// GCC 12 reports its own maskless AVX-512 conversion intrinsics as reading an
+// uninitialized pass-through operand
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// Compiled with AVX-512F enabled (and FMA contraction disabled); only called
+// after SimdKernels has checked the CPU. The AVX2 kernels with 8 lanes and
+// mask registers in place of blend vectors.
+
+namespace civ::simd::avx512 {
+
+void updateResources(const ResourceColumns& columns, size_t n) {
+    const __m512d hundredth = _mm512_set1_pd(0.01);
+    const __m512d techStep = _mm512_set1_pd(0.02);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d floor = _mm512_set1_pd(-10000.0);
+    const __m512d prodRate = _mm512_set1_pd(columns.productionRate);
+    const __m512d consRate = _mm512_set1_pd(columns.consumptionRate);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d population = _mm512_cvtepi32_pd(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.population + i)));
+        __m512d techLevel = _mm512_cvtepi32_pd(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.techLevel + i)));
+
+        __m512d popFactor = _mm512_mul_pd(population, hundredth);
+        __m512d techFactor = _mm512_add_pd(one, _mm512_mul_pd(techLevel, techStep));
+        __m512d production = _mm512_mul_pd(_mm512_mul_pd(popFactor, prodRate), techFactor);
+        __m512d consumption = _mm512_mul_pd(popFactor, consRate);
+
+        __m512d amount = _mm512_loadu_pd(columns.amount + i);
+        __m512d multiplier = _mm512_loadu_pd(columns.productionMultiplier + i);
+        amount = _mm512_add_pd(amount, _mm512_sub_pd(_mm512_mul_pd(production, multiplier), consumption));
+        _mm512_storeu_pd(columns.amount + i, _mm512_max_pd(amount, floor));
+        _mm512_storeu_pd(columns.production + i, production);
+        _mm512_storeu_pd(columns.consumption + i, consumption);
+    }
+    scalar::updateResources(columns, i, n);
+}
+
+void growPopulation(const GrowthColumns& columns, size_t n) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d two = _mm512_set1_pd(2.0);
+    const __m512d half = _mm512_set1_pd(0.5);
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    const __m512d foodPerCapita = _mm512_set1_pd(0.012);
+    const __m512d baseRate = _mm512_set1_pd(0.02);
+    const __m512d medicineStep = _mm512_set1_pd(0.04);
+    const __m512d unhappy = _mm512_set1_pd(20.0);
+    const __m512d decline = _mm512_set1_pd(-0.01);
+    const __m512d minRate = _mm512_set1_pd(-0.05);
+    const __m512d maxRate = _mm512_set1_pd(0.05);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i populationInt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.population + i));
+        __m512d population = _mm512_cvtepi32_pd(populationInt);
+        __m512d food = _mm512_loadu_pd(columns.food + i);
+        __m512d happiness = _mm512_loadu_pd(columns.happiness + i);
+        __m512d ecology = _mm512_loadu_pd(columns.ecology + i);
+        __m512d medicine = _mm512_cvtepi32_pd(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.medicineLevel + i)));
+
+        __m512d foodNeeded = _mm512_mul_pd(population, foodPerCapita);
+        __mmask8 hasNeed = _mm512_cmp_pd_mask(foodNeeded, zero, _CMP_GT_OQ);
+        __m512d foodRatio = _mm512_div_pd(food, _mm512_mask_blend_pd(hasNeed, one, foodNeeded));
+        foodRatio = _mm512_mask_blend_pd(hasNeed, one, foodRatio);
+        foodRatio = _mm512_max_pd(_mm512_min_pd(foodRatio, two), zero);
+
+        __m512d happinessFactor = _mm512_div_pd(happiness, hundred);
+        __m512d medicineFactor = _mm512_add_pd(one, _mm512_mul_pd(medicine, medicineStep));
+        __m512d ecologyFactor = _mm512_div_pd(ecology, hundred);
+
+        __m512d rate = _mm512_mul_pd(baseRate, foodRatio);
+        rate = _mm512_mul_pd(rate, happinessFactor);
+        rate = _mm512_mul_pd(rate, medicineFactor);
+        rate = _mm512_mul_pd(rate, ecologyFactor);
+
+        __mmask8 distressed = _mm512_cmp_pd_mask(foodRatio, half, _CMP_LT_OQ) |
+                              _mm512_cmp_pd_mask(happiness, unhappy, _CMP_LT_OQ);
+        rate = _mm512_mask_blend_pd(distressed, rate, _mm512_min_pd(decline, rate));
+        rate = _mm512_max_pd(_mm512_min_pd(rate, maxRate), minRate);
+
+        __m256i growth = _mm512_cvttpd_epi32(_mm512_mul_pd(population, rate));
+        __m256i grown = _mm256_max_epi32(_mm256_add_epi32(populationInt, growth), _mm256_setzero_si256());
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(columns.population + i), grown);
+    }
+    scalar::growPopulation(columns, i, n);
+}
+
+void moveSettlers(const SettlerColumns& columns, size_t n) {
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512i sign = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+    const __m512 dt = _mm512_set1_ps(columns.dt);
+    const __m512 width = _mm512_set1_ps(columns.width);
+    const __m512 height = _mm512_set1_ps(columns.height);
+    const __m512 twoWidth = _mm512_set1_ps(columns.width + columns.width);
+    const __m512 twoHeight = _mm512_set1_ps(columns.height + columns.height);
+
+    // Float xor through the integer domain: AVX-512F has no _mm512_xor_ps
+    auto negate = [&sign](__m512 value) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(value), sign));
+    };
+    auto axis = [&](float* position, float* velocity, __m512 limit, __m512 twoLimit) {
+        __m512 v = _mm512_loadu_ps(velocity);
+        __m512 p = _mm512_add_ps(_mm512_loadu_ps(position), _mm512_mul_ps(v, dt));
+        __mmask16 below = _mm512_cmp_ps_mask(p, zero, _CMP_LT_OQ);
+        __mmask16 flip = below | _mm512_cmp_ps_mask(p, limit, _CMP_GT_OQ);
+        p = _mm512_mask_blend_ps(below, p, negate(p));
+        p = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(p, limit, _CMP_GT_OQ), p, _mm512_sub_ps(twoLimit, p));
+        _mm512_storeu_ps(position, _mm512_min_ps(_mm512_max_ps(p, zero), limit));
+        _mm512_storeu_ps(velocity, _mm512_mask_blend_ps(flip, v, negate(v)));
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        axis(columns.x + i, columns.vx + i, width, twoWidth);
+        axis(columns.y + i, columns.vy + i, height, twoHeight);
+    }
+    scalar::moveSettlers(columns, i, n);
+}
+
+} // namespace civ::simd::avx512
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "game/SimdKernels.h"
+
+// Per-instruction-set kernel implementations behind SimdKernels. The AVX2 and
+// AVX-512 ones live in their own translation units compiled with the matching
+// target flags; they include nothing but intrinsics so no inline library code
+// built for a wider target can leak into the rest of the program.
+
+namespace civ::simd {
+
+namespace scalar {
+void updateResources(const ResourceColumns& columns, size_t begin, size_t end);
+void growPopulation(const GrowthColumns& columns, size_t begin, size_t end);
+void updateResourceLanes(double popFactor, double techFactor,
+                         const double* productionRate, const double* consumptionRate,
+                         const double* productionMultiplier, const double* consumptionMultiplier,
+                         double* production, double* consumption, double* amount);
+void moveSettlers(const SettlerColumns& columns, size_t begin, size_t end);
+} // namespace scalar
+
+#ifdef INTSIM_SIMD_AVX2
+namespace avx2 {
+void updateResources(const ResourceColumns& columns, size_t n);
+void growPopulation(const GrowthColumns& columns, size_t n);
+void updateResourceLanes(double popFactor, double techFactor,
+                         const double* productionRate, const double* consumptionRate,
+                         const double* productionMultiplier, const double* consumptionMultiplier,
+                         double* production, double* consumption, double* amount);
+void moveSettlers(const SettlerColumns& columns, size_t n);
+} // namespace avx2
+#endif
+
+#ifdef INTSIM_SIMD_AVX512
+namespace avx512 {
+void updateResources(const ResourceColumns& columns, size_t n);
+void growPopulation(const GrowthColumns& columns, size_t n);
+void moveSettlers(const SettlerColumns& columns, size_t n);
+} // namespace avx512
+#endif
+
+} // namespace civ::simd
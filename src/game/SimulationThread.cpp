@@ -0,0 +1,51 @@
+#include "game/SimulationThread.h"
+#include "core/Logger.h"
+#include "core/Utils.h"
+
+namespace civ {
+
+SimulationThread::SimulationThread()
+    : m_worker([this] { run(); }) {}
+
+SimulationThread::~SimulationThread() {
+    m_jobs.close();
+    m_results.close();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void SimulationThread::speculate(uint64_t version, const Civilization& civ, const EventSystem& events) {
+    m_jobs.push(Job{ version, civ, events, Utils::getRandomState() });
+}
+
+void SimulationThread::run() {
+    Logger::setThreadMuted(true);
+
+    Job job;
+    while (m_jobs.waitPop(job)) {
+        // Only the newest state matters; older jobs were superseded before they started
+        while (m_jobs.tryPop(job)) {}
+        m_results.push(play(job));
+    }
+}
+
+TurnPrediction SimulationThread::play(Job& job) {
+    TurnPrediction prediction;
+    prediction.version = job.version;
+
+    Civilization quiet = job.civ;
+    quiet.processTurn();
+    prediction.forecast = CivSnapshot::capture(quiet);
+
+    // Same steps as GameEngine::processTurn, with the draws on the job's generator
+    Utils::setThreadGenerator(&job.random);
+    prediction.event = job.events.generateEvent(job.civ);
+    Utils::setThreadGenerator(nullptr);
+
+    job.civ.applyEvent(prediction.event);
+    job.civ.processTurn();
+    prediction.civ = std::move(job.civ);
+    prediction.random = job.random;
+    return prediction;
+}
+
+} // namespace civ
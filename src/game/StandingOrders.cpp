@@ -0,0 +1,37 @@
+#include "game/StandingOrders.h"
+#include "game/Civilization.h"
+#include <algorithm>
+
+namespace civ {
+
+void StandingOrders::setInvestment(TechBranch branch, double share) {
+    m_investBranch = branch;
+    m_investShare = std::clamp(share, 0.0, 1.0);
+}
+
+void StandingOrders::execute(Civilization& civ, OrdersReport& report) const {
+    if (hasInvestment()) {
+        double money = civ.getResources().getResource(ResourceType::Money);
+        if (money > 0) {
+            double amount = money * m_investShare;
+            civ.getResources().removeResource(ResourceType::Money, amount);
+            civ.getTech().investInBranch(m_investBranch, amount);
+            report.invested += amount;
+        }
+    }
+
+    if (m_autoResearch) {
+        const Technology* cheapest = civ.getTech().getCheapestAvailable();
+        double money = civ.getResources().getResource(ResourceType::Money);
+        if (cheapest && money >= cheapest->cost) {
+            std::string name = cheapest->name;
+            civ.getResources().removeResource(ResourceType::Money, cheapest->cost);
+            report.researchSpent += cheapest->cost;
+            if (civ.getTech().researchTech(name)) {
+                report.researched.push_back(std::move(name));
+            }
+        }
+    }
+}
+
+} // namespace civ
@@ -55,6 +55,24 @@ void TechnologyTree::initTechnologies() {
         {u8"Лунная колония",      TechBranch::Space, 17, 800, u8"База на Луне (+Материалы)"},
         {u8"Межзвёздный двигатель", TechBranch::Space, 20, 1000, u8"Путь к звездам (ПОБЕДА)"},
     };
+    // Both lists fit every technology, so rebuilding them never allocates
+    m_availableIds.reserve(m_technologies.size());
+    m_researchedIds.reserve(m_technologies.size());
+    rebuildLists();
+}
+
+void TechnologyTree::rebuildLists() {
+    m_availableIds.clear();
+    m_researchedIds.clear();
+    for (size_t i = 0; i < m_technologies.size(); ++i) {
+        const Technology& tech = m_technologies[i];
+        if (tech.researched) {
+            m_researchedIds.push_back(static_cast<TechId>(i));
+        } else if (m_branchLevels[static_cast<size_t>(tech.branch)] >= tech.level) {
+            m_availableIds.push_back(static_cast<TechId>(i));
+        }
+    }
+    m_listVersion++;
 }
 
 void TechnologyTree::investInBranch(TechBranch branch, double amount) {
@@ -67,6 +85,7 @@ void TechnologyTree::investInBranch(TechBranch branch, double amount) {
 
 void TechnologyTree::checkLevelUp(TechBranch branch) {
     size_t idx = static_cast<size_t>(branch);
+    int startLevel = m_branchLevels[idx];
     while (m_branchLevels[idx] < MAX_BRANCH_LEVEL) {
         double threshold = levelUpThreshold(m_branchLevels[idx]);
         if (m_branchProgress[idx] >= threshold) {
@@ -76,10 +95,28 @@ void TechnologyTree::checkLevelUp(TechBranch branch) {
             break;
         }
     }
+    // Progress alone changes no list; a new level may unlock technologies
+    if (m_branchLevels[idx] != startLevel) {
+        rebuildLists();
+    }
 }
 
-double TechnologyTree::levelUpThreshold(int currentLevel) const {
-    return 50.0 + currentLevel * 30.0 + std::pow(currentLevel, 1.5) * 10.0;
+double TechnologyTree::levelUpThreshold(int currentLevel) {
+    auto formula = [](int level) {
+        return 50.0 + level * 30.0 + std::pow(level, 1.5) * 10.0;
+    };
+    // Every reachable level is tabulated once; std::pow dominated investInBranch
+    static const auto table = [&formula] {
+        std::array<double, MAX_BRANCH_LEVEL + 1> values{};
+        for (int level = 0; level <= MAX_BRANCH_LEVEL; ++level) {
+            values[static_cast<size_t>(level)] = formula(level);
+        }
+        return values;
+    }();
+    if (currentLevel >= 0 && currentLevel <= MAX_BRANCH_LEVEL) {
+        return table[static_cast<size_t>(currentLevel)];
+    }
+    return formula(currentLevel);
 }
 
 int TechnologyTree::getBranchLevel(TechBranch branch) const {
@@ -103,7 +140,10 @@ double TechnologyTree::getBranchThreshold(TechBranch branch) const {
 }
 
 Era TechnologyTree::getCurrentEra() const {
-    int level = getOverallTechLevel();
+    return eraForTechLevel(getOverallTechLevel());
+}
+
+Era TechnologyTree::eraForTechLevel(int level) {
     if (level >= 90) return Era::Space;
     if (level >= 75) return Era::Information;
     if (level >= 60) return Era::Modern;
@@ -115,44 +155,61 @@ Era TechnologyTree::getCurrentEra() const {
     return Era::StoneAge;
 }
 
+bool TechnologyTree::isAvailable(TechId id) const {
+    if (id >= m_technologies.size()) return false;
+    const Technology& tech = m_technologies[id];
+    return !tech.researched && m_branchLevels[static_cast<size_t>(tech.branch)] >= tech.level;
+}
+
+const Technology* TechnologyTree::getCheapestAvailable() const {
+    const Technology* cheapest = nullptr;
+    for (TechId id : m_availableIds) {
+        const Technology& tech = m_technologies[id];
+        if (!cheapest || tech.cost < cheapest->cost) cheapest = &tech;
+    }
+    return cheapest;
+}
+
 std::vector<const Technology*> TechnologyTree::getAvailableTechs() const {
     std::vector<const Technology*> available;
-    for (const auto& tech : m_technologies) {
-        if (!tech.researched) {
-            int branchLvl = m_branchLevels[static_cast<size_t>(tech.branch)];
-            if (branchLvl >= tech.level) {
-                available.push_back(&tech);
-            }
-        }
+    available.reserve(m_availableIds.size());
+    for (TechId id : m_availableIds) {
+        available.push_back(&m_technologies[id]);
     }
     return available;
 }
 
 std::vector<const Technology*> TechnologyTree::getResearchedTechs() const {
     std::vector<const Technology*> researched;
-    for (const auto& tech : m_technologies) {
-        if (tech.researched) {
-            researched.push_back(&tech);
-        }
+    researched.reserve(m_researchedIds.size());
+    for (TechId id : m_researchedIds) {
+        researched.push_back(&m_technologies[id]);
     }
     return researched;
 }
 
+bool TechnologyTree::researchTech(TechId id) {
+    if (!isAvailable(id)) return false;
+    m_technologies[id].researched = true;
+    rebuildLists();
+    return true;
+}
+
 bool TechnologyTree::researchTech(const std::string& techName) {
-    for (auto& tech : m_technologies) {
-        if (tech.name == techName && !tech.researched) {
-            int branchLvl = m_branchLevels[static_cast<size_t>(tech.branch)];
-            if (branchLvl >= tech.level) {
-                tech.researched = true;
-                return true;
-            }
+    for (TechId id : m_availableIds) {
+        if (m_technologies[id].name == techName) {
+            return researchTech(id);
         }
     }
     return false;
 }
 
 double TechnologyTree::getProductionBonus() const {
-    return 1.0 + getBranchLevel(TechBranch::Industry) * 0.05;
+    return productionBonusForLevel(getBranchLevel(TechBranch::Industry));
+}
+
+double TechnologyTree::productionBonusForLevel(int industryLevel) {
+    return 1.0 + industryLevel * 0.05;
 }
 
 double TechnologyTree::getMilitaryBonus() const {
@@ -191,6 +248,7 @@ void TechnologyTree::deserialize(const std::string& data) {
         iss >> researched;
         m_technologies[i].researched = (researched != 0);
     }
+    rebuildLists();
 }
 
 std::string TechnologyTree::getStatusString() const {
@@ -199,17 +257,30 @@ std::string TechnologyTree::getStatusString() const {
         << u8" | Общий уровень: " << getOverallTechLevel()
         << "/" << TECH_LEVEL_MAX << "\n";
 
+    char name[64];
+    char number[Utils::NUMBER_BUFFER_SIZE];
+    char level[Utils::NUMBER_BUFFER_SIZE];
+    char bar[32];
+    char progress[Utils::DOUBLE_BUFFER_SIZE];
+    char threshold[Utils::DOUBLE_BUFFER_SIZE];
     for (size_t i = 0; i < NUM_BRANCHES; ++i) {
         auto branch = static_cast<TechBranch>(i);
-        std::string name = techBranchToString(branch);
-        int level = m_branchLevels[i];
-        double progress = m_branchProgress[i];
-        double threshold = levelUpThreshold(level);
-
-        oss << "  " << Utils::padRight(name, 16) << " Ур."
-            << Utils::padLeft(std::to_string(level), 3)
-            << " " << Utils::progressBar(progress, threshold, 15)
-            << " " << Utils::formatDouble(progress, 0) << "/" << Utils::formatDouble(threshold, 0)
+        double branchProgress = m_branchProgress[i];
+        double branchThreshold = levelUpThreshold(m_branchLevels[i]);
+
+        size_t nameLen = Utils::padRightTo(name, sizeof(name), techBranchToString(branch), 16);
+        size_t numberLen = Utils::formatNumberTo(number, sizeof(number), m_branchLevels[i]);
+        size_t levelLen = Utils::padLeftTo(level, sizeof(level),
+                                           std::string_view(number, numberLen), 3);
+        size_t barLen = Utils::progressBarTo(bar, sizeof(bar), branchProgress, branchThreshold, 15);
+        size_t progressLen = Utils::formatDoubleTo(progress, sizeof(progress), branchProgress, 0);
+        size_t thresholdLen = Utils::formatDoubleTo(threshold, sizeof(threshold), branchThreshold, 0);
+
+        oss << "  " << std::string_view(name, nameLen) << " Ур."
+            << std::string_view(level, levelLen)
+            << " " << std::string_view(bar, barLen)
+            << " " << std::string_view(progress, progressLen)
+            << "/" << std::string_view(threshold, thresholdLen)
             << "\n";
     }
     return oss.str();
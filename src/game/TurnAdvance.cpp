@@ -0,0 +1,73 @@
+#include "game/TurnAdvance.h"
+#include "game/Civilization.h"
+#include "game/FastForward.h"
+#include "core/Profiler.h"
+
+namespace civ {
+
+CivSnapshot CivSnapshot::capture(const Civilization& civ) {
+    CivSnapshot snapshot;
+    snapshot.turn = civ.getTurn();
+    snapshot.era = civ.getCurrentEra();
+    snapshot.population = civ.getPopulation();
+    snapshot.happiness = civ.getHappiness();
+    snapshot.ecology = civ.getEcology();
+    snapshot.military = civ.getMilitary();
+    snapshot.techLevel = civ.getTech().getOverallTechLevel();
+    for (size_t r = 0; r < snapshot.resources.size(); ++r) {
+        snapshot.resources[r] = civ.getResources().getResource(static_cast<ResourceType>(r));
+    }
+    return snapshot;
+}
+
+TurnSummary TurnAdvance::run(Civilization& civ, EventSystem& events,
+                             const StandingOrders& orders, int turns) {
+    TurnSummary summary;
+    summary.before = CivSnapshot::capture(civ);
+    auto afterTurn = [&orders, &summary](Civilization& c) { orders.execute(c, summary.orders); };
+
+    while (summary.turnsPlayed < turns) {
+        FastForwardResult skipped = FastForward::skipQuietTurns(
+            civ, events, turns - summary.turnsPlayed, true, afterTurn);
+        summary.turnsPlayed += skipped.quietTurns;
+        summary.quietYears += skipped.quietTurns;
+
+        if (skipped.stop == FastForwardStop::TurnLimit ||
+            skipped.stop == FastForwardStop::GameOver) {
+            break;
+        }
+        if (skipped.stop == FastForwardStop::EraChange) {
+            continue;
+        }
+
+        GameEvent event;
+        {
+            CIV_TRACE_TURN(civ.getTurn() + 1);
+            CIV_PROFILE_SCOPE(Turn);
+            if (skipped.stop == FastForwardStop::Event) {
+                event = std::move(skipped.event);
+            } else {
+                CIV_PROFILE_SCOPE(GenerateEvent);
+                event = events.generateEvent(civ);
+            }
+            events.recordEvent(event);
+            civ.applyEvent(event);
+            civ.processTurn();
+        }
+        afterTurn(civ);
+        summary.turnsPlayed++;
+        if (skipped.stop == FastForwardStop::NoEvents) {
+            summary.quietYears++;   // generateEvent's fallback in an era without events
+        } else {
+            summary.events.push_back(std::move(event));
+        }
+
+        if (civ.checkGameResult() != GameResult::InProgress) break;
+    }
+
+    summary.after = CivSnapshot::capture(civ);
+    summary.result = civ.checkGameResult();
+    return summary;
+}
+
+} // namespace civ
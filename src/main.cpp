@@ -1,7 +1,9 @@
 #include "game/GameEngine.h"
 #include "core/ColorOutput.h"
 #include <iostream>
+#include <fstream>
 #include <exception>
+#include <string>
 
 /**
  * @brief Civilization Evolution Simulator
@@ -11,10 +13,35 @@
  * technology research, and surviving random events.
  * 
  * Built with C++17, following SOLID principles and clean architecture.
+ *
+ * With --script <file> (or - for standard input) the game plays a command
+ * script instead of the keyboard and prints per-command timings.
  */
-int main() {
+int main(int argc, char** argv) {
+    std::string scriptPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--script" && i + 1 < argc) {
+            scriptPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--script <file>|-]\n";
+            return 2;
+        }
+    }
+
     try {
         civ::GameEngine engine;
+        if (!scriptPath.empty()) {
+            if (scriptPath == "-") {
+                return engine.runScript(std::cin, std::cout);
+            }
+            std::ifstream script(scriptPath);
+            if (!script) {
+                std::cerr << "Cannot open script: " << scriptPath << std::endl;
+                return 2;
+            }
+            return engine.runScript(script, std::cout);
+        }
         engine.run();
         return 0;
     }
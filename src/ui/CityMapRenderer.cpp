@@ -0,0 +1,102 @@
+#include "ui/CityMapRenderer.h"
+#include "game/CityModel.h"
+#include "game/SettlerSystem.h"
+
+namespace civ {
+
+namespace {
+
+// Layers, drawn bottom to top
+constexpr uint8_t LAYER_GROUND = 0;
+constexpr uint8_t LAYER_SETTLERS = 1;
+constexpr uint8_t LAYER_WALLS = 2;
+constexpr uint8_t LAYER_ROOFS = 3;
+constexpr uint8_t LAYER_HUD = 4;
+constexpr uint8_t LAYER_HUD_ITEMS = 5;
+constexpr uint8_t LAYER_HUD_MARKS = 6;   // Selection frame and colour swatches; never overlap
+
+constexpr uint32_t TOWN_HALL_COLOR = 0xC89B3C;   // C7_GOLD
+constexpr uint32_t ROOF_COLOR = 0x8B4513;
+constexpr uint32_t SETTLER_COLOR = 0xF0F0F0;
+constexpr int SETTLER_SIZE = 4;
+
+uint32_t groundColor(Era era) {
+    if (era == Era::Space) return 0x141428;        // Space dark
+    if (era >= Era::Industrial) return 0x50505A;   // Industrial grey
+    return 0x228B22;                               // Stone Age green
+}
+
+} // namespace
+
+void CityMapRenderer::resize(int width, int height) {
+    m_frame.resize(width, height);
+}
+
+int CityMapRenderer::hudItemLeft(int defIndex, Era era) {
+    const auto& defs = CityModel::getBuildingDefs();
+    if (defIndex < 0 || defIndex >= static_cast<int>(defs.size()) || era < defs[defIndex].minEra) return -1;
+    int left = HUD_ITEM_LEFT;
+    for (int i = 0; i < defIndex; ++i) {
+        if (era >= defs[i].minEra) left += HUD_ITEM_STEP;
+    }
+    return left;
+}
+
+int CityMapRenderer::hudItemAt(int x, Era era) {
+    const auto& defs = CityModel::getBuildingDefs();
+    int left = HUD_ITEM_LEFT;
+    for (int i = 0; i < static_cast<int>(defs.size()); ++i) {
+        if (era < defs[i].minEra) continue;
+        if (x >= left && x < left + HUD_ITEM_WIDTH) return i;
+        left += HUD_ITEM_STEP;
+    }
+    return -1;
+}
+
+void CityMapRenderer::recordBuilding(float x, float y, int size, uint32_t rgb) {
+    const int cx = static_cast<int>(x);
+    const int cy = static_cast<int>(y);
+    m_drawList.fillRect(LAYER_WALLS, cx - size, cy - size, cx + size, cy + size, rgb);
+    m_drawList.fillTriangle(LAYER_ROOFS, cx, cy - size - 4, cx - size, cy - size, cx + size, cy - size, ROOF_COLOR);
+}
+
+void CityMapRenderer::render(const CityMapView& view) {
+    const int width = m_frame.getWidth();
+    const int height = m_frame.getHeight();
+    const auto& defs = CityModel::getBuildingDefs();
+    m_drawList.clear();
+
+    m_drawList.fillRect(LAYER_GROUND, 0, 0, width, height, groundColor(view.era));
+    m_drawList.fillRect(LAYER_HUD, 0, height - HUD_HEIGHT, width, height, 0x282832);
+
+    if (view.settlers) {
+        m_drawList.dots(LAYER_SETTLERS, view.settlers->getX(), view.settlers->getY(),
+                        view.settlers->size(), SETTLER_SIZE, SETTLER_COLOR);
+    }
+
+    if (view.city && view.city->isFounded()) {
+        recordBuilding(view.city->getCenterX(), view.city->getCenterY(), 8, TOWN_HALL_COLOR);
+        for (const Building& building : view.city->getBuildings()) {
+            recordBuilding(building.x, building.y, 5, defs[building.def].color);
+        }
+    }
+
+    // HUD buttons with a colour swatch each; the front end writes the names
+    const int top = height - HUD_HEIGHT + 5;
+    for (int i = 0; i < static_cast<int>(defs.size()); ++i) {
+        int left = hudItemLeft(i, view.era);
+        if (left < 0) continue;
+        const bool selected = i == view.selectedBuilding;
+        m_drawList.fillRect(LAYER_HUD_ITEMS, left, top, left + HUD_ITEM_WIDTH, top + HUD_ITEM_HEIGHT,
+                            selected ? 0x505064 : 0x3C3C46);
+        if (selected) {
+            m_drawList.frameRect(LAYER_HUD_MARKS, left, top, left + HUD_ITEM_WIDTH, top + HUD_ITEM_HEIGHT, 0xFFFFFF);
+        }
+        m_drawList.fillRect(LAYER_HUD_MARKS, left + 5, top + 5, left + 25, top + 25, defs[i].color);
+    }
+
+    m_drawList.sort();
+    m_drawList.rasterize(m_frame);
+}
+
+} // namespace civ
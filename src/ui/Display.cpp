@@ -1,8 +1,11 @@
 #include "ui/Display.h"
+#include "ui/InputHandler.h"
 #include "core/ColorOutput.h"
 #include "core/Utils.h"
+#include "core/Profiler.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 namespace civ {
 
@@ -14,9 +17,12 @@ void Display::clearScreen() const {
 #endif
 }
 
+void Display::resetView() {
+    m_view.invalidate();
+}
+
 void Display::waitForInput() const {
-    std::cout << "\n" << ColorOutput::dim(u8"Нажмите Enter для продолжения...") << std::flush;
-    std::cin.ignore(10000, '\n');
+    InputHandler::waitForKey();
 }
 
 void Display::showSeparator(int width) const {
@@ -57,22 +63,37 @@ void Display::showDifficultyMenu() const {
     std::cout << "  " << ColorOutput::magenta("[4]") << u8" Кошмар    - Экстремальный вызов\n\n";
 }
 
-void Display::showGameStatus(const Civilization& civ) const {
+void Display::showGameStatus(const Civilization& civ, const EventSystem& events) {
+    CIV_PROFILE_SCOPE(Rendering);
+    ViewChanges changes = m_view.update(civ, events);
+    if (changes.any(ViewChange::Game | ViewChange::Turn | ViewChange::Era)) {
+        m_headerText = ColorOutput::bold(ColorOutput::cyan(
+            "  " + civ.getName() + u8" | Ход: " + std::to_string(civ.getTurn()) +
+            u8" | Эпоха: " + eraToString(civ.getCurrentEra())
+        ));
+    }
+    if (changes.any(ViewChange::Civ)) {
+        m_civText = civ.getStatusString();
+    }
+    if (changes.any(ViewChange::Resources | ViewChange::Income)) {
+        m_resourceText = civ.getResources().getStatusString();
+    }
+    if (changes.any(ViewChange::Tech)) {
+        m_techText = civ.getTech().getStatusString();
+    }
+
     showDoubleSeparator(60);
-    std::cout << ColorOutput::bold(ColorOutput::cyan(
-        "  " + civ.getName() + u8" | Ход: " + std::to_string(civ.getTurn()) +
-        u8" | Эпоха: " + eraToString(civ.getCurrentEra())
-    )) << "\n";
+    std::cout << m_headerText << "\n";
     showDoubleSeparator(60);
 
     std::cout << ColorOutput::bold(u8"\n  --- Цивилизация ---\n");
-    std::cout << civ.getStatusString();
+    std::cout << m_civText;
 
     std::cout << ColorOutput::bold(u8"\n  --- Ресурсы ---\n");
-    std::cout << civ.getResources().getStatusString();
+    std::cout << m_resourceText;
 
     std::cout << ColorOutput::bold(u8"\n  --- Технологии ---\n");
-    std::cout << civ.getTech().getStatusString();
+    std::cout << m_techText;
 
     showSeparator(60);
 }
@@ -83,26 +104,29 @@ void Display::showResourcePanel(const Civilization& civ) const {
 }
 
 void Display::showTechTree(const Civilization& civ) const {
+    CIV_PROFILE_SCOPE(Rendering);
     std::cout << ColorOutput::bold(u8"\n  === ДЕРЕВО ТЕХНОЛОГИЙ ===\n\n");
-    std::cout << civ.getTech().getStatusString();
+    const TechnologyTree& tree = civ.getTech();
+    std::cout << tree.getStatusString();
 
-    auto available = civ.getTech().getAvailableTechs();
+    const auto& available = tree.getAvailableIds();
     if (!available.empty()) {
         std::cout << ColorOutput::bold(u8"\n  Доступные технологии:\n");
         for (size_t i = 0; i < available.size(); ++i) {
+            const Technology& tech = tree.getTechnology(available[i]);
             std::cout << "  " << ColorOutput::green("[" + std::to_string(i + 1) + "]")
-                      << " " << available[i]->name
-                      << " (" << techBranchToString(available[i]->branch)
-                      << u8", Цена: " << available[i]->cost << ")"
-                      << " - " << ColorOutput::dim(available[i]->description) << "\n";
+                      << " " << tech.name
+                      << " (" << techBranchToString(tech.branch)
+                      << u8", Цена: " << tech.cost << ")"
+                      << " - " << ColorOutput::dim(tech.description) << "\n";
         }
     }
 
-    auto researched = civ.getTech().getResearchedTechs();
+    const auto& researched = tree.getResearchedIds();
     if (!researched.empty()) {
         std::cout << ColorOutput::bold(u8"\n  Исследовано:\n");
-        for (const auto* tech : researched) {
-            std::cout << "  " << ColorOutput::dim("[x] " + tech->name) << "\n";
+        for (TechId id : researched) {
+            std::cout << "  " << ColorOutput::dim("[x] " + tree.getTechnology(id).name) << "\n";
         }
     }
 }
@@ -153,6 +177,9 @@ void Display::showEvent(const GameEvent& event) const {
     if (event.techBoost > 0) {
         std::cout << "  " << ColorOutput::green("+" + std::to_string(event.techBoost) + u8" технологии") << "\n";
     }
+    if (event.duration > 1) {
+        std::cout << "  " << ColorOutput::dim(u8"Длительность (ходов): " + std::to_string(event.duration)) << "\n";
+    }
 
     showSeparator(50);
 }
@@ -160,14 +187,16 @@ void Display::showEvent(const GameEvent& event) const {
 void Display::showTurnMenu(const Civilization& /*civ*/) const {
     std::cout << ColorOutput::bold(u8"\n  === ДЕЙСТВИЯ ===\n\n");
     std::cout << "  " << ColorOutput::green("[1]") << u8" Следующий ход\n";
-    std::cout << "  " << ColorOutput::green("[2]") << u8" Инвестировать ресурсы\n";
-    std::cout << "  " << ColorOutput::green("[3]") << u8" Исследовать технологию\n";
-    std::cout << "  " << ColorOutput::green("[4]") << u8" Полный статус\n";
-    std::cout << "  " << ColorOutput::green("[5]") << u8" Дерево технологий\n";
-    std::cout << "  " << ColorOutput::green("[6]") << u8" Журнал событий\n";
-    std::cout << "  " << ColorOutput::green("[7]") << u8" Сохранить игру\n";
-    std::cout << "  " << ColorOutput::green("[8]") << u8" Помощь\n";
-    std::cout << "  " << ColorOutput::red("[9]") << u8" Выйти в меню\n\n";
+    std::cout << "  " << ColorOutput::green("[2]") << u8" Пропустить несколько ходов\n";
+    std::cout << "  " << ColorOutput::green("[3]") << u8" Постоянные приказы\n";
+    std::cout << "  " << ColorOutput::green("[4]") << u8" Инвестировать ресурсы\n";
+    std::cout << "  " << ColorOutput::green("[5]") << u8" Исследовать технологию\n";
+    std::cout << "  " << ColorOutput::green("[6]") << u8" Полный статус\n";
+    std::cout << "  " << ColorOutput::green("[7]") << u8" Дерево технологий\n";
+    std::cout << "  " << ColorOutput::green("[8]") << u8" Журнал событий\n";
+    std::cout << "  " << ColorOutput::green("[9]") << u8" Сохранить игру\n";
+    std::cout << "  " << ColorOutput::green("[10]") << u8" Помощь\n";
+    std::cout << "  " << ColorOutput::red("[11]") << u8" Выйти в меню\n\n";
 }
 
 void Display::showInvestmentMenu(const Civilization& civ) const {
@@ -203,6 +232,102 @@ void Display::showEventLog(const EventSystem& events) const {
     }
 }
 
+void Display::showStandingOrders(const StandingOrders& orders) const {
+    std::cout << ColorOutput::bold(u8"\n  === ПОСТОЯННЫЕ ПРИКАЗЫ ===\n\n");
+    std::cout << u8"  Инвестиции:      ";
+    if (orders.hasInvestment()) {
+        std::cout << ColorOutput::green(Utils::formatDouble(orders.getInvestShare() * 100.0, 0) +
+                                        u8"% денег в " + techBranchToString(orders.getInvestBranch()));
+    } else {
+        std::cout << ColorOutput::dim(u8"нет");
+    }
+    std::cout << "\n";
+    std::cout << u8"  Автоисследование: "
+              << (orders.isAutoResearch() ? ColorOutput::green(u8"самая дешёвая доступная технология")
+                                          : ColorOutput::dim(u8"выключено"))
+              << "\n\n";
+
+    std::cout << "  " << ColorOutput::green("[1]") << u8" Задать инвестиции\n";
+    std::cout << "  " << ColorOutput::green("[2]") << u8" Отменить инвестиции\n";
+    std::cout << "  " << ColorOutput::green("[3]") << u8" Вкл/выкл автоисследование\n";
+    std::cout << "  " << ColorOutput::red("[0]") << u8" Назад\n\n";
+}
+
+void Display::showTurnSummary(const TurnSummary& summary) const {
+    const CivSnapshot& before = summary.before;
+    const CivSnapshot& after = summary.after;
+
+    std::cout << ColorOutput::bold(ColorOutput::cyan(
+        u8"\n  === ИТОГИ: ХОДЫ " + std::to_string(before.turn + 1) + "-" + std::to_string(after.turn) + " ===\n\n"));
+    std::cout << u8"  Сыграно ходов: " << summary.turnsPlayed
+              << u8" (мирных лет: " << summary.quietYears << ")\n";
+    if (after.era != before.era) {
+        std::cout << "  " << ColorOutput::bold(ColorOutput::magenta(
+            u8"Эпоха: " + eraToString(before.era) + " -> " + eraToString(after.era))) << "\n";
+    }
+    std::cout << "\n";
+
+    if (!summary.events.empty()) {
+        // Each distinct event once, with how often it happened, in order of first occurrence
+        std::vector<std::pair<const GameEvent*, int>> counts;
+        for (const auto& e : summary.events) {
+            auto it = std::find_if(counts.begin(), counts.end(),
+                                   [&e](const auto& entry) { return entry.first->name == e.name; });
+            if (it != counts.end()) {
+                it->second++;
+            } else {
+                counts.emplace_back(&e, 1);
+            }
+        }
+
+        std::cout << ColorOutput::bold(u8"  События (" + std::to_string(summary.events.size()) + "):\n");
+        for (const auto& [event, count] : counts) {
+            std::cout << "  " << Utils::padLeft(std::to_string(count), 3) << " x "
+                      << Utils::padRight(eventTypeToString(event->type), 24) << " " << event->name << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << ColorOutput::bold(u8"  Изменения:\n");
+    showDelta(u8"Население", before.population, after.population, 0);
+    showDelta(u8"Счастье", before.happiness, after.happiness);
+    showDelta(u8"Экология", before.ecology, after.ecology);
+    showDelta(u8"Армия", before.military, after.military);
+    showDelta(u8"Технологии", before.techLevel, after.techLevel, 0);
+    for (size_t r = 0; r < before.resources.size(); ++r) {
+        showDelta(resourceTypeToString(static_cast<ResourceType>(r)),
+                  before.resources[r], after.resources[r], 0);
+    }
+
+    const OrdersReport& orders = summary.orders;
+    if (orders.invested > 0 || orders.researchSpent > 0) {
+        std::cout << ColorOutput::bold(u8"\n  Приказы:\n");
+        if (orders.invested > 0) {
+            std::cout << u8"  Инвестировано: " << Utils::formatDouble(orders.invested, 0) << "\n";
+        }
+        for (const auto& name : orders.researched) {
+            std::cout << "  " << ColorOutput::success(u8"Исследовано: " + name) << "\n";
+        }
+    }
+
+    if (summary.result != GameResult::InProgress) {
+        std::cout << "\n  " << ColorOutput::bold(gameResultToString(summary.result)) << "\n";
+    }
+    showSeparator(50);
+}
+
+void Display::showForecast(const Civilization& civ, const CivSnapshot& forecast) const {
+    CivSnapshot now = CivSnapshot::capture(civ);
+    std::cout << ColorOutput::bold(u8"\n  Прогноз на следующий ход (без событий):\n");
+    showDelta(u8"Население", now.population, forecast.population, 0);
+    showDelta(u8"Счастье", now.happiness, forecast.happiness);
+    showDelta(u8"Экология", now.ecology, forecast.ecology);
+    for (size_t r = 0; r < now.resources.size(); ++r) {
+        showDelta(resourceTypeToString(static_cast<ResourceType>(r)),
+                  now.resources[r], forecast.resources[r], 0);
+    }
+}
+
 void Display::showVictory(GameResult result) const {
     clearScreen();
     std::cout << ColorOutput::green(
@@ -253,7 +378,8 @@ void Display::showHelp() const {
     std::cout << u8"  - Наука помогает экологии, Промышленность вредит\n";
     std::cout << u8"  - Медицина улучшает рост населения\n";
     std::cout << u8"  - Поддерживайте высокое счастье для лучшего роста\n";
-    std::cout << u8"  - Случайные события могут помочь или навредить!\n\n";
+    std::cout << u8"  - Случайные события могут помочь или навредить!\n";
+    std::cout << u8"  - Постоянные приказы выполняются каждый ход, в том числе при пропуске ходов\n\n";
 }
 
 void Display::showEraArt(Era era) const {
@@ -312,4 +438,14 @@ void Display::showBar(const std::string& label, double value, double maxVal,
               << " " << Utils::formatDouble(value) << "/" << Utils::formatDouble(maxVal) << "\n";
 }
 
+void Display::showDelta(const std::string& label, double before, double after, int precision) const {
+    double delta = after - before;
+    std::string change = (delta >= 0 ? "+" : "") + Utils::formatDouble(delta, precision);
+    std::cout << "  " << Utils::padRight(label, 14) << ": "
+              << Utils::padLeft(Utils::formatDouble(before, precision), 10) << " -> "
+              << Utils::padLeft(Utils::formatDouble(after, precision), 10) << "  "
+              << (delta < 0 ? ColorOutput::red(change) : delta > 0 ? ColorOutput::green(change) : ColorOutput::dim(change))
+              << "\n";
+}
+
 } // namespace civ
@@ -0,0 +1,96 @@
+#include "ui/DrawList.h"
+#include "core/Profiler.h"
+#include "ui/Framebuffer.h"
+#include <algorithm>
+
+namespace civ {
+
+DrawCommand& DrawList::record(uint8_t layer, DrawKind kind, uint32_t rgb) {
+    // layer:8 | kind:8 | colour:24 | order:24, so sorting the keys groups
+    // styles within a layer and keeps recording order inside a style
+    DrawCommand& command = m_commands.emplace_back();
+    const uint64_t order = (m_commands.size() - 1) & (MAX_COMMANDS - 1);
+    command.key = uint64_t(layer) << 56 | uint64_t(kind) << 48 | uint64_t(rgb & 0xFFFFFF) << 24 | order;
+    command.kind = kind;
+    command.color = rgb & 0xFFFFFF;
+    return command;
+}
+
+void DrawList::fillRect(uint8_t layer, int x0, int y0, int x1, int y1, uint32_t rgb) {
+    DrawCommand& command = record(layer, DrawKind::FillRect, rgb);
+    command.x0 = x0;
+    command.y0 = y0;
+    command.x1 = x1;
+    command.y1 = y1;
+}
+
+void DrawList::frameRect(uint8_t layer, int x0, int y0, int x1, int y1, uint32_t rgb) {
+    DrawCommand& command = record(layer, DrawKind::FrameRect, rgb);
+    command.x0 = x0;
+    command.y0 = y0;
+    command.x1 = x1;
+    command.y1 = y1;
+}
+
+void DrawList::fillTriangle(uint8_t layer, int x0, int y0, int x1, int y1, int x2, int y2, uint32_t rgb) {
+    DrawCommand& command = record(layer, DrawKind::FillTriangle, rgb);
+    command.x0 = x0;
+    command.y0 = y0;
+    command.x1 = x1;
+    command.y1 = y1;
+    command.x2 = x2;
+    command.y2 = y2;
+}
+
+void DrawList::dots(uint8_t layer, const float* xs, const float* ys, size_t count, int size, uint32_t rgb) {
+    if (count == 0) return;
+    DrawCommand& command = record(layer, DrawKind::Dots, rgb);
+    command.xs = xs;
+    command.ys = ys;
+    command.count = count;
+    command.x0 = size;
+}
+
+void DrawList::sort() {
+    // Keys are unique, so an unstable sort keeps recording order within a style
+    std::sort(m_commands.begin(), m_commands.end(),
+              [](const DrawCommand& a, const DrawCommand& b) { return a.key < b.key; });
+}
+
+size_t DrawList::countBatches() const {
+    size_t batches = 0;
+    for (size_t i = 0; i < m_commands.size(); ++i) {
+        if (i == 0 || styleOf(m_commands[i]) != styleOf(m_commands[i - 1])) ++batches;
+    }
+    return batches;
+}
+
+void DrawList::rasterize(Framebuffer& target) const {
+    CIV_PROFILE_SCOPE(Rendering);
+    for (const DrawCommand& command : m_commands) {
+        switch (command.kind) {
+            case DrawKind::FillRect:
+                target.fillRect(command.x0, command.y0, command.x1, command.y1, command.color);
+                break;
+            case DrawKind::FrameRect:
+                target.frameRect(command.x0, command.y0, command.x1, command.y1, command.color);
+                break;
+            case DrawKind::FillTriangle:
+                target.fillTriangle(command.x0, command.y0, command.x1, command.y1,
+                                    command.x2, command.y2, command.color);
+                break;
+            case DrawKind::Dots: {
+                const int size = command.x0;
+                const int half = size / 2;
+                for (size_t i = 0; i < command.count; ++i) {
+                    int x = static_cast<int>(command.xs[i]) - half;
+                    int y = static_cast<int>(command.ys[i]) - half;
+                    target.fillRect(x, y, x + size, y + size, command.color);
+                }
+                break;
+            }
+        }
+    }
+}
+
+} // namespace civ
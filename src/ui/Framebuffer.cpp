@@ -0,0 +1,102 @@
+#include "ui/Framebuffer.h"
+#include <algorithm>
+#include <fstream>
+
+namespace civ {
+
+namespace {
+
+constexpr uint32_t ALPHA_OPAQUE = 0xFF000000u;
+
+// Twice the signed area of (a, b, p), with p at a pixel centre: coordinates
+// are doubled so the half-pixel offset stays integral
+inline int64_t edge(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+} // namespace
+
+void Framebuffer::resize(int width, int height) {
+    m_width = std::max(0, width);
+    m_height = std::max(0, height);
+    m_pixels.resize(static_cast<size_t>(m_width) * static_cast<size_t>(m_height));
+}
+
+void Framebuffer::clear(uint32_t rgb) {
+    std::fill(m_pixels.begin(), m_pixels.end(), rgb | ALPHA_OPAQUE);
+}
+
+void Framebuffer::fillRect(int x0, int y0, int x1, int y1, uint32_t rgb) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, m_width);
+    y1 = std::min(y1, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const uint32_t value = rgb | ALPHA_OPAQUE;
+    for (int y = y0; y < y1; ++y) {
+        uint32_t* row = m_pixels.data() + static_cast<size_t>(y) * m_width;
+        std::fill(row + x0, row + x1, value);
+    }
+}
+
+void Framebuffer::frameRect(int x0, int y0, int x1, int y1, uint32_t rgb) {
+    if (x0 >= x1 || y0 >= y1) return;
+    fillRect(x0, y0, x1, y0 + 1, rgb);
+    fillRect(x0, y1 - 1, x1, y1, rgb);
+    fillRect(x0, y0 + 1, x0 + 1, y1 - 1, rgb);
+    fillRect(x1 - 1, y0 + 1, x1, y1 - 1, rgb);
+}
+
+void Framebuffer::fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint32_t rgb) {
+    // Wind counter-clockwise in doubled coordinates so inside is edge() >= 0
+    int64_t ax = 2 * int64_t(x0), ay = 2 * int64_t(y0);
+    int64_t bx = 2 * int64_t(x1), by = 2 * int64_t(y1);
+    int64_t cx = 2 * int64_t(x2), cy = 2 * int64_t(y2);
+    int64_t area = edge(ax, ay, bx, by, cx, cy);
+    if (area == 0) return;
+    if (area < 0) {
+        std::swap(bx, cx);
+        std::swap(by, cy);
+    }
+
+    const int minX = std::max(0, std::min({ x0, x1, x2 }));
+    const int maxX = std::min(m_width - 1, std::max({ x0, x1, x2 }));
+    const int minY = std::max(0, std::min({ y0, y1, y2 }));
+    const int maxY = std::min(m_height - 1, std::max({ y0, y1, y2 }));
+    const uint32_t value = rgb | ALPHA_OPAQUE;
+    for (int y = minY; y <= maxY; ++y) {
+        const int64_t py = 2 * int64_t(y) + 1;
+        uint32_t* row = m_pixels.data() + static_cast<size_t>(y) * m_width;
+        for (int x = minX; x <= maxX; ++x) {
+            const int64_t px = 2 * int64_t(x) + 1;
+            if (edge(ax, ay, bx, by, px, py) >= 0 && edge(bx, by, cx, cy, px, py) >= 0 &&
+                edge(cx, cy, ax, ay, px, py) >= 0) {
+                row[x] = value;
+            }
+        }
+    }
+}
+
+void Framebuffer::writePpm(std::ostream& out) const {
+    out << "P6\n" << m_width << " " << m_height << "\n255\n";
+    std::vector<char> row(static_cast<size_t>(m_width) * 3);
+    for (int y = 0; y < m_height; ++y) {
+        const uint32_t* pixels = m_pixels.data() + static_cast<size_t>(y) * m_width;
+        for (int x = 0; x < m_width; ++x) {
+            row[3 * x] = static_cast<char>((pixels[x] >> 16) & 0xFF);
+            row[3 * x + 1] = static_cast<char>((pixels[x] >> 8) & 0xFF);
+            row[3 * x + 2] = static_cast<char>(pixels[x] & 0xFF);
+        }
+        out.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+}
+
+bool Framebuffer::writePpm(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    writePpm(out);
+    return static_cast<bool>(out);
+}
+
+} // namespace civ
@@ -0,0 +1,97 @@
+#include "ui/HeadlessRenderer.h"
+#include "core/Utils.h"
+#include "core/Profiler.h"
+#include <cstring>
+
+namespace civ {
+
+size_t HeadlessRenderer::render(const GameSnapshot& snapshot) {
+    CIV_PROFILE_SCOPE(Rendering);
+    m_length = 0;
+
+    if (!snapshot.hasGame) {
+        append(u8"  Нет активной игры\n");
+        ++m_frames;
+        return m_length;
+    }
+
+    append("  ");
+    append(snapshot.name);
+    append(u8" | Ход: ");
+    appendNumber(snapshot.turn);
+    append(u8" | Эпоха: ");
+    append(eraToString(snapshot.era));
+    append("\n");
+
+    append(u8"  Население:   ");
+    appendNumber(snapshot.population);
+    append(u8"\n  Счастье:     ");
+    appendBar(snapshot.happiness, 100.0, 20);
+    append(" ");
+    appendDouble(snapshot.happiness, 1);
+    append(u8"%\n  Экология:    ");
+    appendBar(snapshot.ecology, 100.0, 20);
+    append(" ");
+    appendDouble(snapshot.ecology, 1);
+    append(u8"%\n  Армия:       ");
+    appendDouble(snapshot.military, 1);
+    append(u8"\n  Технологии:  ");
+    appendNumber(snapshot.techLevel);
+    append("/100\n");
+
+    for (size_t r = 0; r < GameSnapshot::NUM_RESOURCES; ++r) {
+        append("  ");
+        appendPadded(resourceTypeToString(static_cast<ResourceType>(r)), 14);
+        appendDouble(snapshot.resources[r], 0);
+        append(" (");
+        if (snapshot.netIncome[r] >= 0) append("+");
+        appendDouble(snapshot.netIncome[r], 1);
+        append(u8"/ход)\n");
+    }
+
+    for (size_t b = 0; b < GameSnapshot::NUM_BRANCHES; ++b) {
+        append("  ");
+        appendPadded(techBranchToString(static_cast<TechBranch>(b)), 16);
+        append(u8"Ур.");
+        appendNumber(snapshot.branchLevels[b]);
+        append(" ");
+        appendBar(snapshot.branchProgress[b], snapshot.branchThreshold[b], 15);
+        append("\n");
+    }
+
+    for (size_t i = 0; i < snapshot.recentCount; ++i) {
+        const auto& line = snapshot.recentEvents[i];
+        append("  [");
+        appendPadded(eventTypeToString(line.type), 24);
+        append("] ");
+        append(line.name);
+        append("\n");
+    }
+
+    ++m_frames;
+    return m_length;
+}
+
+void HeadlessRenderer::append(std::string_view text) {
+    if (text.size() > FRAME_CAPACITY - m_length) return;
+    std::memcpy(m_frame.data() + m_length, text.data(), text.size());
+    m_length += text.size();
+}
+
+void HeadlessRenderer::appendNumber(int64_t value) {
+    m_length += Utils::formatNumberTo(m_frame.data() + m_length, FRAME_CAPACITY - m_length, value);
+}
+
+void HeadlessRenderer::appendDouble(double value, int precision) {
+    m_length += Utils::formatDoubleTo(m_frame.data() + m_length, FRAME_CAPACITY - m_length, value, precision);
+}
+
+void HeadlessRenderer::appendPadded(std::string_view text, size_t width) {
+    m_length += Utils::padRightTo(m_frame.data() + m_length, FRAME_CAPACITY - m_length, text, width);
+}
+
+void HeadlessRenderer::appendBar(double value, double maxValue, int width) {
+    m_length += Utils::progressBarTo(m_frame.data() + m_length, FRAME_CAPACITY - m_length, value, maxValue, width);
+}
+
+} // namespace civ
@@ -1,21 +1,50 @@
 #include "ui/InputHandler.h"
+#include "ui/LineInput.h"
 #include "core/ColorOutput.h"
 #include <iostream>
-#include <limits>
+#include <sstream>
 #include <string>
 
 namespace civ {
 
+namespace {
+std::function<void()> s_idleHandler;
+
+// Whole-line number parse: leading and trailing blanks allowed, nothing else
+template <typename T>
+bool parseNumber(const std::string& line, T& value) {
+    std::istringstream stream(line);
+    return (stream >> value) && (stream >> std::ws).eof();
+}
+} // namespace
+
+void InputHandler::setIdleHandler(std::function<void()> handler) {
+    s_idleHandler = std::move(handler);
+}
+
+std::string InputHandler::readLine() {
+    std::cout << std::flush;
+    std::string line;
+    while (true) {
+        switch (LineInput::instance().readLine(line, IDLE_TICK_MS)) {
+            case LineStatus::Line:
+                return line;
+            case LineStatus::Closed:
+                throw InputClosedError();
+            case LineStatus::Timeout:
+                if (s_idleHandler) s_idleHandler();
+                break;
+        }
+    }
+}
+
 int InputHandler::getInt(const std::string& prompt, int min, int max) {
     int value;
     while (true) {
         std::cout << "  " << ColorOutput::cyan(prompt) << " [" << min << "-" << max << "]: ";
-        if (std::cin >> value && value >= min && value <= max) {
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (parseNumber(readLine(), value) && value >= min && value <= max) {
             return value;
         }
-        std::cin.clear();
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         std::cout << "  " << ColorOutput::error(u8"Неверный ввод. Введите число от "
                   + std::to_string(min) + u8" до " + std::to_string(max) + ".") << "\n";
     }
@@ -25,28 +54,22 @@ double InputHandler::getDouble(const std::string& prompt, double min, double max
     double value;
     while (true) {
         std::cout << "  " << ColorOutput::cyan(prompt) << ": ";
-        if (std::cin >> value && value >= min && value <= max) {
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (parseNumber(readLine(), value) && value >= min && value <= max) {
             return value;
         }
-        std::cin.clear();
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         std::cout << "  " << ColorOutput::error(u8"Неверный ввод.") << "\n";
     }
 }
 
 std::string InputHandler::getString(const std::string& prompt) {
     std::cout << "  " << ColorOutput::cyan(prompt) << ": ";
-    std::string value;
-    std::getline(std::cin, value);
-    return value;
+    return readLine();
 }
 
 bool InputHandler::getYesNo(const std::string& prompt) {
     while (true) {
         std::cout << "  " << ColorOutput::cyan(prompt) << u8" (д/н): ";
-        std::string input;
-        std::getline(std::cin, input);
+        std::string input = readLine();
         if (!input.empty()) {
             char c = static_cast<char>(std::tolower(input[0]));
             if (c == 'y' || c == 'Y') return true;
@@ -69,8 +92,8 @@ int InputHandler::getMenuChoice(const std::string& prompt, int numOptions) {
 }
 
 void InputHandler::waitForKey() {
-    std::cout << "\n  " << ColorOutput::dim(u8"Нажмите Enter для продолжения...") << std::flush;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::cout << "\n  " << ColorOutput::dim(u8"Нажмите Enter для продолжения...");
+    readLine();
 }
 
 } // namespace civ
@@ -0,0 +1,82 @@
+#include "ui/LineInput.h"
+
+#ifdef _WIN32
+#include <iostream>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace civ {
+
+LineInput& LineInput::instance() {
+    static LineInput inst;
+    return inst;
+}
+
+#ifdef _WIN32
+
+LineInput::~LineInput() {
+    // The reader may be blocked in getline; it ends with the process
+    if (m_reader.joinable()) m_reader.detach();
+}
+
+LineStatus LineInput::readLine(std::string& line, int timeoutMs) {
+    if (!m_reader.joinable()) {
+        m_reader = std::thread([this] {
+            std::string text;
+            while (std::getline(std::cin, text)) {
+                if (!text.empty() && text.back() == '\r') text.pop_back();
+                m_lines.push(std::move(text));
+            }
+            m_lines.close();
+        });
+    }
+    if (m_lines.waitPop(line, std::chrono::milliseconds(timeoutMs))) return LineStatus::Line;
+    return m_lines.closed() && m_lines.empty() ? LineStatus::Closed : LineStatus::Timeout;
+}
+
+#else
+
+LineInput::~LineInput() = default;
+
+bool LineInput::takeLine(std::string& line) {
+    size_t end = m_buffer.find('\n');
+    if (end == std::string::npos) {
+        if (!m_closed || m_buffer.empty()) return false;
+        end = m_buffer.size();   // Last line without a line break
+    }
+    line.assign(m_buffer, 0, end);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    m_buffer.erase(0, end < m_buffer.size() ? end + 1 : end);
+    return true;
+}
+
+LineStatus LineInput::readLine(std::string& line, int timeoutMs) {
+    while (!takeLine(line)) {
+        if (m_closed) return LineStatus::Closed;
+
+        pollfd input{ STDIN_FILENO, POLLIN, 0 };
+        int ready = poll(&input, 1, timeoutMs);
+        if (ready == 0) return LineStatus::Timeout;
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            m_closed = true;
+            continue;
+        }
+
+        char chunk[512];
+        ssize_t count = read(STDIN_FILENO, chunk, sizeof(chunk));
+        if (count > 0) {
+            m_buffer.append(chunk, static_cast<size_t>(count));
+        } else if (count == 0 || errno != EINTR) {
+            m_closed = true;   // End of input or a read error
+        }
+    }
+    return LineStatus::Line;
+}
+
+#endif
+
+} // namespace civ
@@ -0,0 +1,325 @@
+#include "ui/ScriptRunner.h"
+#include "game/GameEngine.h"
+#include "core/Utils.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace civ {
+
+namespace {
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool parseDifficulty(const std::string& word, Difficulty& out) {
+    static const char* const KEYWORDS[] = { "easy", "normal", "hard", "nightmare" };
+    for (int d = 0; d < 4; ++d) {
+        auto difficulty = static_cast<Difficulty>(d);
+        if (toLower(word) == KEYWORDS[d] || word == difficultyToString(difficulty)) {
+            out = difficulty;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseBranch(const std::string& word, TechBranch& out) {
+    static const char* const KEYWORDS[] = { "science", "medicine", "military", "industry", "space" };
+    for (int b = 0; b < static_cast<int>(TechBranch::COUNT); ++b) {
+        auto branch = static_cast<TechBranch>(b);
+        if (toLower(word) == KEYWORDS[b] || word == techBranchToString(branch)) {
+            out = branch;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseNumber(const std::string& word, double& out) {
+    char* end = nullptr;
+    out = std::strtod(word.c_str(), &end);
+    return !word.empty() && end == word.c_str() + word.size();
+}
+
+bool parseCount(const std::string& word, int& out) {
+    double value;
+    if (!parseNumber(word, value) || value < 1 || value > 1e9 || value != static_cast<int>(value)) {
+        return false;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+std::string describe(const Civilization& civ) {
+    return "turn " + std::to_string(civ.getTurn()) +
+           ", " + eraToString(civ.getCurrentEra()) +
+           ", pop " + std::to_string(civ.getPopulation()) +
+           ", tech " + std::to_string(civ.getTech().getOverallTechLevel()) +
+           ", money " + Utils::formatDouble(civ.getResources().getResource(ResourceType::Money), 0);
+}
+
+// First `columns` code points of a UTF-8 string, with "..." if anything was cut
+std::string truncate(const std::string& text, size_t columns) {
+    if (Utils::displayWidth(text) <= columns) return text;
+    size_t kept = 0;
+    size_t end = 0;
+    while (end < text.size() && kept < columns - 3) {
+        ++end;
+        while (end < text.size() && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) ++end;
+        ++kept;
+    }
+    return text.substr(0, end) + "...";
+}
+
+} // namespace
+
+std::vector<std::string> ScriptRunner::tokenize(const std::string& line) {
+    std::vector<std::string> words;
+    std::string word;
+    bool quoted = false;
+    bool inWord = false;
+
+    for (char c : line) {
+        if (quoted) {
+            if (c == '"') {
+                quoted = false;
+            } else {
+                word += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+            inWord = true;
+        } else if (c == '#') {
+            break;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            if (inWord) words.push_back(std::move(word));
+            word.clear();
+            inWord = false;
+        } else {
+            word += c;
+            inWord = true;
+        }
+    }
+    if (inWord) words.push_back(std::move(word));
+    return words;
+}
+
+int ScriptRunner::run(std::istream& script, std::ostream& report) {
+    using Clock = std::chrono::steady_clock;
+
+    report << std::fixed << std::setprecision(3);
+    report << "line  " << Utils::padRight("command", 32) << Utils::padLeft("ms", 12) << "  result\n";
+
+    const auto started = Clock::now();
+    std::string line;
+    int lineNumber = 0;
+    int commands = 0;
+    bool failed = false;
+
+    while (!failed && std::getline(script, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::vector<std::string> args = tokenize(line);
+        if (args.empty()) continue;
+
+        std::string outcome;
+        const auto begin = Clock::now();
+        bool ok = execute(args, outcome);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+        std::string text = truncate(line.substr(line.find_first_not_of(" \t")), 32);
+        report << Utils::padLeft(std::to_string(lineNumber), 4) << "  " << Utils::padRight(text, 32)
+               << std::setw(12) << ms << "  " << (ok ? "" : "ERROR: ") << outcome << "\n";
+
+        record(toLower(args[0]), ms);
+        ++commands;
+        failed = !ok;
+    }
+
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+    writeTotals(report);
+    report << "\n" << commands << " commands in " << totalMs << " ms"
+           << (failed ? ", stopped at line " + std::to_string(lineNumber) : "") << "\n";
+    return failed ? 1 : 0;
+}
+
+bool ScriptRunner::execute(const std::vector<std::string>& args, std::string& outcome) {
+    const std::string command = toLower(args[0]);
+    const size_t argc = args.size();
+
+    if (command == "new") {
+        Difficulty difficulty;
+        if (argc < 2 || argc > 3 || !parseDifficulty(args[1], difficulty)) {
+            outcome = "usage: new <easy|normal|hard|nightmare> [\"name\"]";
+            return false;
+        }
+        std::string name = (argc == 3 && !args[2].empty()) ? args[2] : u8"Человечество";
+        m_engine.newGame(difficulty, name);
+        outcome = name + ", " + difficultyToString(difficulty);
+        return true;
+    }
+
+    if (command == "load" || command == "save") {
+        if (argc > 2) {
+            outcome = "usage: " + command + " [\"file\"]";
+            return false;
+        }
+        std::string file = (argc == 2) ? args[1] : "savegame.dat";
+        bool ok = (command == "load") ? m_engine.loadSavedGame(file) : m_engine.saveCurrentGame(file);
+        outcome = ok ? file + ": " + describe(m_engine.getCivilization()) : file + ": " + m_engine.getLastSaveError();
+        return ok;
+    }
+
+    if (command == "invest") {
+        TechBranch branch;
+        double amount;
+        if (argc != 3 || !parseBranch(args[1], branch) || !parseNumber(args[2], amount)) {
+            outcome = "usage: invest <branch> <amount>";
+            return false;
+        }
+        if (!m_engine.invest(branch, amount)) {
+            outcome = "cannot invest " + args[2] + ", money " +
+                      Utils::formatDouble(m_engine.getCivilization().getResources().getResource(ResourceType::Money), 0);
+            return false;
+        }
+        outcome = techBranchToString(branch) + " level " +
+                  std::to_string(m_engine.getCivilization().getTech().getBranchLevel(branch));
+        return true;
+    }
+
+    if (command == "research") {
+        if (argc != 2) {
+            outcome = "usage: research <\"name\"|cheapest>";
+            return false;
+        }
+        std::string name = args[1];
+        if (toLower(name) == "cheapest") {
+            const Technology* cheapest = m_engine.getCivilization().getTech().getCheapestAvailable();
+            if (!cheapest) {
+                outcome = "no technology available";
+                return false;
+            }
+            name = cheapest->name;
+        }
+        if (!m_engine.research(name)) {
+            outcome = name + " is not available or not affordable";
+            return false;
+        }
+        outcome = "researched " + name;
+        return true;
+    }
+
+    if (command == "turn") {
+        int turns = 1;
+        if (argc > 2 || (argc == 2 && !parseCount(args[1], turns))) {
+            outcome = "usage: turn [N]";
+            return false;
+        }
+        return playTurns(turns, outcome);
+    }
+
+    if (command == "advance") {
+        int turns;
+        if (argc != 2 || !parseCount(args[1], turns)) {
+            outcome = "usage: advance <N>";
+            return false;
+        }
+        if (m_engine.getResult() != GameResult::InProgress) {
+            outcome = "the game is over";
+            return false;
+        }
+        TurnSummary summary = m_engine.advanceTurns(turns);
+        outcome = std::to_string(summary.turnsPlayed) + " turns (" + std::to_string(summary.events.size()) +
+                  " events), " + describe(m_engine.getCivilization());
+        if (m_engine.getResult() != GameResult::InProgress) {
+            outcome += ", " + gameResultToString(m_engine.getResult());
+        }
+        return true;
+    }
+
+    if (command == "orders") {
+        StandingOrders& orders = m_engine.getOrders();
+        TechBranch branch;
+        double percent;
+        if (argc == 4 && toLower(args[1]) == "invest" && parseBranch(args[2], branch) &&
+            parseNumber(args[3], percent) && percent >= 0 && percent <= 100) {
+            orders.setInvestment(branch, percent / 100.0);
+        } else if (argc == 3 && toLower(args[1]) == "research" &&
+                   (toLower(args[2]) == "on" || toLower(args[2]) == "off")) {
+            orders.setAutoResearch(toLower(args[2]) == "on");
+        } else if (argc == 2 && toLower(args[1]) == "clear") {
+            orders = StandingOrders{};
+        } else {
+            outcome = "usage: orders invest <branch> <percent> | orders research <on|off> | orders clear";
+            return false;
+        }
+        outcome = (orders.hasInvestment()
+                       ? "invest " + Utils::formatDouble(orders.getInvestShare() * 100.0, 0) + "% in " +
+                             techBranchToString(orders.getInvestBranch())
+                       : std::string("no investment")) +
+                  (orders.isAutoResearch() ? ", auto-research" : "");
+        return true;
+    }
+
+    if (command == "status") {
+        if (argc != 1) {
+            outcome = "usage: status";
+            return false;
+        }
+        outcome = describe(m_engine.getCivilization());
+        return true;
+    }
+
+    outcome = "unknown command '" + args[0] + "'";
+    return false;
+}
+
+bool ScriptRunner::playTurns(int turns, std::string& outcome) {
+    if (m_engine.getResult() != GameResult::InProgress) {
+        outcome = "the game is over";
+        return false;
+    }
+
+    int played = 0;
+    while (played < turns && m_engine.getResult() == GameResult::InProgress) {
+        m_engine.playTurn();
+        played++;
+    }
+
+    outcome = std::to_string(played) + " turns, " + describe(m_engine.getCivilization());
+    if (m_engine.getResult() != GameResult::InProgress) {
+        outcome += ", " + gameResultToString(m_engine.getResult());
+    }
+    return true;
+}
+
+void ScriptRunner::record(const std::string& name, double ms) {
+    auto it = std::find_if(m_stats.begin(), m_stats.end(),
+                           [&name](const CommandStats& stats) { return stats.name == name; });
+    if (it == m_stats.end()) {
+        m_stats.push_back(CommandStats{ name });
+        it = m_stats.end() - 1;
+    }
+    it->count++;
+    it->totalMs += ms;
+    it->maxMs = std::max(it->maxMs, ms);
+}
+
+void ScriptRunner::writeTotals(std::ostream& report) const {
+    report << "\n" << Utils::padRight("command", 12) << Utils::padLeft("count", 8)
+           << Utils::padLeft("total ms", 14) << Utils::padLeft("mean ms", 12) << Utils::padLeft("max ms", 12) << "\n";
+    for (const auto& stats : m_stats) {
+        report << Utils::padRight(stats.name, 12) << std::setw(8) << stats.count
+               << std::setw(14) << stats.totalMs << std::setw(12) << stats.totalMs / stats.count
+               << std::setw(12) << stats.maxMs << "\n";
+    }
+}
+
+} // namespace civ
@@ -2,13 +2,18 @@
 
 #include "ui/Win32Gui.h"
 #include "core/Utils.h"
+#include "core/Profiler.h"
 #include "core/Types.h"
+#include "game/SettlerSystem.h"
+#include "ui/CityMapRenderer.h"
 #include <Windows.h>
 #include <commctrl.h>
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <ctime>
 
 #pragma comment(lib, "comctl32.lib")
@@ -23,54 +28,59 @@ const COLORREF C7_TEXT_DIM = RGB(160, 165, 170);  // Dimmed text for description
 const COLORREF C7_GOLD = RGB(200, 155, 60);       // Titles, highlights
 const COLORREF C7_SELECTION = RGB(60, 68, 85);    // Listbox selection
 
-// --- Building Definitions ---
-struct BuildingDef {
-    std::wstring name;
-    double costMoney;
-    double costMaterials;
-    int popCapAdd;
-    double foodAdd;
-    double moneyAdd;
-    double materialsAdd;
-    double energyAdd;
-    double militaryAdd;
-    Era minEra;
-    COLORREF color;
-};
-
-static const std::vector<BuildingDef> s_buildingDefs = {
-    { L"Дом",       0,   50,  50, 0,   0,   0,   0,   0, Era::StoneAge,   RGB(200, 150, 100) },
-    { L"Ферма",     20,  20,  0,  15,  0,   0,   0,   0, Era::StoneAge,   RGB(50, 200, 50) },
-    { L"Рынок",     50,  50,  0,  0,   10,  0,   0,   0, Era::BronzeAge,  RGB(200, 200, 50) },
-    { L"Шахта",     100, 0,   0,  0,   0,   10,  0,   0, Era::BronzeAge,  RGB(100, 100, 100) },
-    { L"Казарма",   150, 100, 0,  0,   0,   0,   0,   5, Era::IronAge,    RGB(200, 50, 50) },
-    { L"Завод",     300, 200, 0,  0,   20,  20, -10,  0, Era::Industrial, RGB(120, 120, 130) },
-    { L"Эл.станция",400, 300, 0,  0,   0,   0,   30,  0, Era::Industrial, RGB(100, 200, 255) }
-};
-
 // --- City Map Visualizer ---
-struct CityEntity {
-    float x, y;
-    float dx, dy;
-    int type; // 0=Settler, 1=Building, 2=TownHall
-    int variant;
-    int buildingDefIdx; // Index in s_buildingDefs if type==1
-    COLORREF color;
-};
-
-static std::vector<CityEntity> s_cityEntities;
+// Buildings live in the civilization's CityModel; settlers only animate the map
+static SettlerSystem s_settlers;
+static std::chrono::steady_clock::time_point s_lastSettlerTick;
+static CityFlowFields s_flowFields;      // Where settlers commute, sized to the map
+static bool s_flowFieldsStale = true;    // Rebuild from the city before the next step
 static Era s_currentEraDisplay = Era::StoneAge;
 static HWND s_hCityMap = nullptr;
 static HWND s_hMapTooltip = nullptr; // Tooltip for the map/HUD
 
 static int s_selectedBuildingIdx = -1; // -1 means none selected
-static int s_housingCap = 100;
+
+// Frames of the map come from the portable renderer; the DIB section they are
+// copied into lives until the map is resized
+static CityMapRenderer s_mapRenderer;
+static HDC s_mapDC = nullptr;
+static HBITMAP s_mapBitmap = nullptr;
+static HBITMAP s_mapOldBitmap = nullptr;
+static void* s_mapBits = nullptr;
+
+static void ReleaseMapSurface() {
+    if (s_mapDC) {
+        SelectObject(s_mapDC, s_mapOldBitmap);
+        DeleteObject(s_mapBitmap);
+        DeleteDC(s_mapDC);
+    }
+    s_mapDC = nullptr;
+    s_mapBitmap = nullptr;
+    s_mapOldBitmap = nullptr;
+    s_mapBits = nullptr;
+}
+
+static void CreateMapSurface(HDC hdc, int width, int height) {
+    ReleaseMapSurface();
+    // Top-down 32 bpp: the same memory layout as a Framebuffer
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width;
+    bmi.bmiHeader.biHeight = -height;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+    s_mapDC = CreateCompatibleDC(hdc);
+    s_mapBitmap = CreateDIBSection(hdc, &bmi, DIB_RGB_COLORS, &s_mapBits, nullptr, 0);
+    s_mapOldBitmap = (HBITMAP)SelectObject(s_mapDC, s_mapBitmap);
+}
 
 // --- Tooltip Helper & Globals ---
 static HWND s_hTooltip = nullptr;
 static WNDPROC s_oldListProc = nullptr;
 static Civilization* s_activeCiv = nullptr;
 static int s_lastTooltipItem = -1;
+static std::vector<std::wstring> s_techTooltips; // Descriptions by TechId, converted once
 
 static std::wstring ToWStrStatic(const std::string& str) {
     if (str.empty()) return L"";
@@ -95,26 +105,23 @@ static LRESULT CALLBACK ListBoxSubclassProc(HWND hwnd, UINT msg, WPARAM wParam,
                 if (index != s_lastTooltipItem) {
                     s_lastTooltipItem = index;
                     
-                    std::wstring text = L"";
+                    const wchar_t* text = L"";
                     LPARAM itemData = SendMessageW(hwnd, LB_GETITEMDATA, index, 0);
                     
-                    // itemData is index in available vector, or -1
-                    if (itemData != -1) {
-                        auto available = s_activeCiv->getTech().getAvailableTechs();
-                        if (itemData >= 0 && itemData < (LPARAM)available.size()) {
-                            text = ToWStrStatic(available[itemData]->description);
-                        }
+                    // itemData is the TechId of an available technology, 0x100 + branch, or -1
+                    if (itemData >= 0 && itemData < (LPARAM)s_techTooltips.size()) {
+                        text = s_techTooltips[itemData].c_str();
                     }
 
                     TOOLINFOW ti = { 0 };
                     ti.cbSize = sizeof(TOOLINFOW);
                     ti.hwnd = GetParent(hwnd);
                     ti.uId = (UINT_PTR)hwnd;
-                    ti.lpszText = const_cast<LPWSTR>(text.c_str());
+                    ti.lpszText = const_cast<LPWSTR>(text);
                     
                     SendMessageW(s_hTooltip, TTM_UPDATETIPTEXTW, 0, (LPARAM)&ti);
                     
-                    if (text.empty()) {
+                    if (*text == L'\0') {
                         SendMessageW(s_hTooltip, TTM_ACTIVATE, FALSE, 0);
                     } else {
                         SendMessageW(s_hTooltip, TTM_ACTIVATE, TRUE, 0);
@@ -129,68 +136,45 @@ static LRESULT CALLBACK ListBoxSubclassProc(HWND hwnd, UINT msg, WPARAM wParam,
     return CallWindowProcW(s_oldListProc, hwnd, msg, wParam, lParam);
 }
 
-static void InitCityMap() {
-    s_cityEntities.clear();
-    s_selectedBuildingIdx = -1;
-    // Start with one Town Hall in the center
-    CityEntity townHall;
-    townHall.x = 570.0f; // Center of 1140 width
-    townHall.y = 375.0f; // Center of 750 height
-    townHall.dx = 0; townHall.dy = 0;
-    townHall.type = 2; // Town Hall
-    townHall.variant = 0;
-    townHall.buildingDefIdx = -1;
-    townHall.color = C7_GOLD;
-    s_cityEntities.push_back(townHall);
+// Wide building names for the HUD, converted once
+static const std::vector<std::wstring>& BuildingNames() {
+    static const std::vector<std::wstring> names = [] {
+        std::vector<std::wstring> wide;
+        for (const auto& def : CityModel::getBuildingDefs()) {
+            wide.push_back(ToWStrStatic(def.name));
+        }
+        return wide;
+    }();
+    return names;
 }
 
-static bool IsOverlapping(float x, float y, float r) {
-    for(const auto& e : s_cityEntities) {
-        if(e.type == 0) continue; // Ignore settlers
-        float distSq = (e.x - x)*(e.x - x) + (e.y - y)*(e.y - y);
-        float minDist = (r + 12.0f); 
-        if(distSq < minDist*minDist) return true;
-    }
-    return false;
+static void InitCityMap(Civilization& civ) {
+    s_settlers.clear();
+    s_flowFieldsStale = true;
+    s_selectedBuildingIdx = -1;
+    // Start with one Town Hall in the center of the 1140x750 map
+    civ.getCity().found(570.0f, 375.0f);
 }
 
 static void UpdateCityMap(const Civilization& civ) {
     s_currentEraDisplay = civ.getCurrentEra();
     
-    // Only update settlers count, buildings are persistent now
-    double pop = (double)civ.getPopulation();
-    size_t targetSettlers = (size_t)(std::log(pop + 1.0) * 15.0);
-    if (targetSettlers > 150) targetSettlers = 150;
-
-    // Count current
-    size_t settlers = 0;
-    std::vector<int> buildingIndices;
-
-    for(size_t i = 0; i < s_cityEntities.size(); ++i) {
-        const auto& e = s_cityEntities[i];
-        if(e.type == 0) settlers++;
-        else {
-            buildingIndices.push_back((int)i);
-        }
-    }
-
-    // Add Settlers
-    while(settlers < targetSettlers) {
-        CityEntity s;
-        float sx = 570.0f, sy = 375.0f;
-        if(!buildingIndices.empty()) {
-            const auto& b = s_cityEntities[buildingIndices[rand() % buildingIndices.size()]];
-            sx = b.x; sy = b.y;
+    // Only update settlers count, buildings are persistent now; the crowd
+    // follows the real population up to SettlerSystem::MAX_SETTLERS
+    size_t targetSettlers = SettlerSystem::targetCount(civ.getPopulation());
+    s_settlers.truncate(targetSettlers);
+
+    // Settlers spread out from the town hall and the buildings
+    const CityModel& city = civ.getCity();
+    const auto& buildings = city.getBuildings();
+    s_settlers.reserve(targetSettlers);
+    while(s_settlers.size() < targetSettlers) {
+        size_t home = rand() % (buildings.size() + 1);
+        if(home < buildings.size()) {
+            s_settlers.spawn(buildings[home].x, buildings[home].y);
+        } else {
+            s_settlers.spawn(city.getCenterX(), city.getCenterY());
         }
-        s.x = sx; s.y = sy;
-        s.dx = (float)(rand() % 20 - 10) / 20.0f;
-        s.dy = (float)(rand() % 20 - 10) / 20.0f;
-        s.type = 0;
-        s.variant = 0;
-        s.buildingDefIdx = -1;
-        s.color = RGB(240, 240, 240);
-        s_cityEntities.push_back(s);
-        settlers++;
     }
 }
 
@@ -199,18 +183,25 @@ static int s_lastMapTooltipIdx = -2; // -2: init, -1: none
 static LRESULT CALLBACK CityMapWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch(msg) {
     case WM_TIMER: {
+        // The timer only paces redraws; the settlers step at their own fixed rate
         RECT rc;
         GetClientRect(hwnd, &rc);
-        for(auto& e : s_cityEntities) {
-            if(e.type == 0) { // Move settlers
-                e.x += e.dx;
-                e.y += e.dy;
-                if(e.x < 0 || e.x > rc.right) e.dx *= -1;
-                if(e.y < 0 || e.y > rc.bottom) e.dy *= -1;
-                if(rand()%100 == 0) { e.dx = (float)(rand()%20-10)/20.0f; e.dy = (float)(rand()%20-10)/20.0f; }
-            }
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = s_lastSettlerTick.time_since_epoch().count() == 0
+            ? 0.0 : std::chrono::duration<double>(now - s_lastSettlerTick).count();
+        s_lastSettlerTick = now;
+        if (s_settlers.getWidth() != (float)rc.right || s_settlers.getHeight() != (float)rc.bottom) {
+            s_settlers.setBounds((float)rc.right, (float)rc.bottom);
+            s_flowFieldsStale = true;
+        }
+        if (s_flowFieldsStale && s_activeCiv) {
+            s_flowFields.resize((float)rc.right, (float)rc.bottom);
+            s_flowFields.rebuild(s_activeCiv->getCity());
+            s_flowFieldsStale = false;
+        }
+        if (s_settlers.advance(elapsed, s_activeCiv ? &s_flowFields : nullptr) > 0) {
+            InvalidateRect(hwnd, nullptr, FALSE);
         }
-        InvalidateRect(hwnd, nullptr, FALSE);
         return 0;
     }
     case WM_PAINT: {
@@ -218,101 +209,51 @@ static LRESULT CALLBACK CityMapWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
         HDC hdc = BeginPaint(hwnd, &ps);
         RECT rc;
         GetClientRect(hwnd, &rc);
-        
-        HDC hMemDC = CreateCompatibleDC(hdc);
-        HBITMAP hBm = CreateCompatibleBitmap(hdc, rc.right, rc.bottom);
-        HBITMAP hOldBm = (HBITMAP)SelectObject(hMemDC, hBm);
-        
-        // Background based on Era
-        COLORREF bgCol = RGB(34, 139, 34); // Stone Age Green
-        if (s_currentEraDisplay >= Era::Industrial) bgCol = RGB(80, 80, 90); // Industrial Grey
-        if (s_currentEraDisplay == Era::Space) bgCol = RGB(20, 20, 40); // Space Dark
-        
-        HBRUSH hBg = CreateSolidBrush(bgCol);
-        FillRect(hMemDC, &rc, hBg);
-        DeleteObject(hBg);
-
-        // Draw HUD Background (Bottom 40px)
-        RECT rcHud = {0, rc.bottom - 40, rc.right, rc.bottom};
-        HBRUSH hHudBg = CreateSolidBrush(RGB(40, 40, 50));
-        FillRect(hMemDC, &rcHud, hHudBg);
-        DeleteObject(hHudBg);
-
-        // Draw Entities
-        for(const auto& e : s_cityEntities) {
-            if(e.type == 0) { // Settler
-                HBRUSH hBr = CreateSolidBrush(e.color);
-                HBRUSH hOld = (HBRUSH)SelectObject(hMemDC, hBr);
-                Ellipse(hMemDC, (int)e.x-2, (int)e.y-2, (int)e.x+2, (int)e.y+2);
-                SelectObject(hMemDC, hOld);
-                DeleteObject(hBr);
-            } else { // Building
-                int size = (e.type == 2) ? 8 : 5;
-                RECT rB = {(int)e.x-size, (int)e.y-size, (int)e.x+size, (int)e.y+size};
-                HBRUSH hB = CreateSolidBrush(e.color);
-                FillRect(hMemDC, &rB, hB);
-                DeleteObject(hB);
-                
-                // Roof
-                POINT pts[3] = {
-                    {(int)e.x, (int)e.y-size-4},
-                    {(int)e.x-size, (int)e.y-size},
-                    {(int)e.x+size, (int)e.y-size}
-                };
-                HBRUSH hRoof = CreateSolidBrush(RGB(139, 69, 19));
-                HBRUSH hOld = (HBRUSH)SelectObject(hMemDC, hRoof);
-                HPEN hPen = CreatePen(PS_SOLID, 1, RGB(100, 50, 10));
-                HPEN hOldPen = (HPEN)SelectObject(hMemDC, hPen);
-                Polygon(hMemDC, pts, 3);
-                SelectObject(hMemDC, hOld);
-                SelectObject(hMemDC, hOldPen);
-                DeleteObject(hRoof);
-                DeleteObject(hPen);
-            }
-        }
-        
-        // Draw HUD Items
-        int xPos = 10;
-        int yPos = rc.bottom - 35;
-        SetBkMode(hMemDC, TRANSPARENT);
-        
-        for (int i = 0; i < (int)s_buildingDefs.size(); ++i) {
-            const auto& def = s_buildingDefs[i];
-            if (s_currentEraDisplay < def.minEra) continue;
 
-            RECT rItem = {xPos, yPos, xPos + 80, yPos + 30};
-            
-            // Highlight selection
-            if (i == s_selectedBuildingIdx) {
-                HBRUSH hSel = CreateSolidBrush(RGB(80, 80, 100));
-                FillRect(hMemDC, &rItem, hSel);
-                DeleteObject(hSel);
-                FrameRect(hMemDC, &rItem, (HBRUSH)GetStockObject(WHITE_BRUSH));
-            } else {
-                HBRUSH hBtn = CreateSolidBrush(RGB(60, 60, 70));
-                FillRect(hMemDC, &rItem, hBtn);
-                DeleteObject(hBtn);
-            }
-
-            // Color indicator
-            RECT rCol = {xPos + 5, yPos + 5, xPos + 25, yPos + 25};
-            HBRUSH hCol = CreateSolidBrush(def.color);
-            FillRect(hMemDC, &rCol, hCol);
-            DeleteObject(hCol);
+        if (rc.right <= 0 || rc.bottom <= 0) { // Minimized
+            EndPaint(hwnd, &ps);
+            return 0;
+        }
 
-            // Name
-            RECT rText = {xPos + 30, yPos, xPos + 80, yPos + 30};
-            SetTextColor(hMemDC, RGB(255, 255, 255));
-            DrawTextW(hMemDC, def.name.c_str(), -1, &rText, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
+        // The map is rasterized by the portable CityMapRenderer; GDI only copies
+        // the frame into a DIB section kept between frames, writes the HUD
+        // labels on it and blits it
+        if (!s_mapDC || s_mapRenderer.frame().getWidth() != rc.right || s_mapRenderer.frame().getHeight() != rc.bottom) {
+            s_mapRenderer.resize(rc.right, rc.bottom);
+            CreateMapSurface(hdc, rc.right, rc.bottom);
+        }
+        CityMapView view;
+        view.city = s_activeCiv ? &s_activeCiv->getCity() : nullptr;
+        view.settlers = &s_settlers;
+        view.era = s_currentEraDisplay;
+        view.selectedBuilding = s_selectedBuildingIdx;
+        s_mapRenderer.render(view);
+
+        const Framebuffer& frame = s_mapRenderer.frame();
+        if (s_mapBits) {
+            std::memcpy(s_mapBits, frame.data(), (size_t)frame.getWidth() * frame.getHeight() * sizeof(uint32_t));
+            GdiFlush();
+        }
 
-            xPos += 90;
+        // HUD labels
+        SetBkMode(s_mapDC, TRANSPARENT);
+        SetTextColor(s_mapDC, RGB(255, 255, 255));
+        int yPos = rc.bottom - CityMapRenderer::HUD_HEIGHT + 5;
+        const auto& defs = CityModel::getBuildingDefs();
+        for (int i = 0; i < (int)defs.size(); ++i) {
+            int xPos = CityMapRenderer::hudItemLeft(i, s_currentEraDisplay);
+            if (xPos < 0) continue;
+            RECT rText = {xPos + 30, yPos, xPos + CityMapRenderer::HUD_ITEM_WIDTH, yPos + CityMapRenderer::HUD_ITEM_HEIGHT};
+            DrawTextW(s_mapDC, BuildingNames()[i].c_str(), -1, &rText, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
         }
 
-        BitBlt(hdc, 0, 0, rc.right, rc.bottom, hMemDC, 0, 0, SRCCOPY);
-        SelectObject(hMemDC, hOldBm); DeleteObject(hBm); DeleteDC(hMemDC);
+        BitBlt(hdc, 0, 0, rc.right, rc.bottom, s_mapDC, 0, 0, SRCCOPY);
         EndPaint(hwnd, &ps);
         return 0;
     }
+    case WM_DESTROY:
+        ReleaseMapSurface();
+        return 0;
     case WM_MOUSEMOVE: {
         if (s_hMapTooltip) {
             MSG relayMsg = { hwnd, msg, wParam, lParam };
@@ -326,29 +267,25 @@ static LRESULT CALLBACK CityMapWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
 
         // Check HUD hover
         int hoveredIdx = -1;
-        if (yPos > rc.bottom - 50) {
-            int hudX = 10;
-            for (int i = 0; i < (int)s_buildingDefs.size(); ++i) {
-                if (s_currentEraDisplay < s_buildingDefs[i].minEra) continue;
-                if (xPos >= hudX && xPos <= hudX + 100) {
-                    hoveredIdx = i;
-                    break;
-                }
-                hudX += 110;
-            }
+        if (yPos > rc.bottom - CityMapRenderer::HUD_HEIGHT) {
+            hoveredIdx = CityMapRenderer::hudItemAt(xPos, s_currentEraDisplay);
         }
 
         if (hoveredIdx != s_lastMapTooltipIdx) {
             s_lastMapTooltipIdx = hoveredIdx;
             std::wstring text = L"";
             if (hoveredIdx >= 0) {
-                const auto& def = s_buildingDefs[hoveredIdx];
-                text = def.name + L"\nЦена: $" + std::to_wstring((int)def.costMoney) + 
+                const auto& def = CityModel::getBuildingDefs()[hoveredIdx];
+                auto yield = [&def](ResourceType type) { return (int)def.yield[static_cast<size_t>(type)]; };
+                auto bonus = [&def](ResourceType type) { return (int)(def.productionBonus[static_cast<size_t>(type)] * 100.0 + 0.5); };
+                text = BuildingNames()[hoveredIdx] + L"\nЦена: $" + std::to_wstring((int)def.costMoney) + 
                        L", Мат: " + std::to_wstring((int)def.costMaterials) + L"\n";
-                if(def.popCapAdd > 0) text += L"Жилье: +" + std::to_wstring(def.popCapAdd) + L"\n";
-                if(def.foodAdd > 0) text += L"Еда: +" + std::to_wstring((int)def.foodAdd) + L"/ход\n";
-                if(def.moneyAdd > 0) text += L"Деньги: +" + std::to_wstring((int)def.moneyAdd) + L"/ход\n";
-                if(def.materialsAdd > 0) text += L"Материалы: +" + std::to_wstring((int)def.materialsAdd) + L"/ход\n";
+                if(def.housing > 0) text += L"Жилье: +" + std::to_wstring(def.housing) + L"\n";
+                if(yield(ResourceType::Food) > 0) text += L"Еда: +" + std::to_wstring(yield(ResourceType::Food)) + L"/ход\n";
+                if(yield(ResourceType::Money) > 0) text += L"Деньги: +" + std::to_wstring(yield(ResourceType::Money)) + L"/ход\n";
+                if(yield(ResourceType::Materials) > 0) text += L"Материалы: +" + std::to_wstring(yield(ResourceType::Materials)) + L"/ход\n";
+                if(bonus(ResourceType::Energy) > 0) text += L"Производство энергии: +" + std::to_wstring(bonus(ResourceType::Energy)) + L"%\n";
+                if(bonus(ResourceType::Materials) > 0) text += L"Производство материалов: +" + std::to_wstring(bonus(ResourceType::Materials)) + L"%\n";
             }
 
             TOOLINFOW ti = { 0 };
@@ -368,16 +305,11 @@ static LRESULT CALLBACK CityMapWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
         GetClientRect(hwnd, &rc);
 
         // Check HUD click
-        if (yPos > rc.bottom - 40) {
-            int hudX = 10;
-            for (int i = 0; i < (int)s_buildingDefs.size(); ++i) {
-                if (s_currentEraDisplay < s_buildingDefs[i].minEra) continue;
-                if (xPos >= hudX && xPos <= hudX + 80) {
-                    s_selectedBuildingIdx = i;
-                    InvalidateRect(hwnd, nullptr, FALSE);
-                    return 0;
-                }
-                hudX += 90;
+        if (yPos > rc.bottom - CityMapRenderer::HUD_HEIGHT) {
+            int item = CityMapRenderer::hudItemAt(xPos, s_currentEraDisplay);
+            if (item >= 0) {
+                s_selectedBuildingIdx = item;
+                InvalidateRect(hwnd, nullptr, FALSE);
             }
             return 0;
         }
@@ -389,50 +321,33 @@ static LRESULT CALLBACK CityMapWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARA
                 return 0;
             }
 
-            const auto& def = s_buildingDefs[s_selectedBuildingIdx];
-            double money = s_activeCiv->getResources().getResource(ResourceType::Money);
-            double mats = s_activeCiv->getResources().getResource(ResourceType::Materials);
-
-            if (money >= def.costMoney && mats >= def.costMaterials) {
-                if (!IsOverlapping((float)xPos, (float)yPos, 10.0f)) {
-                    s_activeCiv->getResources().removeResource(ResourceType::Money, def.costMoney);
-                    s_activeCiv->getResources().removeResource(ResourceType::Materials, def.costMaterials);
-
-                    CityEntity b;
-                    b.x = (float)xPos; b.y = (float)yPos;
-                    b.dx = 0; b.dy = 0;
-                    b.type = 1; // Building
-                    b.variant = 0;
-                    b.buildingDefIdx = s_selectedBuildingIdx;
-                    b.color = def.color;
-                    s_cityEntities.push_back(b);
-                    
-                    InvalidateRect(hwnd, nullptr, FALSE);
-                } else {
-                    MessageBoxW(hwnd, L"Слишком близко к другому зданию!", L"Ошибка", MB_OK | MB_ICONWARNING);
-                }
+            PlaceResult placed = s_activeCiv->placeBuilding((size_t)s_selectedBuildingIdx, (float)xPos, (float)yPos);
+            if (placed == PlaceResult::Placed) {
+                // Only the new building's own field changes
+                s_flowFields.addSource((size_t)s_selectedBuildingIdx, (float)xPos, (float)yPos);
+                InvalidateRect(hwnd, nullptr, FALSE);
+            } else if (placed == PlaceResult::Overlapping) {
+                MessageBoxW(hwnd, L"Слишком близко к другому зданию!", L"Ошибка", MB_OK | MB_ICONWARNING);
+            } else if (placed == PlaceResult::TooEarly) {
+                MessageBoxW(hwnd, L"Здание ещё недоступно в этой эпохе!", L"Ошибка", MB_OK | MB_ICONWARNING);
             } else {
                 MessageBoxW(hwnd, L"Недостаточно ресурсов!", L"Ошибка", MB_OK | MB_ICONWARNING);
             }
             return 0;
         }
 
-        // Iterate backwards to check topmost entities first
-        for (auto it = s_cityEntities.rbegin(); it != s_cityEntities.rend(); ++it) {
-            const auto& e = *it;
-            if (e.type != 0) { // It's a building
-                RECT rB = {(int)e.x-8, (int)e.y-8, (int)e.x+8, (int)e.y+8};
-                POINT pt = {xPos, yPos};
-                if (PtInRect(&rB, pt)) {
-                    std::wstring info;
-                    if (e.type == 1 && e.buildingDefIdx >= 0) {
-                        info = s_buildingDefs[e.buildingDefIdx].name;
-                    } else if (e.type == 2) {
-                        info = L"Ратуша.\n\nЦентр вашего поселения.";
-                    }
-                    MessageBoxW(hwnd, info.c_str(), L"Информация о здании", MB_OK | MB_ICONINFORMATION);
-                    return 0; // Stop after finding the first building
-                }
+        // Buildings never overlap, so the nearest one under the cursor is the one clicked
+        if (s_activeCiv && s_activeCiv->getCity().isFounded()) {
+            const CityModel& city = s_activeCiv->getCity();
+            size_t picked = city.pick((float)xPos, (float)yPos);
+            if (picked != CityModel::NO_BUILDING) {
+                MessageBoxW(hwnd, BuildingNames()[city.getBuildings()[picked].def].c_str(), L"Информация о здании", MB_OK | MB_ICONINFORMATION);
+                return 0;
+            }
+            POINT pt = {xPos, yPos};
+            RECT rHall = {(int)city.getCenterX()-8, (int)city.getCenterY()-8, (int)city.getCenterX()+8, (int)city.getCenterY()+8};
+            if (PtInRect(&rHall, pt)) {
+                MessageBoxW(hwnd, L"Ратуша.\n\nЦентр вашего поселения.", L"Информация о здании", MB_OK | MB_ICONINFORMATION);
             }
         }
         return 0;
@@ -655,6 +570,13 @@ Win32Gui::Win32Gui()
 }
 
 Win32Gui::~Win32Gui() {
+    CIV_PROFILE_DUMP("civsim_profile.txt");
+#ifdef INTSIM_PROFILING
+    if (!m_tracePath.empty()) {
+        Tracer::instance().stop();
+        Tracer::instance().writeJson(m_tracePath);
+    }
+#endif
     if (m_bgBrush) DeleteObject(m_bgBrush);
     if (m_panelBrush) DeleteObject(m_panelBrush);
     if (m_mainWindow) {
@@ -676,6 +598,9 @@ std::wstring Win32Gui::toWStr(const std::string& str) {
 int Win32Gui::run(HINSTANCE hInstance, int nCmdShow) {
     m_hInstance = hInstance;
     std::srand((unsigned int)std::time(nullptr));
+#ifdef INTSIM_PROFILING
+    m_tracePath = Tracer::instance().startFromEnvironment();
+#endif
 
     INITCOMMONCONTROLSEX icex;
     icex.dwICC = ICC_PROGRESS_CLASS | ICC_LISTVIEW_CLASSES | ICC_UPDOWN_CLASS;
@@ -997,42 +922,78 @@ void Win32Gui::createControls() {
     SendMessageW(m_quitBtn, WM_SETFONT, (WPARAM)hSmallBtnFont, 0);
 }
 
+void Win32Gui::publishSnapshot() {
+    if (m_civ && m_events) {
+        m_snapshots.publish(*m_civ, *m_events);
+    } else {
+        m_snapshots.publishEmpty();
+    }
+}
+
 void Win32Gui::updateAllUI() {
-    updateStats();
-    updateResources();
-    updateTechTree();
-    updateEra();
+    CIV_PROFILE_SCOPE(Rendering);
+    m_snapshots.update();
+    ViewChanges changes = m_view.update(m_snapshots.latest());
+
+    updateStats(changes);
+    if (changes.any(ViewChange::Game | ViewChange::Resources)) {
+        updateResources();
+    }
+    if (changes.any(ViewChange::Game | ViewChange::TechLevel | ViewChange::BranchLevels | ViewChange::Research)) {
+        updateTechTree();
+    }
+    if (changes.any(ViewChange::Game | ViewChange::Era)) {
+        updateEra();
+    }
     if(m_civ) UpdateCityMap(*m_civ);
 }
 
-void Win32Gui::updateStats() {
-    if (!m_civ) return;
+void Win32Gui::updateStats(ViewChanges changes) {
+    const GameSnapshot& view = m_view.current();
+    if (!view.hasGame) return;
+
+    // A new game redraws every label
+    auto changed = [changes](ViewChange part) { return changes.any(ViewChange::Game | part); };
 
-    SetWindowTextW(m_turnLabel, toWStr(u8"Ход: " + std::to_string(m_civ->getTurn())).c_str());
+    if (changed(ViewChange::Turn)) {
+        SetWindowTextW(m_turnLabel, toWStr(u8"Ход: " + std::to_string(view.turn)).c_str());
+    }
     
-    int pop = m_civ->getPopulation();
-    SetWindowTextW(m_populationLabel, toWStr(Utils::formatNumber(pop)).c_str());
+    if (changed(ViewChange::Population)) {
+        int pop = view.population;
+        SetWindowTextW(m_populationLabel, toWStr(Utils::formatNumber(pop)).c_str());
+    }
     
-    int happy = (int)m_civ->getHappiness();
-    SetWindowTextW(m_happinessLabel, toWStr(std::to_string(happy) + "%").c_str());
+    if (changed(ViewChange::Happiness)) {
+        int happy = (int)view.happiness;
+        SetWindowTextW(m_happinessLabel, toWStr(std::to_string(happy) + "%").c_str());
+    }
     
-    int eco = (int)m_civ->getEcology();
-    SetWindowTextW(m_ecologyLabel, toWStr(std::to_string(eco) + "%").c_str());
+    if (changed(ViewChange::Ecology)) {
+        int eco = (int)view.ecology;
+        SetWindowTextW(m_ecologyLabel, toWStr(std::to_string(eco) + "%").c_str());
+    }
     
-    int mil = (int)m_civ->getMilitary();
-    SetWindowTextW(m_militaryLabel, toWStr(std::to_string(mil)).c_str());
+    if (changed(ViewChange::Military)) {
+        int mil = (int)view.military;
+        SetWindowTextW(m_militaryLabel, toWStr(std::to_string(mil)).c_str());
+    }
     
-    int tech = m_civ->getTech().getOverallTechLevel();
-    SetWindowTextW(m_techLabel, toWStr(std::to_string(tech) + "/100").c_str());
+    if (changed(ViewChange::TechLevel)) {
+        int tech = view.techLevel;
+        SetWindowTextW(m_techLabel, toWStr(std::to_string(tech) + "/100").c_str());
+    }
 }
 
 void Win32Gui::updateResources() {
-    if (!m_civ) return;
-
-    SetWindowTextW(m_foodLabel, toWStr(Utils::formatDouble(m_civ->getResources().getResource(ResourceType::Food), 0)).c_str());
-    SetWindowTextW(m_moneyLabel, toWStr(Utils::formatDouble(m_civ->getResources().getResource(ResourceType::Money), 0)).c_str());
-    SetWindowTextW(m_energyLabel, toWStr(Utils::formatDouble(m_civ->getResources().getResource(ResourceType::Energy), 0)).c_str());
-    SetWindowTextW(m_materialsLabel, toWStr(Utils::formatDouble(m_civ->getResources().getResource(ResourceType::Materials), 0)).c_str());
+    const GameSnapshot& view = m_view.current();
+    if (!view.hasGame) return;
+
+    auto resource = [&view](ResourceType type) { return view.resources[static_cast<size_t>(type)]; };
+    SetWindowTextW(m_foodLabel, toWStr(Utils::formatDouble(resource(ResourceType::Food), 0)).c_str());
+    SetWindowTextW(m_moneyLabel, toWStr(Utils::formatDouble(resource(ResourceType::Money), 0)).c_str());
+    SetWindowTextW(m_energyLabel, toWStr(Utils::formatDouble(resource(ResourceType::Energy), 0)).c_str());
+    SetWindowTextW(m_materialsLabel, toWStr(Utils::formatDouble(resource(ResourceType::Materials), 0)).c_str());
 }
 
 void Win32Gui::updateTechTree() {
@@ -1044,8 +1005,16 @@ void Win32Gui::updateTechTree() {
     SendMessageW(m_techList, LB_RESETCONTENT, 0, 0);
     s_lastTooltipItem = -1;
 
+    const TechnologyTree& tree = m_civ->getTech();
+    if (s_techTooltips.size() != tree.getTechnologyCount()) {
+        s_techTooltips.clear();
+        for (size_t id = 0; id < tree.getTechnologyCount(); ++id) {
+            s_techTooltips.push_back(toWStr(tree.getTechnology(static_cast<TechId>(id)).description));
+        }
+    }
+
     // Показываем общий уровень технологий
-    int overallLevel = m_civ->getTech().getOverallTechLevel();
+    int overallLevel = tree.getOverallTechLevel();
     std::wstringstream ssHeader;
     ssHeader << L"=== Уровень технологий: " << overallLevel << "/100 ===";
     int idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)ssHeader.str().c_str());
@@ -1054,9 +1023,7 @@ void Win32Gui::updateTechTree() {
     // Показываем прогресс по веткам
     for (int i = 0; i < static_cast<int>(TechBranch::COUNT); ++i) {
         auto branch = static_cast<TechBranch>(i);
-        int level = m_civ->getTech().getBranchLevel(branch);
-        double progress = m_civ->getTech().getBranchProgress(branch);
-        double threshold = m_civ->getTech().getBranchThreshold(branch);
+        int level = tree.getBranchLevel(branch);
         
         std::wstringstream ss;
         ss << L"  " << toWStr(techBranchToString(branch)) << L": Ур." << level;
@@ -1072,13 +1039,14 @@ void Win32Gui::updateTechTree() {
     idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)L"--- Исследовано ---");
     SendMessageW(m_techList, LB_SETITEMDATA, idx, -1);
 
-    auto researched = m_civ->getTech().getResearchedTechs();
+    const auto& researched = tree.getResearchedIds();
     if (researched.empty()) {
         idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)L"  (пока нет)");
         SendMessageW(m_techList, LB_SETITEMDATA, idx, -1);
     } else {
-        for (const auto* tech : researched) {
-            std::wstring text = L"  [✓] " + toWStr(tech->name) + L" (Ур." + std::to_wstring(tech->level) + L")";
+        for (TechId id : researched) {
+            const Technology& tech = tree.getTechnology(id);
+            std::wstring text = L"  [✓] " + toWStr(tech.name) + L" (Ур." + std::to_wstring(tech.level) + L")";
             idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)text.c_str());
             SendMessageW(m_techList, LB_SETITEMDATA, idx, -1);
         }
@@ -1092,73 +1060,44 @@ void Win32Gui::updateTechTree() {
     idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)L"--- Доступные ---");
     SendMessageW(m_techList, LB_SETITEMDATA, idx, -1);
 
-    auto available = m_civ->getTech().getAvailableTechs();
+    const auto& available = tree.getAvailableIds();
     if (available.empty()) {
         idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)L"  (доступных нет)");
         SendMessageW(m_techList, LB_SETITEMDATA, idx, -1);
     } else {
-        for (size_t i = 0; i < available.size(); ++i) {
-            const auto* tech = available[i];
+        for (TechId id : available) {
+            const Technology& tech = tree.getTechnology(id);
             std::wstringstream ss;
-            ss << L"  [ ] " << toWStr(tech->name) << L" (Ур." << tech->level << L", $" << tech->cost << L")";
+            ss << L"  [ ] " << toWStr(tech.name) << L" (Ур." << tech.level << L", $" << tech.cost << L")";
             idx = (int)SendMessageW(m_techList, LB_ADDSTRING, 0, (LPARAM)ss.str().c_str());
-            SendMessageW(m_techList, LB_SETITEMDATA, idx, (LPARAM)i); // Store index in available vector
+            SendMessageW(m_techList, LB_SETITEMDATA, idx, (LPARAM)id); // TechId, stable while the game lasts
         }
     }
 }
 
 void Win32Gui::updateEvents() {
-    if (!m_civ) {
+    const GameSnapshot& view = m_view.current();
+    if (!view.hasGame) {
         return;
     }
 
-    const auto& history = m_events->getEventHistory();
-    if (history.empty()) {
+    if (view.totalEvents == 0) {
         SetWindowTextW(m_eventLabel, L"Нажмите 'Следующий ход' для начала игры!");
         return;
     }
 
     std::wstringstream ss;
-    size_t start = (history.size() > 10) ? history.size() - 10 : 0;
-    for (size_t i = start; i < history.size(); ++i) {
-        const auto& e = history[i];
+    for (size_t i = 0; i < view.recentCount; ++i) {
+        const auto& e = view.recentEvents[i];
         ss << L"[" << toWStr(eventTypeToString(e.type)) << L"] " << toWStr(e.name) << L"\r\n";
     }
     SetWindowTextW(m_eventLabel, ss.str().c_str());
 }
 
 void Win32Gui::updateEra() {
-    if (!m_civ) return;
-    SetWindowTextW(m_eraLabel, toWStr(eraToString(m_civ->getCurrentEra())).c_str());
-}
-
-static void ApplyCityBonuses(Civilization* civ) {
-    if (!civ) return;
-    
-    int housing = 50; // Base housing from Town Hall
-    double food = 0, money = 0, mat = 0, energy = 0, mil = 0;
-    
-    for (const auto& e : s_cityEntities) {
-        if (e.type == 1 && e.buildingDefIdx >= 0) {
-            const auto& def = s_buildingDefs[e.buildingDefIdx];
-            housing += def.popCapAdd;
-            food += def.foodAdd;
-            money += def.moneyAdd;
-            mat += def.materialsAdd;
-            energy += def.energyAdd;
-            mil += def.militaryAdd;
-        }
-    }
-    
-    civ->getResources().addResource(ResourceType::Food, food);
-    civ->getResources().addResource(ResourceType::Money, money);
-    civ->getResources().addResource(ResourceType::Materials, mat);
-    civ->getResources().addResource(ResourceType::Energy, energy);
-    civ->modifyMilitary(mil);
-    
-    if (civ->getPopulation() > housing) {
-        civ->modifyPopulation(housing - civ->getPopulation());
-    }
+    const GameSnapshot& view = m_view.current();
+    if (!view.hasGame) return;
+    SetWindowTextW(m_eraLabel, toWStr(eraToString(view.era)).c_str());
 }
 
 void Win32Gui::onNextTurn() {
@@ -1169,18 +1108,25 @@ void Win32Gui::onNextTurn() {
         m_saveSystem = std::make_unique<SaveSystem>();
         m_events->init(m_difficulty);
         s_activeCiv = m_civ.get();
-        updateEra();
-        InitCityMap();
-        updateResources();
+        m_view.invalidate();   // Drawn in full after the first turn
+        InitCityMap(*m_civ);
     }
 
-    GameEvent event = m_events->generateEvent(m_civ->getCurrentEra(), m_civ->getTurn());
-    m_events->recordEvent(event);
-    m_civ->applyEvent(event);
-    m_civ->processTurn();
+    GameEvent event;
+    {
+        CIV_TRACE_TURN(m_civ->getTurn() + 1);
+        CIV_PROFILE_SCOPE(Turn);
+        {
+            CIV_PROFILE_SCOPE(GenerateEvent);
+            event = m_events->generateEvent(*m_civ);
+        }
+        m_events->recordEvent(event);
+        m_civ->applyEvent(event);
+        m_civ->processTurn();
+    }
 
-    ApplyCityBonuses(m_civ.get());
     UpdateCityMap(*m_civ);
+    publishSnapshot();
     updateAllUI(); // Update stats first, so we don't overwrite event text later
 
     // Update events display with full info (like console version)
@@ -1252,6 +1198,8 @@ void Win32Gui::onNextTurn() {
     
     if (!hasEffects) {
         ss << L"(Событие не оказало существенного влияния)\r\n";
+    } else if (event.duration > 1) {
+        ss << L"⏳ Длительность (ходов): " << event.duration << L"\r\n";
     }
     
     ss << L"\r\n=== История событий ===\r\n";
@@ -1281,6 +1229,7 @@ void Win32Gui::onNextTurn() {
         m_saveSystem.reset();
         s_activeCiv = nullptr;
         
+        publishSnapshot();
         updateAllUI();
         SetWindowTextW(m_eventLabel, L"Игра окончена. Нажмите 'Следующий ход' для новой игры.");
     }
@@ -1315,9 +1264,9 @@ void Win32Gui::onInvest() {
         }
     } else {
         // Если выбрана конкретная технология
-        auto available = m_civ->getTech().getAvailableTechs();
-        if (itemData < 0 || itemData >= (int)available.size()) return;
-        branch = available[itemData]->branch;
+        const TechnologyTree& tree = m_civ->getTech();
+        if (itemData < 0 || !tree.isAvailable(static_cast<TechId>(itemData))) return;
+        branch = tree.getTechnology(static_cast<TechId>(itemData)).branch;
     }
 
     double money = m_civ->getResources().getResource(ResourceType::Money);
@@ -1334,8 +1283,8 @@ void Win32Gui::onInvest() {
     m_civ->getResources().addResource(ResourceType::Money, -amount);
     m_civ->getTech().investInBranch(branch, amount);
     
-    updateResources();
-    updateTechTree(); // Обновляем прогресс-бары
+    publishSnapshot();
+    updateAllUI(); // Деньги и, при повышении уровня ветки, дерево технологий
     
     std::wstring msg = L"Инвестировано $" + std::to_wstring((int)amount) + L" в ветку " + toWStr(techBranchToString(branch));
     MessageBoxW(m_mainWindow, msg.c_str(), L"Инвестирование", MB_OK | MB_ICONINFORMATION);
@@ -1365,21 +1314,21 @@ void Win32Gui::onResearch() {
         return;
     }
     
-    auto available = m_civ->getTech().getAvailableTechs();
-    if (itemData < 0 || itemData >= (int)available.size()) return;
-    const auto* tech = available[itemData];
+    auto id = static_cast<TechId>(itemData);
+    if (itemData < 0 || !m_civ->getTech().isAvailable(id)) return;
+    const Technology& tech = m_civ->getTech().getTechnology(id);
     double money = m_civ->getResources().getResource(ResourceType::Money);
     
-    if (money < tech->cost) {
+    if (money < tech.cost) {
         MessageBoxW(m_mainWindow, L"Недостаточно денег для исследования!", L"Ошибка", MB_OK | MB_ICONWARNING);
         return;
     }
     
-    m_civ->getResources().addResource(ResourceType::Money, -tech->cost);
-    m_civ->getTech().researchTech(tech->name);
+    m_civ->getResources().addResource(ResourceType::Money, -tech.cost);
+    m_civ->getTech().researchTech(id);
     
-    updateTechTree();
-    updateResources();
+    publishSnapshot();
+    updateAllUI();
     
     if (m_civ->checkGameResult() == GameResult::VictorySpace) {
         MessageBoxW(m_mainWindow, L"ПОЗДРАВЛЯЕМ! Вы достигли Космической эры!", 
@@ -1409,6 +1358,13 @@ void Win32Gui::onLoad() {
     
     if (m_saveSystem->loadGame(*m_civ, *m_events, m_difficulty)) {
         MessageBoxW(m_mainWindow, L"Игра успешно загружена!", L"Загрузка", MB_OK | MB_ICONINFORMATION);
+        if (!m_civ->getCity().isFounded()) {
+            InitCityMap(*m_civ); // Saves from before the city was saved
+        }
+        s_settlers.clear();
+        s_flowFieldsStale = true;
+        m_view.invalidate();
+        publishSnapshot();
         updateAllUI();
         s_activeCiv = m_civ.get();
         updateEvents(); // Explicitly update events log on load
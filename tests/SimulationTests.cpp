@@ -0,0 +1,1939 @@
+#include "Scenarios.h"
+#include "core/AliasTable.h"
+#include "core/BatchRandom.h"
+#include "core/SpatialHashGrid.h"
+#include "core/TimingWheel.h"
+#include "core/TripleBuffer.h"
+#include "core/Utils.h"
+#include "game/CityFlowFields.h"
+#include "game/CityModel.h"
+#include "game/Civilization.h"
+#include "game/CivilizationBatch.h"
+#include "game/EventCatalog.h"
+#include "game/EventSystem.h"
+#include "game/FastForward.h"
+#include "game/GameEngine.h"
+#include "game/GameSnapshot.h"
+#include "game/GameViewModel.h"
+#include "game/ModifierStack.h"
+#include "game/ResourceManager.h"
+#include "game/SettlerSystem.h"
+#include "game/SimdKernels.h"
+#include "game/SimulationThread.h"
+#include "game/StandingOrders.h"
+#include "game/TechnologyTree.h"
+#include "game/TurnAdvance.h"
+#include "ui/CityMapRenderer.h"
+#include "ui/DrawList.h"
+#include "ui/Framebuffer.h"
+#include "ui/HeadlessRenderer.h"
+#include "ui/ScriptRunner.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Correctness tests for the simulation, registered with ctest one test per name.
+ *
+ * Usage: IntSimulatorTests [--seed N] [TEST...]   (no TEST runs every test)
+ */
+
+namespace {
+
+using namespace civ;
+using namespace civ::bench;
+
+double relativeDifference(double a, double b) {
+    return std::abs(a - b) / std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+
+// Steps the same ensemble through the scalar path (portable kernels) and the
+// batch path (kernels of the given level), with a random event per row each
+// turn, and reports the largest divergence
+bool batchMatchesScalar(uint32_t seed, SimdLevel level) {
+    constexpr size_t ROWS = 2000;
+    constexpr int TURNS = 200;
+    constexpr double TOLERANCE = 1e-9;
+
+    std::vector<Civilization> civs = makeEnsemble(ROWS, seed);
+    for (size_t i = 0; i < ROWS; i += 4) {
+        buildCity(civs[i], i % 40);   // Every fourth row has a city, some only the town hall
+    }
+    CivilizationBatch batch;
+    batch.reserve(ROWS);
+    for (const auto& civ : civs) {
+        batch.add(civ);
+    }
+
+    EventSystem events;
+    events.init(Difficulty::Hard);
+    const EventCatalog catalog = events.buildCatalog();
+
+    double maxDiff = 0.0;
+    for (int t = 0; t < TURNS; ++t) {
+        std::vector<int> eventIds = makeEventIds(catalog, ROWS);
+        SimdKernels::setLevel(level);
+        batch.applyEvents(catalog, eventIds.data());
+        batch.processTurn();
+        SimdKernels::setLevel(SimdLevel::Scalar);
+        for (size_t i = 0; i < ROWS; ++i) {
+            Civilization& civ = civs[i];
+            civ.applyEvent(catalog.getEvent(eventIds[i]));
+            civ.processTurn();
+
+            maxDiff = std::max(maxDiff, relativeDifference(civ.getPopulation(), batch.getPopulation(i)));
+            maxDiff = std::max(maxDiff, relativeDifference(civ.getHappiness(), batch.getHappiness(i)));
+            maxDiff = std::max(maxDiff, relativeDifference(civ.getEcology(), batch.getEcology(i)));
+            maxDiff = std::max(maxDiff, relativeDifference(civ.getMilitary(), batch.getMilitary(i)));
+            for (int r = 0; r < static_cast<int>(ResourceType::COUNT); ++r) {
+                auto type = static_cast<ResourceType>(r);
+                maxDiff = std::max(maxDiff, relativeDifference(civ.getResources().getResource(type),
+                                                               batch.getResource(i, type)));
+            }
+            if (civ.getStableEconomyTurns() != batch.getStableEconomyTurns(i) ||
+                civ.getTech().getOverallTechLevel() != batch.getOverallTechLevel(i) ||
+                civ.getActiveEffects().activeCount(0) != batch.getActiveEffectCount(i) ||
+                civ.checkGameResult() != batch.checkGameResult(i)) {
+                maxDiff = std::max(maxDiff, 1.0);
+            }
+        }
+    }
+
+    SimdKernels::setLevel(SimdKernels::detect());
+    std::cout << "CivilizationBatch (" << simdLevelToString(level)
+              << ") vs Civilization: max relative difference " << maxDiff
+              << " (" << ROWS << " rows x " << TURNS << " turns)\n";
+    if (maxDiff > TOLERANCE) {
+        std::cerr << "CivilizationBatch diverges from Civilization::processTurn\n";
+        return false;
+    }
+    return true;
+}
+
+bool testBatch(uint32_t seed) {
+    for (int l = 0; l <= static_cast<int>(SimdKernels::detect()); ++l) {
+        if (!batchMatchesScalar(seed, static_cast<SimdLevel>(l))) return false;
+    }
+    return true;
+}
+
+// Ten simulated seconds of the same crowd stepped by the portable kernel and
+// by the given level must end bit for bit the same, and inside the map
+bool settlersMatchScalar(uint32_t seed, SimdLevel level) {
+    constexpr size_t COUNT = 10007;   // Not a multiple of any vector width
+    constexpr int STEPS = 600;
+
+    Utils::seedRandom(seed);
+    SettlerSystem reference = makeSettlers(seed, COUNT);
+    SettlerSystem candidate = reference;
+    SimdKernels::setLevel(SimdLevel::Scalar);
+    for (int i = 0; i < STEPS; ++i) reference.step();
+    SimdKernels::setLevel(level);
+    for (int i = 0; i < STEPS; ++i) candidate.step();
+    SimdKernels::setLevel(SimdKernels::detect());
+
+    size_t mismatched = 0;
+    size_t outside = 0;
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (std::memcmp(&reference.getX()[i], &candidate.getX()[i], sizeof(float)) != 0 ||
+            std::memcmp(&reference.getY()[i], &candidate.getY()[i], sizeof(float)) != 0 ||
+            std::memcmp(&reference.getVX()[i], &candidate.getVX()[i], sizeof(float)) != 0 ||
+            std::memcmp(&reference.getVY()[i], &candidate.getVY()[i], sizeof(float)) != 0) {
+            ++mismatched;
+        }
+        float x = candidate.getX()[i];
+        float y = candidate.getY()[i];
+        if (!(x >= 0.0f && x <= candidate.getWidth() && y >= 0.0f && y <= candidate.getHeight())) {
+            ++outside;
+        }
+    }
+
+    std::cout << "SettlerSystem (" << simdLevelToString(level) << ") vs scalar: " << mismatched
+              << " of " << COUNT << " settlers differ after " << STEPS << " steps, " << outside
+              << " off the map\n";
+    if (mismatched > 0 || outside > 0) {
+        std::cerr << "The " << simdLevelToString(level) << " settler kernel diverges from the scalar one\n";
+        return false;
+    }
+    return true;
+}
+
+bool testSettlers(uint32_t seed) {
+    for (int l = 0; l <= static_cast<int>(SimdKernels::detect()); ++l) {
+        if (!settlersMatchScalar(seed, static_cast<SimdLevel>(l))) return false;
+    }
+    return true;
+}
+
+// Plays the same seeded games turn by turn and with FastForward and requires identical
+// civilizations, event histories and random streams. Then cuts games into short runs of
+// skipQuietTurns against the same runs drawn and stepped one turn at a time, so every stop
+// (turn limit, event, era change, game over) is compared with the random stream it leaves.
+bool testFastForward(uint32_t seed) {
+    constexpr uint32_t GAMES = 50;
+    constexpr uint32_t CUT_GAMES = 200;
+
+    int mismatches = 0;
+    long long totalTurns = 0;
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Civilization stepped;
+        EventSystem steppedEvents;
+        newHeadlessGame(stepped, steppedEvents);
+        int steppedTurns = playHeadless(seed + g, false, stepped, steppedEvents);
+        int steppedNext = Utils::randomInt(0, 1 << 30);
+
+        Civilization skipped;
+        EventSystem skippedEvents;
+        newHeadlessGame(skipped, skippedEvents);
+        int skippedTurns = playHeadless(seed + g, true, skipped, skippedEvents);
+        int skippedNext = Utils::randomInt(0, 1 << 30);
+
+        totalTurns += steppedTurns;
+        if (steppedTurns != skippedTurns || steppedNext != skippedNext ||
+            stepped.serialize() != skipped.serialize() ||
+            steppedEvents.serialize() != skippedEvents.serialize()) {
+            ++mismatches;
+        }
+    }
+
+    // Research after every turn, as a player would, so quiet years also cross into new eras
+    auto research = [](Civilization& civ) {
+        civ.getTech().investInBranch(static_cast<TechBranch>(civ.getTurn() % static_cast<int>(TechBranch::COUNT)), 60.0);
+    };
+    // One turn at a time: a roll, then the quiet year stepped or the event drawn
+    auto stepQuietTurns = [&research](Civilization& civ, EventSystem& events, int maxTurns) {
+        FastForwardResult result;
+        const Era startEra = civ.getCurrentEra();
+        while (result.quietTurns < maxTurns) {
+            if (!events.hasEvents(civ.getCurrentEra())) {
+                result.stop = FastForwardStop::NoEvents;
+                return result;
+            }
+            if (!events.rollQuietYear()) {
+                result.event = events.pickEvent(civ);
+                result.stop = FastForwardStop::Event;
+                return result;
+            }
+            events.recordEvent(events.getQuietYear());
+            civ.applyEvent(events.getQuietYear());
+            civ.processTurn();
+            research(civ);
+            result.quietTurns++;
+            if (civ.checkGameResult() != GameResult::InProgress) {
+                result.stop = FastForwardStop::GameOver;
+                return result;
+            }
+            if (civ.getCurrentEra() != startEra) {
+                result.stop = FastForwardStop::EraChange;
+                return result;
+            }
+        }
+        return result;
+    };
+
+    std::array<int, 5> stops{};
+    for (uint32_t g = 0; g < CUT_GAMES && mismatches == 0; ++g) {
+        Civilization stepped;
+        EventSystem steppedEvents;
+        newHeadlessGame(stepped, steppedEvents);
+        Civilization skipped = stepped;
+        EventSystem skippedEvents = steppedEvents;
+        Utils::seedRandom(seed + GAMES + g);
+        std::mt19937 steppedRandom = Utils::getRandomState();
+        std::mt19937 skippedRandom = steppedRandom;
+
+        for (int cut = 0; cut < 2000 && stepped.checkGameResult() == GameResult::InProgress; ++cut) {
+            const int maxTurns = 1 + cut % 4;
+            Utils::setRandomState(steppedRandom);
+            FastForwardResult expected = stepQuietTurns(stepped, steppedEvents, maxTurns);
+            steppedRandom = Utils::getRandomState();
+            Utils::setRandomState(skippedRandom);
+            FastForwardResult actual = FastForward::skipQuietTurns(skipped, skippedEvents, maxTurns, true, research);
+            skippedRandom = Utils::getRandomState();
+
+            stops[static_cast<size_t>(actual.stop)]++;
+            if (actual.quietTurns != expected.quietTurns || actual.stop != expected.stop ||
+                actual.event.name != expected.event.name || steppedRandom != skippedRandom ||
+                stepped.serialize() != skipped.serialize() ||
+                steppedEvents.serialize() != skippedEvents.serialize()) {
+                ++mismatches;
+                break;
+            }
+            if (expected.stop == FastForwardStop::Event) {
+                steppedEvents.recordEvent(expected.event);
+                stepped.applyEvent(expected.event);
+                stepped.processTurn();
+                research(stepped);
+                skippedEvents.recordEvent(actual.event);
+                skipped.applyEvent(actual.event);
+                skipped.processTurn();
+                research(skipped);
+            }
+        }
+    }
+    bool everyStop = stops[static_cast<size_t>(FastForwardStop::TurnLimit)] > 0 &&
+                     stops[static_cast<size_t>(FastForwardStop::Event)] > 0 &&
+                     stops[static_cast<size_t>(FastForwardStop::EraChange)] > 0 &&
+                     stops[static_cast<size_t>(FastForwardStop::GameOver)] > 0;
+
+    std::cout << "FastForward vs turn-by-turn: " << mismatches << " mismatching games of " << GAMES + CUT_GAMES
+              << " (" << totalTurns << " turns); cut runs stopped on the turn limit "
+              << stops[static_cast<size_t>(FastForwardStop::TurnLimit)] << ", an event "
+              << stops[static_cast<size_t>(FastForwardStop::Event)] << ", an era change "
+              << stops[static_cast<size_t>(FastForwardStop::EraChange)] << ", game over "
+              << stops[static_cast<size_t>(FastForwardStop::GameOver)] << " times\n";
+    if (mismatches > 0 || !everyStop) {
+        std::cerr << "FastForward diverges from turn-by-turn stepping, or a stop was never reached\n";
+        return false;
+    }
+    return true;
+}
+
+// Plays seeded games with investment and research every turn and compares the cached
+// available and researched lists with a scan of the whole tree after each turn. The list
+// version must change whenever the lists do.
+bool testTechListCache(uint32_t seed) {
+    constexpr uint32_t GAMES = 50;
+
+    uint64_t checks = 0;
+    uint64_t rebuilds = 0;
+    uint64_t bad = 0;
+    std::vector<TechId> available;
+    std::vector<TechId> researched;
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Utils::seedRandom(seed + g);
+        Civilization civ;
+        EventSystem events;
+        events.init(Difficulty::Normal);
+
+        std::vector<TechId> lastAvailable = civ.getTech().getAvailableIds();
+        std::vector<TechId> lastResearched = civ.getTech().getResearchedIds();
+        uint64_t lastVersion = civ.getTech().getListVersion();
+        for (int turn = 0; turn < 400 && civ.checkGameResult() == GameResult::InProgress; ++turn) {
+            GameEvent event = events.generateEvent(civ);
+            events.recordEvent(event);
+            civ.applyEvent(event);
+            civ.processTurn();
+
+            double money = civ.getResources().getResource(ResourceType::Money);
+            if (money > 0) {
+                civ.getResources().removeResource(ResourceType::Money, money * 0.3);
+                civ.getTech().investInBranch(static_cast<TechBranch>(turn % static_cast<int>(TechBranch::COUNT)),
+                                             money * 0.3);
+            }
+            const Technology* cheapest = civ.getTech().getCheapestAvailable();
+            if (cheapest && civ.getResources().getResource(ResourceType::Money) >= cheapest->cost) {
+                civ.getResources().removeResource(ResourceType::Money, cheapest->cost);
+                civ.getTech().researchTech(cheapest->name);
+            }
+
+            const TechnologyTree& tree = civ.getTech();
+            available.clear();
+            researched.clear();
+            for (size_t i = 0; i < tree.getTechnologyCount(); ++i) {
+                auto id = static_cast<TechId>(i);
+                if (tree.getTechnology(id).researched) researched.push_back(id);
+                if (tree.isAvailable(id)) available.push_back(id);
+            }
+            if (available != tree.getAvailableIds() || researched != tree.getResearchedIds()) ++bad;
+
+            bool listsChanged = available != lastAvailable || researched != lastResearched;
+            bool versionChanged = tree.getListVersion() != lastVersion;
+            if (listsChanged && !versionChanged) ++bad;
+            if (versionChanged) ++rebuilds;
+            lastAvailable = available;
+            lastResearched = researched;
+            lastVersion = tree.getListVersion();
+            ++checks;
+        }
+    }
+
+    std::cout << "Tech list cache: " << checks << " turns checked, " << rebuilds << " with a new list version, "
+              << bad << " stale\n";
+    if (bad > 0) {
+        std::cerr << "TechnologyTree's cached lists differ from the tree\n";
+        return false;
+    }
+    return true;
+}
+
+// Places and removes buildings at random and compares the city's running totals with a
+// sum over every building after each change
+bool testCityTotals(uint32_t seed) {
+    constexpr int OPERATIONS = 20000;
+
+    Utils::seedRandom(seed);
+    Civilization civ;
+    buildCity(civ, 200);
+    CityModel& city = civ.getCity();
+    ResourceManager budget;
+    budget.addResource(ResourceType::Money, 1e12);
+    budget.addResource(ResourceType::Materials, 1e12);
+    const auto& defs = CityModel::getBuildingDefs();
+
+    int bad = city.getBuildings().size() == 200 ? 0 : 1;
+    size_t placed = 0;
+    for (int op = 0; op < OPERATIONS; ++op) {
+        if (!city.getBuildings().empty() && Utils::randomChance(0.5)) {
+            city.remove(static_cast<size_t>(Utils::randomInt(0, static_cast<int>(city.getBuildings().size()) - 1)));
+        } else {
+            auto x = static_cast<float>(Utils::randomDouble(-2000.0, 2000.0));
+            auto y = static_cast<float>(Utils::randomDouble(-2000.0, 2000.0));
+            auto def = static_cast<size_t>(Utils::randomInt(0, static_cast<int>(defs.size()) - 1));
+            if (city.place(def, x, y, Era::Space, budget) == PlaceResult::Placed) ++placed;
+        }
+
+        CityYield expected;
+        expected.housing = CityModel::TOWN_HALL_HOUSING;
+        for (const auto& building : city.getBuildings()) {
+            const BuildingDef& def = defs[building.def];
+            expected.housing += def.housing;
+            for (size_t r = 0; r < def.yield.size(); ++r) {
+                expected.resources[r] += def.yield[r];
+                expected.productionBonus[r] += def.productionBonus[r];
+            }
+            expected.military += def.military;
+        }
+        const CityYield& totals = city.getTotals();
+        if (totals.housing != expected.housing || totals.resources != expected.resources ||
+            totals.military != expected.military) {
+            ++bad;
+        }
+        // Fractional bonuses: the running sum may differ from a fresh sum in the last bits
+        for (size_t r = 0; r < totals.productionBonus.size(); ++r) {
+            if (std::abs(totals.productionBonus[r] - expected.productionBonus[r]) > 1e-9) ++bad;
+        }
+    }
+
+    Civilization restored;
+    restored.deserialize(civ.serialize());
+    if (restored.getCity().getBuildings().size() != city.getBuildings().size() ||
+        restored.getCity().getTotals().housing != city.getTotals().housing) {
+        ++bad;
+    }
+
+    std::cout << "CityModel: " << OPERATIONS << " random changes (" << placed << " placed), "
+              << city.getBuildings().size() << " buildings left, " << bad << " wrong totals\n";
+    if (bad > 0) {
+        std::cerr << "CityModel's running totals differ from its buildings\n";
+        return false;
+    }
+    return true;
+}
+
+// Random adds, updates, removes, source removals and turns against a list of the live
+// modifiers: the running aggregates must match a fresh sum and product, handles of gone
+// modifiers must stay dead after their slot is reused, and emptying the stack must give
+// back exactly 1.0. A city's buildings then register Building modifiers next to the tech ones.
+bool testModifiers(uint32_t seed) {
+    constexpr int OPERATIONS = 20000;
+    constexpr size_t TARGETS = ModifierStack::NUM_TARGETS;
+    constexpr size_t RESOURCES = ModifierStack::NUM_RESOURCES;
+    struct Live {
+        ModifierId id;
+        Modifier modifier;
+    };
+
+    Utils::seedRandom(seed);
+    ModifierStack stack;
+    std::vector<Live> live;
+    std::vector<ModifierId> dead;
+    int bad = 0;
+    int expired = 0;
+
+    auto kill = [&](size_t i) {
+        dead.push_back(live[i].id);
+        live[i] = live.back();
+        live.pop_back();
+    };
+
+    for (int op = 0; op < OPERATIONS; ++op) {
+        int kind = Utils::randomInt(0, 9);
+        if (kind <= 3 || live.empty()) {
+            Modifier modifier;
+            modifier.source = static_cast<ModifierSource>(Utils::randomInt(0, static_cast<int>(ModifierSource::COUNT) - 1));
+            modifier.target = static_cast<ModifierTarget>(Utils::randomInt(0, static_cast<int>(TARGETS) - 1));
+            modifier.resource = static_cast<ResourceType>(Utils::randomInt(0, static_cast<int>(RESOURCES) - 1));
+            modifier.additive = Utils::randomDouble(-0.5, 0.5);
+            modifier.multiplier = Utils::randomDouble(0.5, 2.0);
+            modifier.turns = Utils::randomChance(0.5) ? Utils::randomInt(1, 100) : Modifier::PERMANENT;
+            ModifierId id = stack.add(modifier);
+            if (!id.isSet()) ++bad;
+            live.push_back({ id, modifier });
+        } else if (kind <= 5) {
+            auto i = static_cast<size_t>(Utils::randomInt(0, static_cast<int>(live.size()) - 1));
+            double additive = Utils::randomDouble(-0.5, 0.5);
+            double multiplier = Utils::randomDouble(0.5, 2.0);
+            if (!stack.update(live[i].id, additive, multiplier)) ++bad;
+            live[i].modifier.additive = additive;
+            live[i].modifier.multiplier = multiplier;
+        } else if (kind <= 7) {
+            auto i = static_cast<size_t>(Utils::randomInt(0, static_cast<int>(live.size()) - 1));
+            if (!stack.remove(live[i].id)) ++bad;
+            kill(i);
+        } else if (kind == 8) {
+            stack.advanceTurn();
+            for (size_t i = live.size(); i-- > 0;) {
+                Modifier& modifier = live[i].modifier;
+                if (modifier.turns != Modifier::PERMANENT && --modifier.turns == 0) {
+                    kill(i);
+                    ++expired;
+                }
+            }
+        } else if (Utils::randomChance(0.05)) {
+            auto source = static_cast<ModifierSource>(Utils::randomInt(0, static_cast<int>(ModifierSource::COUNT) - 1));
+            stack.removeSource(source);
+            for (size_t i = live.size(); i-- > 0;) {
+                if (live[i].modifier.source == source) kill(i);
+            }
+        }
+
+        // A zero multiplier is refused and leaves the stack as it was
+        if (op % 1000 == 0) {
+            Modifier zero;
+            zero.multiplier = 0.0;
+            if (stack.add(zero).isSet()) ++bad;
+            if (!live.empty() && stack.update(live[0].id, 1.0, 0.0)) ++bad;
+        }
+
+        if (stack.size() != live.size()) ++bad;
+        for (const Live& entry : live) {
+            const Modifier* modifier = stack.get(entry.id);
+            if (!modifier || modifier->additive != entry.modifier.additive ||
+                modifier->multiplier != entry.modifier.multiplier) {
+                ++bad;
+            }
+        }
+        if (!dead.empty()) {
+            ModifierId id = dead[static_cast<size_t>(Utils::randomInt(0, static_cast<int>(dead.size()) - 1))];
+            if (stack.get(id) || stack.update(id, 0.0, 1.0) || stack.remove(id)) ++bad;
+        }
+
+        std::array<std::array<double, RESOURCES>, TARGETS> additive{};
+        std::array<std::array<double, RESOURCES>, TARGETS> product{};
+        for (auto& target : product) target.fill(1.0);
+        for (const Live& entry : live) {
+            auto t = static_cast<size_t>(entry.modifier.target);
+            auto r = static_cast<size_t>(entry.modifier.resource);
+            additive[t][r] += entry.modifier.additive;
+            product[t][r] *= entry.modifier.multiplier;
+        }
+        for (size_t t = 0; t < TARGETS; ++t) {
+            for (size_t r = 0; r < RESOURCES; ++r) {
+                double expected = (1.0 + additive[t][r]) * product[t][r];
+                double actual = stack.getMultiplier(static_cast<ModifierTarget>(t), static_cast<ResourceType>(r));
+                if (relativeDifference(actual, expected) > 1e-9) ++bad;
+            }
+        }
+    }
+
+    // Everything gone: exactly the identity, whatever rounding the aggregates went through
+    while (!live.empty()) {
+        if (!stack.remove(live.back().id)) ++bad;
+        live.pop_back();
+    }
+    for (size_t t = 0; t < TARGETS; ++t) {
+        for (size_t r = 0; r < RESOURCES; ++r) {
+            if (stack.getMultiplier(static_cast<ModifierTarget>(t), static_cast<ResourceType>(r)) != 1.0) ++bad;
+        }
+    }
+    if (stack.size() != 0) ++bad;
+
+    // A city with factories and power plants: Building modifiers next to the Industry ones,
+    // gone with the buildings
+    Civilization civ;
+    buildCity(civ, 70);
+    civ.processTurn();
+    const ModifierStack& modifiers = civ.getResources().getModifiers();
+    double tech = TechnologyTree::productionBonusForLevel(civ.getTech().getBranchLevel(TechBranch::Industry));
+    const CityYield& totals = civ.getCity().getTotals();
+    auto production = [&](ResourceType type) { return modifiers.getMultiplier(ModifierTarget::Production, type); };
+    if (production(ResourceType::Materials) != (1.0 + totals.productionBonus[static_cast<size_t>(ResourceType::Materials)]) * tech ||
+        production(ResourceType::Energy) != (1.0 + totals.productionBonus[static_cast<size_t>(ResourceType::Energy)]) * tech ||
+        production(ResourceType::Food) != 1.0 || modifiers.size() != 4) {
+        ++bad;
+    }
+    while (!civ.getCity().getBuildings().empty()) civ.getCity().remove(0);
+    civ.processTurn();
+    tech = TechnologyTree::productionBonusForLevel(civ.getTech().getBranchLevel(TechBranch::Industry));
+    if (production(ResourceType::Materials) != tech || production(ResourceType::Energy) != tech ||
+        modifiers.size() != 2) {
+        ++bad;
+    }
+
+    std::cout << "ModifierStack: " << OPERATIONS << " random changes (" << expired << " expired), "
+              << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "ModifierStack's running aggregates or handles differ from its modifiers\n";
+        return false;
+    }
+    return true;
+}
+
+// Random inserts, moves and removes, each followed by queries checked against
+// a linear scan of the same points
+bool testSpatialGrid(uint32_t seed) {
+    constexpr int OPERATIONS = 20000;
+    struct Point {
+        uint32_t id;
+        float x, y;
+    };
+
+    Utils::seedRandom(seed);
+    SpatialHashGrid grid(22.0f);
+    std::vector<Point> points;
+    uint32_t nextId = 0;
+    auto randomCoordinate = [] {
+        // Mostly a dense map, sometimes far away or on a cell edge
+        if (Utils::randomChance(0.05)) return static_cast<float>(Utils::randomDouble(-1e6, 1e6));
+        if (Utils::randomChance(0.05)) return 22.0f * static_cast<float>(Utils::randomInt(-20, 20));
+        return static_cast<float>(Utils::randomDouble(-400.0, 400.0));
+    };
+
+    int bad = 0;
+    for (int op = 0; op < OPERATIONS; ++op) {
+        double roll = Utils::randomDouble(0.0, 1.0);
+        if (points.empty() || roll < 0.5) {
+            Point p{ nextId++, randomCoordinate(), randomCoordinate() };
+            grid.insert(p.id, p.x, p.y);
+            points.push_back(p);
+        } else {
+            auto index = static_cast<size_t>(Utils::randomInt(0, static_cast<int>(points.size()) - 1));
+            Point& p = points[index];
+            if (roll < 0.75) {
+                float x = Utils::randomChance(0.5) ? p.x + 3.0f : randomCoordinate();
+                float y = randomCoordinate();
+                grid.move(p.id, p.x, p.y, x, y);
+                p.x = x;
+                p.y = y;
+            } else {
+                if (!grid.remove(p.id, p.x, p.y)) ++bad;
+                points[index] = points.back();
+                points.pop_back();
+            }
+        }
+        if (grid.size() != points.size()) ++bad;
+
+        float qx = randomCoordinate();
+        float qy = randomCoordinate();
+        float radius = static_cast<float>(Utils::randomDouble(0.0, Utils::randomChance(0.01) ? 5000.0 : 60.0));
+        bool anyCloser = false;
+        size_t within = 0;
+        uint32_t nearest = SpatialHashGrid::NONE;
+        float nearestSq = radius * radius;
+        for (const Point& p : points) {
+            float dx = p.x - qx;
+            float dy = p.y - qy;
+            float distSq = dx * dx + dy * dy;
+            anyCloser = anyCloser || distSq < radius * radius;
+            if (distSq <= radius * radius) ++within;
+            if (distSq < nearestSq || (distSq == nearestSq && p.id < nearest)) {
+                nearest = p.id;
+                nearestSq = distSq;
+            }
+        }
+        size_t found = 0;
+        grid.forEachWithin(qx, qy, radius, [&found](uint32_t, float, float) { ++found; });
+        if (grid.anyCloserThan(qx, qy, radius) != anyCloser || grid.nearest(qx, qy, radius) != nearest ||
+            found != within) {
+            ++bad;
+        }
+    }
+
+    std::cout << "SpatialHashGrid: " << OPERATIONS << " random changes, " << points.size()
+              << " points left, " << bad << " wrong answers\n";
+    if (bad > 0) {
+        std::cerr << "SpatialHashGrid disagrees with a linear scan\n";
+        return false;
+    }
+    return true;
+}
+
+// Fields grown incrementally must hold the same distances as fields built
+// from scratch, and following the steps from any cell must reach a source
+bool testFlowFields(uint32_t seed) {
+    Utils::seedRandom(seed);
+    Civilization civ;
+    CityFlowFields incremental;
+    buildMapCity(civ, incremental, 400);
+    CityFlowFields rebuilt;
+    rebuilt.resize(1140.0f, 750.0f);
+    rebuilt.rebuild(civ.getCity());
+
+    const float cell = CityFlowFields::CELL_SIZE;
+    size_t wrongDistances = 0;
+    size_t lostWalks = 0;
+    for (size_t target = 0; target < rebuilt.getTargetCount(); ++target) {
+        if (!rebuilt.hasSources(target)) continue;
+        for (float y = cell * 0.5f; y < 750.0f; y += cell) {
+            for (float x = cell * 0.5f; x < 1140.0f; x += cell) {
+                if (incremental.distance(target, x, y) != rebuilt.distance(target, x, y)) ++wrongDistances;
+            }
+        }
+        for (int walk = 0; walk < 50; ++walk) {
+            float x = std::floor(static_cast<float>(Utils::randomDouble(0.0, 1140.0)) / cell) * cell + cell * 0.5f;
+            float y = std::floor(static_cast<float>(Utils::randomDouble(0.0, 750.0)) / cell) * cell + cell * 0.5f;
+            float dx = 0.0f;
+            float dy = 0.0f;
+            int steps = 0;
+            while (incremental.direction(target, x, y, dx, dy) && steps < 1000) {
+                uint16_t before = incremental.distance(target, x, y);
+                x += std::round(dx * 1.2f) * cell;   // One cell along the unit step
+                y += std::round(dy * 1.2f) * cell;
+                if (incremental.distance(target, x, y) >= before) break;
+                ++steps;
+            }
+            if (incremental.distance(target, x, y) != 0) ++lostWalks;
+        }
+    }
+
+    std::cout << "CityFlowFields: " << civ.getCity().getBuildings().size() << " buildings added one by one, "
+              << wrongDistances << " cells differ from a rebuild, " << lostWalks << " walks lost\n";
+    if (wrongDistances > 0 || lostWalks > 0) {
+        std::cerr << "Incrementally updated flow fields differ from rebuilt ones\n";
+        return false;
+    }
+    return true;
+}
+
+// A small scene recorded out of layer order, with clipped dots, a covered
+// dot, a triangle and a frame, checked by counting pixels of each colour
+bool testCityMapRender(uint32_t) {
+    constexpr uint32_t RED = 0xFF0000, GREEN = 0x00FF00, BLUE = 0x0000FF, WHITE = 0xFFFFFF;
+    Framebuffer frame;
+    frame.resize(64, 48);
+    DrawList list;
+    const float xs[] = { 15.0f, -1.0f, 63.5f };
+    const float ys[] = { 15.0f, -1.0f, 47.5f };
+    list.frameRect(3, 0, 40, 10, 48, WHITE);
+    list.fillTriangle(3, 30, 10, 40, 30, 20, 30, BLUE);
+    list.fillRect(2, 10, 10, 20, 20, RED);
+    list.dots(1, xs, ys, 3, 4, GREEN);
+    list.fillRect(0, 0, 0, 64, 48, 0x000000);
+    list.sort();
+    list.rasterize(frame);
+
+    size_t red = 0, green = 0, blue = 0, white = 0;
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        for (int x = 0; x < frame.getWidth(); ++x) {
+            switch (frame.pixel(x, y) & 0xFFFFFF) {
+                case RED: ++red; break;
+                case GREEN: ++green; break;
+                case BLUE: ++blue; break;
+                case WHITE: ++white; break;
+                default: break;
+            }
+        }
+    }
+
+    int bad = 0;
+    if (red != 100) ++bad;                   // Covers the dot at (15, 15)
+    if (green != 1 + 9) ++bad;               // Corner dots clipped to 1x1 and 3x3
+    if (blue < 200 || blue > 230) ++bad;     // Area 200 plus the edge pixels counted inside
+    if (white != 2 * 10 + 2 * 6) ++bad;
+    if (list.countBatches() != 5) ++bad;
+
+    std::ostringstream ppm;
+    frame.writePpm(ppm);
+    const std::string header = "P6\n64 48\n255\n";
+    if (ppm.str().size() != header.size() + 64 * 48 * 3 || ppm.str().compare(0, header.size(), header) != 0) ++bad;
+
+    // Drawing and hit-testing of the HUD share one layout
+    for (Era era : { Era::StoneAge, Era::IronAge, Era::Space }) {
+        for (int i = 0; i < static_cast<int>(CityModel::getBuildingDefs().size()); ++i) {
+            int left = CityMapRenderer::hudItemLeft(i, era);
+            if (left < 0) continue;
+            if (CityMapRenderer::hudItemAt(left, era) != i ||
+                CityMapRenderer::hudItemAt(left + CityMapRenderer::HUD_ITEM_WIDTH - 1, era) != i ||
+                CityMapRenderer::hudItemAt(left + CityMapRenderer::HUD_ITEM_WIDTH, era) != -1) {
+                ++bad;
+            }
+        }
+    }
+
+    std::cout << "DrawList: " << list.size() << " commands in " << list.countBatches() << " batches, "
+              << red << "/" << green << "/" << blue << "/" << white << " red/green/blue/white pixels, "
+              << bad << " wrong checks\n";
+    if (bad > 0) {
+        std::cerr << "The software rasterizer drew the test scene wrong\n";
+        return false;
+    }
+    return true;
+}
+
+// Drives one TripleBuffer from a single thread: two publishes before an update
+// must hand over the second value, an update with nothing new must report false,
+// and the writer's back buffer must never be the one the reader holds
+bool testTripleBuffer(uint32_t) {
+    TripleBuffer<int> buffer;
+    int bad = buffer.update() ? 1 : 0;   // Nothing published yet
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+    if (!buffer.update() || buffer.front() != 2) ++bad;
+    if (buffer.update() || buffer.front() != 2) ++bad;
+
+    for (int value = 3; value < 100; ++value) {
+        if (&buffer.back() == &buffer.front()) ++bad;
+        buffer.back() = value;
+        buffer.publish();
+        if (value % 3 == 0) continue;   // Some values are overtaken before the reader looks
+        if (!buffer.update() || buffer.front() != value) ++bad;
+    }
+
+    std::cout << "TripleBuffer: " << bad << " wrong handovers\n";
+    if (bad > 0) {
+        std::cerr << "TripleBuffer handed over a stale or missing value\n";
+        return false;
+    }
+    return true;
+}
+
+// Plays seeded games on this thread, publishing a snapshot per turn, while a renderer
+// thread draws the latest one as fast as it can. Every snapshot the renderer sees must be
+// newer than the last and match the state the simulation had when it published it.
+bool testSnapshotPublishing(uint32_t seed) {
+    constexpr uint32_t GAMES = 200;
+    constexpr size_t MAX_PUBLISHED = GAMES * 2000;
+
+    struct Expected {
+        int turn = 0;
+        int population = 0;
+        double money = 0.0;
+    };
+    std::vector<Expected> expected(MAX_PUBLISHED + 1);
+
+    SnapshotChannel channel;
+    std::atomic<bool> started{ false };
+    std::atomic<bool> done{ false };
+    uint64_t framesChecked = 0;
+    uint64_t bad = 0;
+
+    std::thread renderer([&] {
+        HeadlessRenderer view;
+        uint64_t last = 0;
+        auto check = [&] {
+            const GameSnapshot& snapshot = channel.latest();
+            const Expected& e = expected[snapshot.sequence];
+            if (snapshot.sequence <= last || snapshot.turn != e.turn || snapshot.population != e.population ||
+                snapshot.resources[static_cast<size_t>(ResourceType::Money)] != e.money) {
+                ++bad;
+            }
+            last = snapshot.sequence;
+            view.render(snapshot);
+            ++framesChecked;
+        };
+        started.store(true, std::memory_order_release);
+        while (!done.load(std::memory_order_acquire)) {
+            if (channel.update()) check();
+        }
+        if (channel.update()) check();
+        if (last != channel.published()) ++bad;   // The final snapshot must arrive
+    });
+
+    while (!started.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    Civilization civ;
+    EventSystem events;
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Utils::seedRandom(seed + g);
+        civ = Civilization();
+        events.init(Difficulty::Normal);
+        while (civ.checkGameResult() == GameResult::InProgress && channel.published() < MAX_PUBLISHED) {
+            GameEvent event = events.generateEvent(civ);
+            events.recordEvent(event);
+            civ.applyEvent(event);
+            civ.processTurn();
+            // Written before publish: the exchange in publish() orders it for the reader
+            expected[channel.published() + 1] = Expected{ civ.getTurn(), civ.getPopulation(),
+                                                          civ.getResources().getResource(ResourceType::Money) };
+            channel.publish(civ, events);
+        }
+    }
+    done.store(true, std::memory_order_release);
+    renderer.join();
+
+    std::cout << "Snapshots: " << channel.published() << " published, " << framesChecked
+              << " rendered, " << bad << " torn or out of order\n";
+    if (bad > 0) {
+        std::cerr << "SnapshotChannel handed the renderer an inconsistent snapshot\n";
+        return false;
+    }
+    return true;
+}
+
+// Plays seeded games turn by turn, updating a GameViewModel after each turn and after a
+// money-only action. Whenever a status section's text changes, the view model must have
+// flagged that section; a section it skips would be left stale on screen.
+bool testViewModelDiffs(uint32_t seed) {
+    constexpr uint32_t GAMES = 50;
+
+    struct Section {
+        ViewChange mask;
+        std::string text;
+    };
+
+    uint64_t updates = 0;
+    uint64_t redrawn = 0;
+    uint64_t sections = 0;
+    uint64_t stale = 0;
+
+    GameViewModel view;
+    Civilization civ;
+    EventSystem events;
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Utils::seedRandom(seed + g);
+        civ = Civilization();
+        events.init(Difficulty::Normal);
+        view.invalidate();
+
+        std::array<Section, 3> shown = { Section{ ViewChange::Civ, {} },
+                                         Section{ ViewChange::Resources | ViewChange::Income, {} },
+                                         Section{ ViewChange::Tech, {} } };
+        auto check = [&](ViewChanges changes) {
+            const std::array<std::string, 3> texts = { civ.getStatusString(),
+                                                       civ.getResources().getStatusString(),
+                                                       civ.getTech().getStatusString() };
+            for (size_t s = 0; s < shown.size(); ++s) {
+                if (changes.any(shown[s].mask)) {
+                    ++redrawn;
+                } else if (texts[s] != shown[s].text) {
+                    ++stale;
+                }
+                shown[s].text = texts[s];
+            }
+            sections += shown.size();
+            ++updates;
+        };
+
+        check(view.update(civ, events));
+        for (int turn = 0; turn < 300 && civ.checkGameResult() == GameResult::InProgress; ++turn) {
+            GameEvent event = events.generateEvent(civ);
+            events.recordEvent(event);
+            civ.applyEvent(event);
+            civ.processTurn();
+            check(view.update(civ, events));
+
+            // Nothing happened: nothing to redraw
+            if (view.update(civ, events).any()) ++stale;
+
+            if (turn % 10 == 0) {
+                double amount = civ.getResources().getResource(ResourceType::Money) * 0.1;
+                civ.getResources().addResource(ResourceType::Money, -amount);
+                ViewChanges changes = view.update(civ, events);
+                if (changes.any(ViewChange::Turn | ViewChange::Civ | ViewChange::Events)) ++stale;
+                check(changes);
+            }
+        }
+    }
+
+    std::cout << "GameViewModel: " << updates << " updates, " << redrawn << " of " << sections
+              << " sections redrawn, " << stale << " stale or spurious\n";
+    if (stale > 0) {
+        std::cerr << "GameViewModel missed or invented a change\n";
+        return false;
+    }
+    return true;
+}
+
+// An event lasting three turns takes a third of its effect on the turn it happens and a
+// third on each of the next two, in Civilization and CivilizationBatch alike. Money is
+// compared with an untouched copy after every turn, along with the lingering effect count.
+bool testLingeringEffects(uint32_t) {
+    constexpr int TURNS = 5;
+    constexpr double EXPECTED_MONEY[TURNS] = { -30.0, -60.0, -90.0, -90.0, -90.0 };
+    constexpr int EXPECTED_ACTIVE[TURNS] = { 1, 1, 0, 0, 0 };
+
+    GameEvent quiet;
+    quiet.name = "quiet";
+    GameEvent drain;
+    drain.name = "drain";
+    drain.economyEffect = -90.0;
+    drain.duration = 3;
+
+    EventCatalog catalog;
+    const int quietId = catalog.add(quiet);
+    const int drainId = catalog.add(drain);
+
+    Civilization civ;
+    Civilization control = civ;
+    CivilizationBatch batch;
+    batch.add(civ);
+    batch.add(control);
+
+    int bad = 0;
+    auto money = [](const Civilization& c) { return c.getResources().getResource(ResourceType::Money); };
+    for (int turn = 0; turn < TURNS; ++turn) {
+        const int eventIds[2] = { turn == 0 ? drainId : quietId, quietId };
+        civ.applyEvent(catalog.getEvent(eventIds[0]));
+        civ.processTurn();
+        control.applyEvent(catalog.getEvent(eventIds[1]));
+        control.processTurn();
+        batch.applyEvents(catalog, eventIds);
+        batch.processTurn();
+
+        double scalarDrain = money(civ) - money(control);
+        double batchDrain = batch.getResource(0, ResourceType::Money) - batch.getResource(1, ResourceType::Money);
+        if (std::abs(scalarDrain - EXPECTED_MONEY[turn]) > 1e-9 || std::abs(batchDrain - EXPECTED_MONEY[turn]) > 1e-9 ||
+            civ.getActiveEffects().activeCount(0) != EXPECTED_ACTIVE[turn] ||
+            batch.getActiveEffectCount(0) != EXPECTED_ACTIVE[turn]) {
+            std::cerr << "turn " << turn + 1 << ": money " << scalarDrain << " (batch " << batchDrain
+                      << "), expected " << EXPECTED_MONEY[turn] << "; active " << civ.getActiveEffects().activeCount(0)
+                      << " (batch " << batch.getActiveEffectCount(0) << "), expected " << EXPECTED_ACTIVE[turn] << "\n";
+            ++bad;
+        }
+    }
+
+    std::cout << "ActiveEffects: 3-turn event over " << TURNS << " turns, " << bad << " wrong turns\n";
+    if (bad > 0) {
+        std::cerr << "A lingering event does not spread over its duration\n";
+        return false;
+    }
+    return true;
+}
+
+// The buffer formatters against the std::string versions they replaced (kept here as
+// they were): separators, signs, fixed precision with its rounding, bars and padding.
+// Padding now counts UTF-8 code points, so the old byte counts are compared on ASCII
+// only and Cyrillic is checked against its column count.
+bool testFormatting(uint32_t seed) {
+    constexpr int RANDOM_VALUES = 20000;
+
+    auto oldFormatNumber = [](int64_t number) {
+        std::string numStr = std::to_string(number < 0 ? -number : number);
+        std::string result;
+        int count = 0;
+        for (auto it = numStr.rbegin(); it != numStr.rend(); ++it) {
+            if (count > 0 && count % 3 == 0) result = ',' + result;
+            result = *it + result;
+            ++count;
+        }
+        if (number < 0) result = '-' + result;
+        return result;
+    };
+    auto oldFormatDouble = [](double value, int precision) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(precision) << value;
+        return oss.str();
+    };
+    auto oldProgressBar = [](double value, double maxValue, int width) {
+        double ratio = (maxValue > 0.0) ? Utils::clamp(value / maxValue, 0.0, 1.0) : 0.0;
+        int filled = static_cast<int>(std::round(ratio * width));
+        std::string bar = "[";
+        for (int i = 0; i < filled; ++i) bar += '#';
+        for (int i = filled; i < width; ++i) bar += '-';
+        return bar + "]";
+    };
+    auto oldPadRight = [](const std::string& str, size_t width, char fill) {
+        return str.size() >= width ? str : str + std::string(width - str.size(), fill);
+    };
+    auto oldPadLeft = [](const std::string& str, size_t width, char fill) {
+        return str.size() >= width ? str : std::string(width - str.size(), fill) + str;
+    };
+
+    int bad = 0;
+    int checks = 0;
+    auto expect = [&](const std::string& actual, const std::string& expected, const char* what) {
+        ++checks;
+        if (actual != expected) {
+            if (bad < 10) std::cerr << what << ": \"" << actual << "\", expected \"" << expected << "\"\n";
+            ++bad;
+        }
+    };
+    char buf[400];   // Fits 1e300 in fixed notation
+    auto number = [&](int64_t value) {
+        return std::string(buf, Utils::formatNumberTo(buf, Utils::NUMBER_BUFFER_SIZE, value));
+    };
+    auto fixed = [&](double value, int precision) {
+        return std::string(buf, Utils::formatDoubleTo(buf, sizeof(buf), value, precision));
+    };
+
+    // Numbers: zero, every separator boundary on both signs, the int64 limits and random magnitudes
+    std::vector<int64_t> numbers = { 0, 1, -1, INT64_MAX, INT64_MIN + 1 };
+    for (int64_t power = 1; power <= INT64_MAX / 10; power *= 10) {
+        for (int64_t value : { power - 1, power, power + 1 }) {
+            numbers.push_back(value);
+            numbers.push_back(-value);
+        }
+    }
+    Utils::seedRandom(seed);
+    for (int i = 0; i < RANDOM_VALUES; ++i) {
+        auto digits = Utils::randomInt(1, 18);
+        int64_t value = static_cast<int64_t>(Utils::randomDouble(0.0, std::pow(10.0, digits)));
+        numbers.push_back(Utils::randomChance(0.5) ? value : -value);
+    }
+    for (int64_t value : numbers) {
+        expect(number(value), oldFormatNumber(value), "formatNumberTo");
+        expect(Utils::formatNumber(value), oldFormatNumber(value), "formatNumber");
+    }
+    // The old version could not negate INT64_MIN
+    expect(number(INT64_MIN), "-9,223,372,036,854,775,808", "formatNumberTo(INT64_MIN)");
+
+    // Doubles: signed zeros, exact ties and values next to them, large magnitudes, random values
+    std::vector<double> doubles = { 0.0, -0.0, 0.05, -0.05, 0.125, -0.125, 0.25, 2.5, 3.5, -2.5,
+                                    0.45, 0.55, 1.005, 99.95, 999.5, 1e15, -1e15, 123456789.987654321,
+                                    1e300, -1e300, 5e-324, std::nextafter(0.125, 1.0), std::nextafter(0.125, 0.0) };
+    for (int i = 0; i < RANDOM_VALUES; ++i) {
+        double magnitude = std::pow(10.0, Utils::randomInt(-6, 12));
+        doubles.push_back(Utils::randomDouble(-magnitude, magnitude));
+    }
+    for (double value : doubles) {
+        for (int precision : { 0, 1, 2, 3, 6 }) {
+            expect(fixed(value, precision), oldFormatDouble(value, precision), "formatDoubleTo");
+            expect(Utils::formatDouble(value, precision), oldFormatDouble(value, precision), "formatDouble");
+        }
+    }
+    // A result that does not fit writes nothing (formatDouble then falls back to the heap)
+    if (Utils::formatDoubleTo(buf, Utils::DOUBLE_BUFFER_SIZE, 1e300, 2) != 0 ||
+        Utils::formatDoubleTo(buf, 4, 12345.0, 1) != 0) {
+        ++bad;
+    }
+
+    // Bars: empty, full, past both ends, rounding of half cells, a zero or negative maximum
+    for (double value : { -10.0, 0.0, 2.5, 7.5, 12.5, 50.0, 97.5, 100.0, 150.0 }) {
+        for (double maxValue : { 100.0, 0.0, -5.0 }) {
+            for (int width : { 0, 1, 10, 20, 40 }) {
+                std::string bar(static_cast<size_t>(width) + 2, '\0');
+                bar.resize(Utils::progressBarTo(&bar[0], bar.size(), value, maxValue, width));
+                expect(bar, oldProgressBar(value, maxValue, width), "progressBarTo");
+                expect(Utils::progressBar(value, maxValue, width), oldProgressBar(value, maxValue, width), "progressBar");
+            }
+        }
+    }
+
+    // Padding: ASCII matches the byte-counting versions, UTF-8 is padded to its columns
+    char padded[64];
+    for (const std::string& text : { std::string(), std::string("a"), std::string("Money"), std::string(20, 'x') }) {
+        for (size_t width : { size_t(0), size_t(1), size_t(5), size_t(12), size_t(20) }) {
+            expect(std::string(padded, Utils::padRightTo(padded, sizeof(padded), text, width, '.')),
+                   oldPadRight(text, width, '.'), "padRightTo");
+            expect(std::string(padded, Utils::padLeftTo(padded, sizeof(padded), text, width, '.')),
+                   oldPadLeft(text, width, '.'), "padLeftTo");
+            expect(Utils::padRight(text, width, '.'), oldPadRight(text, width, '.'), "padRight");
+            expect(Utils::padLeft(text, width, '.'), oldPadLeft(text, width, '.'), "padLeft");
+        }
+    }
+    const std::string cyrillic = u8"Еда";   // 3 columns, 6 bytes
+    expect(std::string(padded, Utils::padRightTo(padded, sizeof(padded), cyrillic, 8)), cyrillic + "     ", "padRightTo(UTF-8)");
+    expect(std::string(padded, Utils::padLeftTo(padded, sizeof(padded), cyrillic, 8)), "     " + cyrillic, "padLeftTo(UTF-8)");
+    expect(Utils::padRight(cyrillic, 3), cyrillic, "padRight(UTF-8, exact width)");
+    expect(Utils::padLeft(cyrillic, 2), cyrillic, "padLeft(UTF-8, narrower)");
+    if (Utils::padRightTo(padded, 7, cyrillic, 8) != 0) ++bad;   // 11 bytes do not fit in 7
+
+    std::cout << "Utils formatting: " << checks << " results compared with the string versions, " << bad << " differ\n";
+    if (bad > 0) {
+        std::cerr << "The buffer formatters differ from the std::string versions\n";
+        return false;
+    }
+    return true;
+}
+
+// BatchRandom's lanes against a scalar reference xoshiro256** seeded the same way
+// (SplitMix64, then one jump per lane), reseeding against the first run, and
+// CivilizationBatch::generateEvents against EventSystem::generateEvent: over many draws
+// from the same states both must pick every event with the same frequency
+bool testBatchRandom(uint32_t seed) {
+    constexpr int STEPS = 10000;
+    constexpr size_t LANES = BatchRandom::LANES;
+    constexpr size_t ROWS = 1000;
+    constexpr int ROUNDS = 200;   // ROWS * ROUNDS draws per state and path
+
+    struct Reference {
+        uint64_t s[4];
+
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+        uint64_t next() {
+            const uint64_t result = rotl(s[1] * 5, 7) * 9;
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+        void jump() {
+            static constexpr uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+            uint64_t j[4] = {};
+            for (uint64_t word : JUMP) {
+                for (int b = 0; b < 64; ++b) {
+                    if (word & (uint64_t(1) << b)) {
+                        for (int w = 0; w < 4; ++w) j[w] ^= s[w];
+                    }
+                    next();
+                }
+            }
+            for (int w = 0; w < 4; ++w) s[w] = j[w];
+        }
+    };
+
+    int bad = 0;
+
+    // Lane i is the SplitMix64-seeded stream jumped i times
+    const uint64_t seed64 = 0x5EED0000ull + seed;
+    std::array<Reference, LANES> reference{};
+    uint64_t splitMix = seed64;
+    for (uint64_t& word : reference[0].s) {
+        uint64_t z = (splitMix += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        word = z ^ (z >> 31);
+    }
+    for (size_t lane = 1; lane < LANES; ++lane) {
+        reference[lane] = reference[lane - 1];
+        reference[lane].jump();
+    }
+
+    BatchRandom random(seed64);
+    std::vector<uint64_t> seen;
+    seen.reserve(STEPS * LANES);
+    std::array<uint64_t, LANES> values{};
+    for (int step = 0; step < STEPS; ++step) {
+        random.next(values);
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            if (values[lane] != reference[lane].next()) ++bad;
+            seen.push_back(values[lane]);
+        }
+    }
+    // No value shows up twice, in one lane or across lanes
+    std::sort(seen.begin(), seen.end());
+    if (std::adjacent_find(seen.begin(), seen.end()) != seen.end()) ++bad;
+
+    // The same seed gives the same uniforms, a fresh generator or a reseeded one
+    std::vector<double> first(1003), again(1003), reseeded(1003), other(1003);
+    BatchRandom a(seed64), b(seed64), c(seed64 + 1);
+    a.fillUniform(first.data(), first.size());
+    b.fillUniform(again.data(), again.size());
+    c.fillUniform(other.data(), other.size());
+    c.seed(seed64);
+    c.fillUniform(reseeded.data(), reseeded.size());
+    if (first != again || first != reseeded || first == other) ++bad;
+    if (std::any_of(first.begin(), first.end(), [](double u) { return u < 0.0 || u >= 1.0; })) ++bad;
+
+    // Event frequencies from a few states in different eras and condition buckets
+    EventSystem events;
+    events.init(Difficulty::Normal);
+    EventCatalog catalog = events.buildCatalog();
+    std::vector<Civilization> ensemble = makeEnsemble(400, seed);
+    std::vector<const Civilization*> states;
+    std::vector<std::pair<Era, int>> covered;
+    for (const Civilization& civ : ensemble) {
+        std::pair<Era, int> key{ civ.getCurrentEra(),
+                                 EventSystem::conditionBucket(civ.getTech().getBranchLevel(TechBranch::Medicine),
+                                                              civ.getMilitary(), civ.getHappiness()) };
+        if (std::find(covered.begin(), covered.end(), key) == covered.end()) {
+            covered.push_back(key);
+            states.push_back(&civ);
+        }
+        if (states.size() == 6) break;
+    }
+
+    BatchRandom batchRandom(seed64);
+    Utils::seedRandom(seed);
+    std::vector<int> eventIds(ROWS);
+    double worst = 0.0;
+    for (const Civilization* civ : states) {
+        CivilizationBatch batch;
+        for (size_t row = 0; row < ROWS; ++row) batch.add(*civ);
+
+        std::map<std::string, double> batchShare;
+        std::map<std::string, double> scalarShare;
+        const double draws = static_cast<double>(ROWS) * ROUNDS;
+        for (int round = 0; round < ROUNDS; ++round) {
+            batch.generateEvents(catalog, batchRandom, eventIds.data());
+            for (int id : eventIds) batchShare[catalog.getEvent(id).name] += 1.0 / draws;
+        }
+        for (size_t i = 0; i < ROWS * ROUNDS; ++i) {
+            scalarShare[events.generateEvent(*civ).name] += 1.0 / draws;
+        }
+
+        // Five standard deviations of the difference of two independent frequencies
+        std::map<std::string, double> names = batchShare;
+        names.insert(scalarShare.begin(), scalarShare.end());
+        for (const auto& entry : names) {
+            const std::string& name = entry.first;
+            double p = (batchShare[name] + scalarShare[name]) / 2.0;
+            double limit = 5.0 * std::sqrt(2.0 * p * (1.0 - p) / draws) + 1e-4;
+            double difference = std::abs(batchShare[name] - scalarShare[name]);
+            worst = std::max(worst, difference / limit);
+            if (difference > limit) {
+                std::cerr << "event \"" << name << "\": batch " << batchShare[name] << ", scalar " << scalarShare[name] << "\n";
+                ++bad;
+            }
+        }
+    }
+
+    std::cout << "BatchRandom: " << STEPS << " steps of " << LANES << " lanes checked against the reference, "
+              << states.size() << " states x " << ROWS * ROUNDS << " event draws, worst frequency gap "
+              << worst << " of the limit, " << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "BatchRandom or the batched event draw differs from its reference\n";
+        return false;
+    }
+    return true;
+}
+
+// Alias tables built from random weights (with zeros) must give every index its share of
+// the total, by probabilityOf and by sampling; a single entry or all the mass on one entry
+// must always give that index, zero weights never. Every (era, condition bucket) table of
+// the event catalog must weight its era's events by EventSystem::eventWeight for that bucket.
+bool testAliasTable(uint32_t seed) {
+    constexpr int TABLES = 200;
+    constexpr int SAMPLES = 200000;
+
+    Utils::seedRandom(seed);
+    int bad = 0;
+    double worst = 0.0;
+
+    // Evenly spread uniforms, including both ends of [0, 1)
+    auto sweep = [](const AliasTable& table, auto&& onIndex) {
+        constexpr int STEPS = 4096;
+        for (int k = 0; k < STEPS; ++k) onIndex(table.sample(static_cast<double>(k) / STEPS));
+        onIndex(table.sample(std::nextafter(1.0, 0.0)));
+    };
+
+    for (int t = 0; t < TABLES; ++t) {
+        auto n = static_cast<size_t>(Utils::randomInt(1, 60));
+        std::vector<double> weights(n);
+        for (double& weight : weights) {
+            weight = Utils::randomChance(0.2) ? 0.0 : Utils::randomDouble(0.0, 10.0) * std::pow(10.0, Utils::randomInt(-3, 3));
+        }
+        double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+        AliasTable table(weights);
+        if (total <= 0.0) {
+            if (!table.empty()) ++bad;
+            continue;
+        }
+        if (table.size() != n) ++bad;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (std::abs(table.probabilityOf(i) - weights[i] / total) > 1e-12) ++bad;
+        }
+        sweep(table, [&](size_t index) {
+            if (index >= n || weights[index] == 0.0) ++bad;
+        });
+
+        std::vector<int> counts(n);
+        for (int s = 0; s < SAMPLES; ++s) counts[table.sample(Utils::randomDouble(0.0, 1.0))]++;
+        for (size_t i = 0; i < n; ++i) {
+            double p = weights[i] / total;
+            // Five standard deviations, and a few samples more for the rarest indices
+            double limit = 5.0 * std::sqrt(p * (1.0 - p) / SAMPLES) + 5.0 / SAMPLES;
+            double difference = std::abs(counts[i] / static_cast<double>(SAMPLES) - p);
+            worst = std::max(worst, difference / limit);
+            if (difference > limit) ++bad;
+        }
+    }
+
+    // Edge cases: nothing to sample, one entry, all the mass on one entry
+    if (!AliasTable().empty() || !AliasTable(std::vector<double>{}).empty() ||
+        !AliasTable(std::vector<double>{ 0.0, 0.0, 0.0 }).empty()) {
+        ++bad;
+    }
+    AliasTable single(std::vector<double>{ 3.5 });
+    if (single.probabilityOf(0) != 1.0) ++bad;
+    sweep(single, [&](size_t index) { if (index != 0) ++bad; });
+    for (size_t n : { 2, 7, 64 }) {
+        for (size_t heavy : { size_t(0), n / 2, n - 1 }) {
+            std::vector<double> weights(n, 0.0);
+            weights[heavy] = 1.0;
+            AliasTable degenerate(weights);
+            if (std::abs(degenerate.probabilityOf(heavy) - 1.0) > 1e-12) ++bad;
+            sweep(degenerate, [&](size_t index) { if (index != heavy) ++bad; });
+        }
+    }
+
+    // The catalog's tables: each bucket weights its era's events for that bucket
+    EventSystem events;
+    events.init(Difficulty::Normal);
+    EventCatalog catalog = events.buildCatalog();
+    for (size_t e = 0; e < static_cast<size_t>(Era::COUNT); ++e) {
+        auto era = static_cast<Era>(e);
+        const std::vector<int>& pool = catalog.getEraEvents(era);
+        for (int bucket = 0; bucket < EventSystem::CONDITION_BUCKETS; ++bucket) {
+            const AliasTable& table = catalog.getEraTable(era, bucket);
+            if (table.size() != pool.size()) {
+                ++bad;
+                continue;
+            }
+            double total = 0.0;
+            for (int id : pool) total += EventSystem::eventWeight(catalog.getEvent(id), bucket);
+            for (size_t i = 0; i < pool.size(); ++i) {
+                double expected = EventSystem::eventWeight(catalog.getEvent(pool[i]), bucket) / total;
+                if (std::abs(table.probabilityOf(i) - expected) > 1e-12) ++bad;
+            }
+        }
+    }
+    // Band edges land in the bucket whose weights eventWeight reads back
+    GameEvent epidemic;
+    epidemic.type = EventType::Epidemic;
+    if (EventSystem::eventWeight(epidemic, EventSystem::conditionBucket(0, 10.0, 50.0)) <=
+        EventSystem::eventWeight(epidemic, EventSystem::conditionBucket(8, 10.0, 50.0))) {
+        ++bad;   // Weak medicine must make epidemics likelier
+    }
+    GameEvent war;
+    war.type = EventType::War;
+    GameEvent revolution;
+    revolution.type = EventType::Revolution;
+    if (EventSystem::eventWeight(war, EventSystem::conditionBucket(5, 4.9, 50.0)) <=
+            EventSystem::eventWeight(war, EventSystem::conditionBucket(5, 30.0, 50.0)) ||
+        EventSystem::eventWeight(revolution, EventSystem::conditionBucket(5, 10.0, 29.9)) <=
+            EventSystem::eventWeight(revolution, EventSystem::conditionBucket(5, 10.0, 70.0)) ||
+        EventSystem::conditionBucket(5, 10.0, 50.0) != EventSystem::NEUTRAL_BUCKET) {
+        ++bad;
+    }
+
+    std::cout << "AliasTable: " << TABLES << " random tables x " << SAMPLES << " samples, worst frequency gap "
+              << worst << " of the limit, " << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "An alias table does not sample its weights\n";
+        return false;
+    }
+    return true;
+}
+
+// Schedules values with random delays on every level of a TimingWheel, past the top
+// level's range and onto shared expiry ticks from different times, then advances until
+// all have fired. Each value must fire once, exactly on its expiry tick, after every value
+// scheduled earlier for the same tick, and the node pool must never outgrow the peak
+// number of pending entries.
+struct WheelValue {
+    static inline size_t created = 0;   // Default constructions: nodes the pool has grown by
+    uint64_t id = 0;
+
+    WheelValue() { ++created; }
+    explicit WheelValue(uint64_t value) : id(value) {}
+};
+
+bool testTimingWheel(uint32_t seed) {
+    using Wheel = TimingWheel<WheelValue>;
+    constexpr uint64_t TOP_RANGE = uint64_t(1) << (Wheel::SLOT_BITS * Wheel::LEVELS);   // 64^4 ticks
+    constexpr uint64_t SCHEDULE_UNTIL = TOP_RANGE / 4;
+    constexpr int SHARED_EXPIRIES = 16;
+
+    Utils::seedRandom(seed);
+    Wheel wheel;
+    WheelValue::created = 0;
+    std::vector<uint64_t> expiries;   // By id, which is the scheduling order
+    std::vector<uint64_t> shared(SHARED_EXPIRIES);
+    for (uint64_t& expiry : shared) {
+        expiry = static_cast<uint64_t>(Utils::randomDouble(1.0, static_cast<double>(TOP_RANGE + TOP_RANGE / 8)));
+    }
+    size_t peak = 0;
+    int bad = 0;
+
+    auto schedule = [&](uint64_t delay) {
+        wheel.schedule(WheelValue(expiries.size()), delay);
+        expiries.push_back(wheel.now() + std::max<uint64_t>(delay, 1));
+        peak = std::max(peak, wheel.size());
+    };
+    auto randomDelay = [] {
+        // Every level, a few past the top level's range, and the zero delay
+        switch (Utils::randomInt(0, 5)) {
+            case 0: return static_cast<uint64_t>(Utils::randomInt(0, 64));
+            case 1: return static_cast<uint64_t>(Utils::randomInt(1, 64 * 64));
+            case 2: return static_cast<uint64_t>(Utils::randomInt(1, 64 * 64 * 64));
+            case 3:
+            case 4: return static_cast<uint64_t>(Utils::randomDouble(1.0, static_cast<double>(TOP_RANGE)));
+            default: return TOP_RANGE + static_cast<uint64_t>(Utils::randomInt(0, 64 * 64 * 64));
+        }
+    };
+
+    size_t fired = 0;
+    uint64_t lastTick = 0;
+    uint64_t lastId = 0;
+    auto onFire = [&](const WheelValue& value) {
+        if (value.id >= expiries.size() || expiries[value.id] != wheel.now() ||
+            (lastTick == wheel.now() && value.id <= lastId)) {
+            ++bad;
+        }
+        expiries[value.id] = 0;   // A second firing is caught by the expiry check
+        lastTick = wheel.now();
+        lastId = value.id;
+        ++fired;
+    };
+
+    while (wheel.now() < SCHEDULE_UNTIL) {
+        if (Utils::randomChance(0.001)) {
+            for (int i = Utils::randomInt(1, 20); i > 0; --i) schedule(randomDelay());
+            // The same expiry tick from different distances, so entries meet after cascades
+            uint64_t expiry = shared[static_cast<size_t>(Utils::randomInt(0, SHARED_EXPIRIES - 1))];
+            if (expiry > wheel.now()) schedule(expiry - wheel.now());
+        }
+        wheel.advance(onFire);
+    }
+    while (!wheel.empty()) wheel.advance(onFire);
+
+    // Reuse: refilling to the peak takes nodes from the free list only
+    size_t pool = WheelValue::created;
+    for (size_t i = 0; i < peak; ++i) schedule(static_cast<uint64_t>(Utils::randomInt(1, 5000)));
+    while (!wheel.empty()) wheel.advance(onFire);
+
+    if (fired != expiries.size() || pool > peak || WheelValue::created != pool) ++bad;
+
+    std::cout << "TimingWheel: " << expiries.size() << " values over " << wheel.now() << " ticks, peak "
+              << peak << " pending, pool of " << pool << " nodes, " << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "A TimingWheel value fired late, early, twice or out of order\n";
+        return false;
+    }
+    return true;
+}
+
+// Plays seeded games turn by turn with standing orders after every turn and checks each
+// turn against the rules on a copy: the investment takes its share of the money there is,
+// auto-research buys the cheapest available technology (the first of equal cost) once the
+// money left covers it, and the report adds up what every turn spent
+bool testStandingOrders(uint32_t seed) {
+    constexpr uint32_t GAMES = 20;
+    constexpr int MAX_TURNS = 400;
+
+    int bad = 0;
+    long long turns = 0;
+    size_t researched = 0;
+    auto near = [](double a, double b) { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Civilization civ;
+        EventSystem events;
+        newHeadlessGame(civ, events);
+        const auto branch = static_cast<TechBranch>(g % static_cast<uint32_t>(TechBranch::COUNT));
+        const double share = (g % 4 == 2) ? 0.0 : 0.05 + 0.05 * (g % 8);
+        StandingOrders orders;
+        orders.setInvestment(branch, share);   // Every fourth game only researches,
+        orders.setAutoResearch(g % 4 != 3);    // and every fourth only invests
+        Utils::seedRandom(seed + g);
+
+        OrdersReport report;
+        for (int turn = 0; turn < MAX_TURNS && civ.checkGameResult() == GameResult::InProgress; ++turn) {
+            GameEvent event = events.generateEvent(civ);
+            events.recordEvent(event);
+            civ.applyEvent(event);
+            civ.processTurn();
+
+            // The same turn's orders by hand
+            Civilization expected = civ;
+            double money = expected.getResources().getResource(ResourceType::Money);
+            double investment = 0.0;
+            if (orders.hasInvestment() && money > 0) {
+                investment = money * share;
+                expected.getResources().removeResource(ResourceType::Money, investment);
+                expected.getTech().investInBranch(branch, investment);
+            }
+            const Technology* cheapest = nullptr;
+            for (const Technology* tech : expected.getTech().getAvailableTechs()) {
+                if (!cheapest || tech->cost < cheapest->cost) cheapest = tech;
+            }
+            std::string bought;
+            double cost = 0.0;
+            if (orders.isAutoResearch() && cheapest &&
+                expected.getResources().getResource(ResourceType::Money) >= cheapest->cost) {
+                bought = cheapest->name;
+                cost = cheapest->cost;
+                expected.getResources().removeResource(ResourceType::Money, cost);
+                if (!expected.getTech().researchTech(bought)) ++bad;
+            }
+
+            const OrdersReport before = report;
+            orders.execute(civ, report);
+            const size_t added = report.researched.size() - before.researched.size();
+            if (!near(report.invested - before.invested, investment) ||
+                !near(report.researchSpent - before.researchSpent, cost) ||
+                added != (bought.empty() ? 0u : 1u) || (added == 1 && report.researched.back() != bought) ||
+                civ.serialize() != expected.serialize()) {
+                ++bad;
+            }
+            ++turns;
+        }
+
+        // The report's research total is the price of what it lists
+        double listed = 0.0;
+        for (const std::string& name : report.researched) {
+            for (size_t id = 0; id < civ.getTech().getTechnologyCount(); ++id) {
+                const Technology& tech = civ.getTech().getTechnology(static_cast<TechId>(id));
+                if (tech.name == name) {
+                    listed += tech.cost;
+                    if (!tech.researched) ++bad;
+                }
+            }
+        }
+        if (std::abs(listed - report.researchSpent) > 1e-9 * std::max(1.0, listed)) ++bad;
+        if (!orders.isAutoResearch() && !report.researched.empty()) ++bad;
+        researched += report.researched.size();
+    }
+
+    std::cout << "StandingOrders: " << turns << " turns of " << GAMES << " games, " << researched
+              << " technologies bought, " << bad << " wrong\n";
+    if (bad > 0 || researched == 0) {
+        std::cerr << "Standing orders differ from the investment and research rules\n";
+        return false;
+    }
+    return true;
+}
+
+// TurnAdvance against the same turns played one at a time with the orders carried out
+// after each: the same civilization, history, random stream and orders report, exactly
+// the turns asked for unless the game ends, and a summary whose events and quiet years
+// account for every turn. With no events in any era every turn is a quiet year. Then
+// GameEngine::advanceTurns on a new game plays exactly N turns until one ends the game.
+bool testTurnAdvance(uint32_t seed) {
+    constexpr uint32_t GAMES = 30;
+
+    int bad = 0;
+    long long turns = 0;
+    int endedGames = 0;
+    auto sameReport = [](const OrdersReport& a, const OrdersReport& b) {
+        return a.invested == b.invested && a.researchSpent == b.researchSpent && a.researched == b.researched;
+    };
+
+    for (uint32_t g = 0; g < GAMES + 2; ++g) {
+        const bool noEvents = g >= GAMES;   // The last two games have no events in any era
+        const int wanted = noEvents ? 60 : 20 + static_cast<int>(g) * 20;
+        StandingOrders orders;
+        if (g % 3 != 0) orders.setInvestment(static_cast<TechBranch>(g % 5), 0.1 * (g % 5 + 1));
+        orders.setAutoResearch(g % 2 == 0);
+
+        Civilization stepped;
+        EventSystem steppedEvents;
+        newHeadlessGame(stepped, steppedEvents);
+        if (noEvents) {
+            for (size_t e = 0; e < static_cast<size_t>(Era::COUNT); ++e) {
+                steppedEvents.setEraEvents(static_cast<Era>(e), {});
+            }
+        }
+        Civilization advanced = stepped;
+        EventSystem advancedEvents = steppedEvents;
+
+        Utils::seedRandom(seed + g);
+        OrdersReport steppedReport;
+        std::vector<std::string> steppedNames;
+        int steppedQuiet = 0;
+        int played = 0;
+        while (played < wanted && stepped.checkGameResult() == GameResult::InProgress) {
+            GameEvent event = steppedEvents.generateEvent(stepped);
+            steppedEvents.recordEvent(event);
+            stepped.applyEvent(event);
+            stepped.processTurn();
+            orders.execute(stepped, steppedReport);
+            ++played;
+            if (noEvents || event.name == steppedEvents.getQuietYear().name) {
+                ++steppedQuiet;
+            } else {
+                steppedNames.push_back(event.name);
+            }
+        }
+        const int steppedNext = Utils::randomInt(0, 1 << 30);
+
+        Utils::seedRandom(seed + g);
+        TurnSummary summary = TurnAdvance::run(advanced, advancedEvents, orders, wanted);
+        const int advancedNext = Utils::randomInt(0, 1 << 30);
+
+        std::vector<std::string> names;
+        for (const GameEvent& event : summary.events) names.push_back(event.name);
+        const bool ended = summary.result != GameResult::InProgress;
+        if (summary.turnsPlayed != played || (summary.turnsPlayed != wanted && !ended) ||
+            summary.result != advanced.checkGameResult() ||
+            summary.after.turn != summary.before.turn + summary.turnsPlayed ||
+            static_cast<int>(summary.events.size()) + summary.quietYears != summary.turnsPlayed ||
+            summary.quietYears != steppedQuiet || names != steppedNames ||
+            (noEvents && summary.quietYears != summary.turnsPlayed) ||
+            !sameReport(summary.orders, steppedReport) || steppedNext != advancedNext ||
+            stepped.serialize() != advanced.serialize() ||
+            steppedEvents.serialize() != advancedEvents.serialize()) {
+            ++bad;
+        }
+        turns += summary.turnsPlayed;
+        endedGames += ended ? 1 : 0;
+    }
+
+    // Through the engine: a new game from a script, then advances of a few sizes
+    GameEngine engine;
+    std::istringstream script("new normal\n");
+    std::ostringstream report;
+    if (engine.runScript(script, report) != 0) ++bad;
+    Utils::seedRandom(seed);
+    int advances = 0;
+    for (int n : { 1, 7, 25, 1000, 1000, 1000, 1000, 1000 }) {
+        if (engine.getResult() != GameResult::InProgress) break;
+        const int before = engine.getCivilization().getTurn();
+        TurnSummary summary = engine.advanceTurns(n);
+        const bool ended = summary.result != GameResult::InProgress;
+        if (engine.getCivilization().getTurn() != before + summary.turnsPlayed ||
+            (summary.turnsPlayed != n && !ended) || summary.turnsPlayed > n ||
+            engine.getResult() != summary.result) {
+            ++bad;
+        }
+        ++advances;
+    }
+    if (engine.getResult() == GameResult::InProgress) ++bad;   // Some advance must have ended it
+
+    std::cout << "TurnAdvance vs turn-by-turn: " << turns << " turns of " << GAMES + 2 << " games (" << endedGames
+              << " ended early), GameEngine::advanceTurns over " << advances << " advances to "
+              << gameResultToString(engine.getResult()) << ", " << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "TurnAdvance or GameEngine::advanceTurns diverges from turn-by-turn play\n";
+        return false;
+    }
+    return true;
+}
+
+// Plays seeded games both ways: every turn on the game thread, and every turn adopted from
+// a SimulationThread prediction the way GameEngine::playTurn adopts one (record the event,
+// take the civilization and the generator state). Both must end with the same civilization,
+// history and random stream, and the worker must never draw from the game thread's
+// generator. On some turns the player invests after the turn was queued: that prediction
+// is stale by version and the turn is played on the game thread, as in the reference.
+bool testSimulationThread(uint32_t seed) {
+    constexpr uint32_t GAMES = 10;
+    constexpr int TURNS = 80;
+
+    auto invest = [](Civilization& civ) {
+        double amount = civ.getResources().getResource(ResourceType::Money) * 0.1;
+        if (amount > 0) {
+            civ.getResources().removeResource(ResourceType::Money, amount);
+            civ.getTech().investInBranch(TechBranch::Science, amount);
+        }
+    };
+    auto playOnGameThread = [](Civilization& civ, EventSystem& events) {
+        GameEvent event = events.generateEvent(civ);
+        events.recordEvent(event);
+        civ.applyEvent(event);
+        civ.processTurn();
+    };
+    auto actsFirst = [](int turn) { return turn % 4 == 3; };
+
+    SimulationThread simulation;
+    int bad = 0;
+    int adopted = 0;
+    int stale = 0;
+    long long turns = 0;
+    for (uint32_t g = 0; g < GAMES; ++g) {
+        Civilization reference;
+        EventSystem referenceEvents;
+        newHeadlessGame(reference, referenceEvents);
+        Civilization civ = reference;
+        EventSystem events = referenceEvents;
+
+        Utils::seedRandom(seed + g);
+        int referenceTurns = 0;
+        while (referenceTurns < TURNS && reference.checkGameResult() == GameResult::InProgress) {
+            if (actsFirst(referenceTurns)) invest(reference);
+            playOnGameThread(reference, referenceEvents);
+            ++referenceTurns;
+        }
+        const int referenceNext = Utils::randomInt(0, 1 << 30);
+
+        Utils::seedRandom(seed + g);
+        uint64_t version = 0;
+        int played = 0;
+        while (played < TURNS && civ.checkGameResult() == GameResult::InProgress) {
+            simulation.speculate(version, civ, events);
+            const std::mt19937 queuedFrom = Utils::getRandomState();
+            const int queuedTurn = civ.getTurn();
+            if (actsFirst(played)) {
+                invest(civ);   // The player acts while the turn is played ahead
+                ++version;
+            }
+
+            TurnPrediction prediction;
+            while (!simulation.poll(prediction)) std::this_thread::yield();
+            if (Utils::getRandomState() != queuedFrom || prediction.forecast.turn != queuedTurn + 1) ++bad;
+            if (prediction.version == version) {
+                events.recordEvent(prediction.event);
+                civ = std::move(prediction.civ);
+                Utils::setRandomState(prediction.random);
+                ++adopted;
+            } else {
+                playOnGameThread(civ, events);
+                ++stale;
+            }
+            ++version;
+            ++played;
+        }
+        const int next = Utils::randomInt(0, 1 << 30);
+
+        if (played != referenceTurns || next != referenceNext || civ.serialize() != reference.serialize() ||
+            events.serialize() != referenceEvents.serialize()) {
+            ++bad;
+        }
+        turns += played;
+    }
+
+    std::cout << "SimulationThread: " << turns << " turns of " << GAMES << " games, " << adopted
+              << " adopted from the worker, " << stale << " stale after a player action, " << bad << " wrong\n";
+    if (bad > 0 || adopted == 0 || stale == 0) {
+        std::cerr << "Turns adopted from the simulation thread differ from turns played on the game thread\n";
+        return false;
+    }
+    return true;
+}
+
+// ScriptRunner::tokenize on quoting, comments and CR line endings; run stopping at the
+// first failing line with exit code 1; and a seeded script (with CRLF endings) against the
+// same actions through the GameEngine API, which must end in the same game
+bool testScriptRunner(uint32_t seed) {
+    using Words = std::vector<std::string>;
+    int bad = 0;
+    int checks = 0;
+    auto expect = [&](const std::string& line, const Words& words) {
+        ++checks;
+        if (ScriptRunner::tokenize(line) != words) {
+            std::cerr << "tokenize(\"" << line << "\") gave " << ScriptRunner::tokenize(line).size() << " words\n";
+            ++bad;
+        }
+    };
+    expect("invest science 100", { "invest", "science", "100" });
+    expect("  turn\t 3  ", { "turn", "3" });
+    expect("new normal \"Old Rome\"", { "new", "normal", "Old Rome" });
+    expect("research \"A # B\" # a comment", { "research", "A # B" });
+    expect("status# no space before the comment", { "status" });
+    expect("# the whole line", {});
+    expect("", {});
+    expect("save \"\"", { "save", "" });
+    expect("say a\"b c\"d", { "say", "ab cd" });
+    expect("load \"unterminated name", { "load", "unterminated name" });
+    expect("turn 2\r", { "turn", "2" });
+    expect("new \"Рим\"\r", { "new", "Рим" });
+
+    // Runs the script on a new engine from seed; returns the exit code
+    auto runScript = [seed](GameEngine& engine, const std::string& text, std::string& report) {
+        Utils::seedRandom(seed);
+        std::istringstream script(text);
+        std::ostringstream out;
+        int code = engine.runScript(script, out);
+        report = out.str();
+        return code;
+    };
+
+    // The first failing command stops the script: line 4 never runs
+    {
+        GameEngine engine;
+        std::string report;
+        int code = runScript(engine, "new normal\n\n# skipped\nbogus\nturn 5\n", report);
+        ++checks;
+        if (code != 1 || report.find("ERROR: unknown command 'bogus'") == std::string::npos ||
+            report.find("2 commands") == std::string::npos ||
+            report.find("stopped at line 4") == std::string::npos || engine.getCivilization().getTurn() != 0) {
+            std::cerr << report;
+            ++bad;
+        }
+    }
+
+    // A seeded script against the same actions through the API
+    const std::string script =
+        "new hard \"Old Rome\"\r\n"
+        "turn 3\r\n"
+        "invest science 20\r\n"
+        "orders invest industry 15   # every turn\r\n"
+        "orders research on\r\n"
+        "advance 12\r\n"
+        "status\r\n";
+    GameEngine scripted;
+    std::string report;
+    int code = runScript(scripted, script, report);
+
+    GameEngine direct;
+    std::string setup;
+    runScript(direct, "new hard \"Old Rome\"\n", setup);
+    for (int t = 0; t < 3; ++t) direct.playTurn();
+    bool invested = direct.invest(TechBranch::Science, 20);
+    direct.getOrders().setInvestment(TechBranch::Industry, 0.15);
+    direct.getOrders().setAutoResearch(true);
+    TurnSummary summary = direct.advanceTurns(12);
+
+    ++checks;
+    if (code != 0 || !invested || scripted.getCivilization().getName() != "Old Rome" ||
+        scripted.getCivilization().serialize() != direct.getCivilization().serialize() ||
+        report.find("7 commands") == std::string::npos ||
+        report.find(std::to_string(summary.turnsPlayed) + " turns (") == std::string::npos) {
+        std::cerr << report;
+        ++bad;
+    }
+
+    std::cout << "ScriptRunner: " << checks << " checks, the seeded script reached turn "
+              << scripted.getCivilization().getTurn() << ", " << bad << " wrong\n";
+    if (bad > 0) {
+        std::cerr << "ScriptRunner tokenizes or runs scripts differently from the commands it stands for\n";
+        return false;
+    }
+    return true;
+}
+
+struct Test {
+    const char* name;
+    bool (*run)(uint32_t seed);
+};
+
+const Test TESTS[] = {
+    { "batch", testBatch },
+    { "batch-random", testBatchRandom },
+    { "alias-table", testAliasTable },
+    { "lingering-effects", testLingeringEffects },
+    { "timing-wheel", testTimingWheel },
+    { "settlers", testSettlers },
+    { "fast-forward", testFastForward },
+    { "standing-orders", testStandingOrders },
+    { "turn-advance", testTurnAdvance },
+    { "tech-lists", testTechListCache },
+    { "city-totals", testCityTotals },
+    { "modifiers", testModifiers },
+    { "spatial-grid", testSpatialGrid },
+    { "flow-fields", testFlowFields },
+    { "city-map-render", testCityMapRender },
+    { "triple-buffer", testTripleBuffer },
+    { "snapshots", testSnapshotPublishing },
+    { "simulation-thread", testSimulationThread },
+    { "view-model", testViewModelDiffs },
+    { "formatting", testFormatting },
+    { "script-runner", testScriptRunner },
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t seed = 12345;
+    std::vector<std::string> selected;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            selected.push_back(arg);
+        }
+    }
+
+    for (const std::string& name : selected) {
+        if (std::none_of(std::begin(TESTS), std::end(TESTS), [&name](const Test& t) { return name == t.name; })) {
+            std::cerr << "Unknown test: " << name << "\nTests:";
+            for (const Test& test : TESTS) std::cerr << " " << test.name;
+            std::cerr << "\n";
+            return 2;
+        }
+    }
+
+    int failed = 0;
+    for (const Test& test : TESTS) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), test.name) == selected.end()) continue;
+        if (!test.run(seed)) {
+            std::cerr << "FAILED: " << test.name << "\n";
+            ++failed;
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}